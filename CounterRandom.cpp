@@ -0,0 +1,70 @@
+// ===========================================================
+// Name         : CounterRandom.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `CounterRandom` class, a counter-based random number generator
+//                (Philox4x32-10) that maps a seed and a counter to a random number without any state
+// ===========================================================
+
+#include "CounterRandom.h"
+#include "DesignByContract.h"
+
+namespace {
+    const uint32_t gPhiloxM0 = 0xD2511F53u;
+    const uint32_t gPhiloxM1 = 0xCD9E8D57u;
+    const uint32_t gPhiloxW0 = 0x9E3779B9u;
+    const uint32_t gPhiloxW1 = 0xBB67AE85u;
+    const unsigned int gPhiloxRounds = 10;
+
+    void mulhilo(uint32_t a, uint32_t b, uint32_t &hi, uint32_t &lo) {
+        uint64_t product = (uint64_t) a * b;
+        hi = (uint32_t) (product >> 32);
+        lo = (uint32_t) product;
+    }
+}
+
+CounterRandom::CounterRandom(unsigned int seed) : fSeed(seed) {
+    CounterRandom::_initCheck = this;
+
+    ENSURE(getSeed() == seed, "CounterRandom constructor did not keep the seed");
+    ENSURE(properlyInitialized(), "CounterRandom constructor did not end in an initialized state");
+}
+
+CounterRandom::~CounterRandom() {}
+
+bool CounterRandom::properlyInitialized() const {
+    return CounterRandom::_initCheck == this;
+}
+
+void CounterRandom::setSeed(unsigned int seed) {
+    REQUIRE(properlyInitialized(), "CounterRandom wasn't initialized when calling setSeed()");
+
+    fSeed = seed;
+
+    ENSURE(getSeed() == seed, "setSeed() postcondition");
+}
+
+unsigned int CounterRandom::getSeed() const {
+    REQUIRE(properlyInitialized(), "CounterRandom wasn't initialized when calling getSeed()");
+
+    return fSeed;
+}
+
+uint32_t CounterRandom::draw(uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3) const {
+    REQUIRE(properlyInitialized(), "CounterRandom wasn't initialized when calling draw()");
+
+    uint32_t key0 = fSeed;
+    uint32_t key1 = 0;
+    for (unsigned int round = 0; round < gPhiloxRounds; round++) {
+        uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(gPhiloxM0, c0, hi0, lo0);
+        mulhilo(gPhiloxM1, c2, hi1, lo1);
+        c0 = hi1 ^ c1 ^ key0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ key1;
+        c3 = lo0;
+        key0 += gPhiloxW0;
+        key1 += gPhiloxW1;
+    }
+    return c0;
+}
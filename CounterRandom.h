@@ -0,0 +1,52 @@
+// ===========================================================
+// Name         : CounterRandom.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `CounterRandom` class, a counter-based random number generator
+//                (Philox4x32-10) that maps a seed and a counter to a random number without any state
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_COUNTERRANDOM_H
+#define TRAFFICSIMULATION_COUNTERRANDOM_H
+
+#include <stdint.h>
+
+class CounterRandom {
+    CounterRandom* _initCheck;
+
+    unsigned int fSeed;
+
+public:
+    /*
+     * ENSURE(getSeed() == seed, "CounterRandom constructor did not keep the seed")
+     * ENSURE(properlyInitialized(), "CounterRandom constructor did not end in an initialized state")
+     */
+    explicit CounterRandom(unsigned int seed);
+
+    virtual ~CounterRandom();
+
+    bool properlyInitialized() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "CounterRandom wasn't initialized when calling setSeed()")
+     *
+     * ENSURE(getSeed() == seed, "setSeed() postcondition")
+     */
+    void setSeed(unsigned int seed);
+
+    /*
+     * REQUIRE(properlyInitialized(), "CounterRandom wasn't initialized when calling getSeed()")
+     */
+    unsigned int getSeed() const;
+
+    /*
+     * Returns the random number that belongs to the counter (c0, c1, c2, c3). The same seed and counter always give
+     * the same number, no matter in which order or on which thread they are drawn.
+     *
+     * REQUIRE(properlyInitialized(), "CounterRandom wasn't initialized when calling draw()")
+     */
+    uint32_t draw(uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3) const;
+};
+
+
+#endif
@@ -0,0 +1,75 @@
+// ===========================================================
+// Name         : SpawnScheduler.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `SpawnScheduler` class, a priority queue of the next arrival times of the
+//                sources of vehicles
+// ===========================================================
+
+#include "SpawnScheduler.h"
+#include "DesignByContract.h"
+
+SpawnScheduler::SpawnScheduler() {
+    SpawnScheduler::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "SpawnScheduler constructor did not end in an initialized state");
+}
+
+SpawnScheduler::~SpawnScheduler() {}
+
+bool SpawnScheduler::properlyInitialized() const {
+    return SpawnScheduler::_initCheck == this;
+}
+
+void SpawnScheduler::clear() {
+    REQUIRE(properlyInitialized(), "SpawnScheduler wasn't initialized when calling clear()");
+
+    while (!fQueue.empty()) {
+        fQueue.pop();
+    }
+
+    ENSURE(size() == 0, "clear() postcondition");
+}
+
+void SpawnScheduler::schedule(double time, unsigned int source) {
+    REQUIRE(properlyInitialized(), "SpawnScheduler wasn't initialized when calling schedule()");
+
+    unsigned int startSize = size();
+
+    fQueue.push(std::make_pair(time, source));
+
+    ENSURE(size() == startSize + 1, "schedule() postcondition");
+}
+
+bool SpawnScheduler::isDue(double time) const {
+    REQUIRE(properlyInitialized(), "SpawnScheduler wasn't initialized when calling isDue()");
+
+    return !fQueue.empty() && fQueue.top().first < time;
+}
+
+unsigned int SpawnScheduler::pop() {
+    REQUIRE(properlyInitialized(), "SpawnScheduler wasn't initialized when calling pop()");
+    REQUIRE(size() > 0, "There is no source to pop");
+
+    unsigned int startSize = size();
+
+    unsigned int source = fQueue.top().second;
+    fQueue.pop();
+
+    ENSURE(size() == startSize - 1, "pop() postcondition");
+
+    return source;
+}
+
+double SpawnScheduler::getNextTime() const {
+    REQUIRE(properlyInitialized(), "SpawnScheduler wasn't initialized when calling getNextTime()");
+    REQUIRE(size() > 0, "There is no source scheduled");
+
+    return fQueue.top().first;
+}
+
+unsigned int SpawnScheduler::size() const {
+    REQUIRE(properlyInitialized(), "SpawnScheduler wasn't initialized when calling size()");
+
+    return fQueue.size();
+}
@@ -0,0 +1,81 @@
+// ===========================================================
+// Name         : SpawnScheduler.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `SpawnScheduler` class, a priority queue of the next arrival times of the
+//                sources of vehicles
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_SPAWNSCHEDULER_H
+#define TRAFFICSIMULATION_SPAWNSCHEDULER_H
+
+#include <vector>
+#include <queue>
+#include <functional>
+
+/*
+ * A source is only a number, its meaning is up to the caller. Only the sources that are due are looked at, so a tick
+ * costs nothing for sources that don't spawn a vehicle. Sources that are due at the same time are returned in the order
+ * of their numbers.
+ */
+class SpawnScheduler {
+    SpawnScheduler* _initCheck;
+
+    std::priority_queue<std::pair<double, unsigned int>, std::vector<std::pair<double, unsigned int> >,
+            std::greater<std::pair<double, unsigned int> > > fQueue;
+
+public:
+    /*
+     * ENSURE(properlyInitialized(), "SpawnScheduler constructor did not end in an initialized state")
+     */
+    SpawnScheduler();
+
+    virtual ~SpawnScheduler();
+
+    bool properlyInitialized() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "SpawnScheduler wasn't initialized when calling clear()")
+     *
+     * ENSURE(size() == 0, "clear() postcondition")
+     */
+    void clear();
+
+    /*
+     * REQUIRE(properlyInitialized(), "SpawnScheduler wasn't initialized when calling schedule()")
+     *
+     * ENSURE(size() == startSize + 1, "schedule() postcondition")
+     */
+    void schedule(double time, unsigned int source);
+
+    /*
+     * Returns whether a source is due before `time`.
+     *
+     * REQUIRE(properlyInitialized(), "SpawnScheduler wasn't initialized when calling isDue()")
+     */
+    bool isDue(double time) const;
+
+    /*
+     * Removes the source that is due first and returns it.
+     *
+     * REQUIRE(properlyInitialized(), "SpawnScheduler wasn't initialized when calling pop()")
+     * REQUIRE(size() > 0, "There is no source to pop")
+     *
+     * ENSURE(size() == startSize - 1, "pop() postcondition")
+     */
+    unsigned int pop();
+
+    /*
+     * REQUIRE(properlyInitialized(), "SpawnScheduler wasn't initialized when calling getNextTime()")
+     * REQUIRE(size() > 0, "There is no source scheduled")
+     */
+    double getNextTime() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "SpawnScheduler wasn't initialized when calling size()")
+     */
+    unsigned int size() const;
+};
+
+
+#endif
@@ -0,0 +1,177 @@
+// ===========================================================
+// Name         : StreetPool.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `StreetPool` class, a pool of threads that steal the streets of a tick from
+//                each other
+// ===========================================================
+
+#include <algorithm>
+#include "StreetPool.h"
+#include "DesignByContract.h"
+#include "objects/Street.h"
+
+namespace {
+    // Most expensive street first, in the order of the streets if they cost the same
+    bool moreExpensive(const std::pair<unsigned int, unsigned int> &street1, const std::pair<unsigned int, unsigned int> &street2) {
+        if (street1.first != street2.first) {
+            return street1.first > street2.first;
+        }
+        return street1.second < street2.second;
+    }
+}
+
+StreetPool::StreetPool(unsigned int threads) : fGeneration(0), fBusy(0), fStop(false), fTime(0) {
+    REQUIRE(threads > 0, "A StreetPool needs at least one thread");
+
+    pthread_mutex_init(&fMutex, NULL);
+    pthread_cond_init(&fStart, NULL);
+    pthread_cond_init(&fDone, NULL);
+    for (unsigned int i = 0; i < threads; i++) {
+        Worker* worker = new Worker();
+        worker->pool = this;
+        worker->index = i;
+        worker->head = 0;
+        worker->tail = 0;
+        pthread_mutex_init(&worker->mutex, NULL);
+        // Worker 0 is the thread that calls run()
+        if (i > 0 && pthread_create(&worker->thread, NULL, &StreetPool::workerLoop, worker) != 0) {
+            pthread_mutex_destroy(&worker->mutex);
+            delete worker;
+            break;
+        }
+        fWorkers.push_back(worker);
+    }
+
+    StreetPool::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "StreetPool constructor did not end in an initialized state");
+    ENSURE(getThreads() <= threads, "StreetPool constructor postcondition");
+}
+
+StreetPool::~StreetPool() {
+    pthread_mutex_lock(&fMutex);
+    fStop = true;
+    pthread_cond_broadcast(&fStart);
+    pthread_mutex_unlock(&fMutex);
+    for (unsigned int i = 0; i < fWorkers.size(); i++) {
+        if (i > 0) {
+            pthread_join(fWorkers[i]->thread, NULL);
+        }
+        pthread_mutex_destroy(&fWorkers[i]->mutex);
+        delete fWorkers[i];
+    }
+    pthread_cond_destroy(&fDone);
+    pthread_cond_destroy(&fStart);
+    pthread_mutex_destroy(&fMutex);
+}
+
+bool StreetPool::properlyInitialized() const {
+    return StreetPool::_initCheck == this;
+}
+
+void *StreetPool::workerLoop(void *worker) {
+    Worker* self = static_cast<Worker*>(worker);
+    StreetPool* pool = self->pool;
+    unsigned long seen = 0;
+    pthread_mutex_lock(&pool->fMutex);
+    while (true) {
+        while (pool->fGeneration == seen && !pool->fStop) {
+            pthread_cond_wait(&pool->fStart, &pool->fMutex);
+        }
+        if (pool->fStop) {
+            break;
+        }
+        seen = pool->fGeneration;
+        pthread_mutex_unlock(&pool->fMutex);
+
+        pool->work(self->index);
+
+        pthread_mutex_lock(&pool->fMutex);
+        pool->fBusy--;
+        if (pool->fBusy == 0) {
+            pthread_cond_signal(&pool->fDone);
+        }
+    }
+    pthread_mutex_unlock(&pool->fMutex);
+    return NULL;
+}
+
+bool StreetPool::take(unsigned int worker, Street *&street) {
+    Worker* own = fWorkers[worker];
+    pthread_mutex_lock(&own->mutex);
+    if (own->head < own->tail) {
+        street = own->tasks[own->head++];
+        pthread_mutex_unlock(&own->mutex);
+        return true;
+    }
+    pthread_mutex_unlock(&own->mutex);
+
+    // No streets are added during a run, so a worker is done once all others are out of streets as well
+    for (unsigned int i = 1; i < fWorkers.size(); i++) {
+        Worker* victim = fWorkers[(worker + i) % fWorkers.size()];
+        pthread_mutex_lock(&victim->mutex);
+        if (victim->head < victim->tail) {
+            street = victim->tasks[--victim->tail];
+            pthread_mutex_unlock(&victim->mutex);
+            return true;
+        }
+        pthread_mutex_unlock(&victim->mutex);
+    }
+    return false;
+}
+
+void StreetPool::work(unsigned int worker) {
+    Street* street = NULL;
+    while (take(worker, street)) {
+        street->driveVehicles();
+        street->simTrafficLights(fTime);
+        street->simBusStops(fTime);
+    }
+}
+
+unsigned int StreetPool::getThreads() const {
+    REQUIRE(properlyInitialized(), "StreetPool wasn't initialized when calling getThreads()");
+
+    return fWorkers.size();
+}
+
+void StreetPool::run(const std::vector<Street*> &streets, double time) {
+    REQUIRE(properlyInitialized(), "StreetPool wasn't initialized when calling run()");
+
+    fTime = time;
+    fCosts.clear();
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        unsigned int cost = 1 + streets[i]->getVehicles().size() + streets[i]->getEntryQueue().size();
+        fCosts.push_back(std::make_pair(cost, i));
+    }
+    std::sort(fCosts.begin(), fCosts.end(), moreExpensive);
+    fLoads.assign(fWorkers.size(), 0);
+    for (unsigned int i = 0; i < fWorkers.size(); i++) {
+        fWorkers[i]->tasks.clear();
+    }
+    for (unsigned int i = 0; i < fCosts.size(); i++) {
+        unsigned int worker = std::min_element(fLoads.begin(), fLoads.end()) - fLoads.begin();
+        fWorkers[worker]->tasks.push_back(streets[fCosts[i].second]);
+        fLoads[worker] += fCosts[i].first;
+    }
+    for (unsigned int i = 0; i < fWorkers.size(); i++) {
+        fWorkers[i]->head = 0;
+        fWorkers[i]->tail = fWorkers[i]->tasks.size();
+    }
+
+    // A single street isn't worth waking the threads for
+    if (streets.size() > 1 && fWorkers.size() > 1) {
+        pthread_mutex_lock(&fMutex);
+        fBusy = fWorkers.size() - 1;
+        fGeneration++;
+        pthread_cond_broadcast(&fStart);
+        pthread_mutex_unlock(&fMutex);
+    }
+    work(0);
+    pthread_mutex_lock(&fMutex);
+    while (fBusy > 0) {
+        pthread_cond_wait(&fDone, &fMutex);
+    }
+    pthread_mutex_unlock(&fMutex);
+}
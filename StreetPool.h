@@ -0,0 +1,94 @@
+// ===========================================================
+// Name         : StreetPool.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `StreetPool` class, a pool of threads that steal the streets of a tick from
+//                each other
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_STREETPOOL_H
+#define TRAFFICSIMULATION_STREETPOOL_H
+
+#include <vector>
+#include <pthread.h>
+
+class Street;
+
+/*
+ * The streets of a tick are spread over the threads by their cost, the vehicles on them and the ones waiting to enter,
+ * the most expensive ones first and each to the thread with the least work so far. Every thread works through its own
+ * streets from the most expensive one and steals the cheapest street left of another thread when it runs out, so a few
+ * busy streets don't keep the other threads idle. The thread that calls run() works as well.
+ */
+class StreetPool {
+    struct Worker {
+        StreetPool* pool;
+        unsigned int index;
+        pthread_t thread;
+        // The streets of the worker are tasks[head, tail): the worker takes them from the head, thieves from the tail
+        pthread_mutex_t mutex;
+        std::vector<Street*> tasks;
+        unsigned int head;
+        unsigned int tail;
+    };
+
+    StreetPool* _initCheck;
+
+    std::vector<Worker*> fWorkers;
+    pthread_mutex_t fMutex;
+    pthread_cond_t fStart;
+    pthread_cond_t fDone;
+    // Raised for every run(), the threads wait for it to change
+    unsigned long fGeneration;
+    // Threads that didn't finish the current run yet
+    unsigned int fBusy;
+    bool fStop;
+    double fTime;
+
+    // Reused by run() between ticks
+    std::vector<std::pair<unsigned int, unsigned int> > fCosts;
+    std::vector<unsigned int> fLoads;
+
+    static void* workerLoop(void* worker);
+
+    bool take(unsigned int worker, Street* &street);
+
+    void work(unsigned int worker);
+
+public:
+    /*
+     * Starts `threads` - 1 threads, fewer if they can't be created.
+     *
+     * REQUIRE(threads > 0, "A StreetPool needs at least one thread")
+     *
+     * ENSURE(properlyInitialized(), "StreetPool constructor did not end in an initialized state")
+     * ENSURE(getThreads() <= threads, "StreetPool constructor postcondition")
+     */
+    explicit StreetPool(unsigned int threads);
+
+    /*
+     * Stops and joins the threads.
+     */
+    virtual ~StreetPool();
+
+    bool properlyInitialized() const;
+
+    /*
+     * The amount of threads that work on a run, including the one that calls run().
+     *
+     * REQUIRE(properlyInitialized(), "StreetPool wasn't initialized when calling getThreads()")
+     */
+    unsigned int getThreads() const;
+
+    /*
+     * Drives the vehicles of every street of `streets` and simulates its traffic lights and bus stops at `time`, and
+     * returns when all streets are done. Every street is simulated by one thread, the streets must not share anything
+     * that is changed while they are simulated.
+     *
+     * REQUIRE(properlyInitialized(), "StreetPool wasn't initialized when calling run()")
+     */
+    void run(const std::vector<Street*> &streets, double time);
+};
+
+
+#endif
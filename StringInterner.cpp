@@ -0,0 +1,70 @@
+// ===========================================================
+// Name         : StringInterner.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `StringInterner` class which maps names to compact ids
+// ===========================================================
+
+#include "StringInterner.h"
+#include "DesignByContract.h"
+
+StringInterner::StringInterner() {
+    pthread_mutex_init(&fMutex, NULL);
+    StringInterner::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "StringInterner constructor did not end in an initialized state");
+}
+
+StringInterner::~StringInterner() {
+    pthread_mutex_destroy(&fMutex);
+}
+
+bool StringInterner::properlyInitialized() const {
+    return StringInterner::_initCheck == this;
+}
+
+StringInterner &StringInterner::streetNames() {
+    static StringInterner interner;
+    return interner;
+}
+
+unsigned int StringInterner::intern(const std::string &s) {
+    REQUIRE(properlyInitialized(), "StringInterner wasn't initialized when calling intern()");
+
+    pthread_mutex_lock(&fMutex);
+    std::map<std::string, unsigned int>::iterator it = fIds.find(s);
+    unsigned int id;
+    if (it != fIds.end()) {
+        id = it->second;
+    } else {
+        id = fStrings.size();
+        fStrings.push_back(s);
+        fIds.insert(std::make_pair(s, id));
+    }
+    pthread_mutex_unlock(&fMutex);
+
+    ENSURE(getString(id) == s, "intern() postcondition");
+
+    return id;
+}
+
+const std::string &StringInterner::getString(unsigned int id) const {
+    REQUIRE(properlyInitialized(), "StringInterner wasn't initialized when calling getString()");
+    REQUIRE(id < size(), "The id was not handed out by this StringInterner");
+
+    pthread_mutex_lock(&fMutex);
+    const std::string &s = fStrings[id];
+    pthread_mutex_unlock(&fMutex);
+
+    return s;
+}
+
+unsigned int StringInterner::size() const {
+    REQUIRE(properlyInitialized(), "StringInterner wasn't initialized when calling size()");
+
+    pthread_mutex_lock(&fMutex);
+    unsigned int size = fStrings.size();
+    pthread_mutex_unlock(&fMutex);
+
+    return size;
+}
@@ -0,0 +1,59 @@
+// ===========================================================
+// Name         : StringInterner.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `StringInterner` class which maps names to compact ids
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_STRINGINTERNER_H
+#define TRAFFICSIMULATION_STRINGINTERNER_H
+
+#include <iostream>
+#include <map>
+#include <deque>
+#include <pthread.h>
+
+class StringInterner {
+    StringInterner* _initCheck;
+
+    std::map<std::string, unsigned int> fIds;
+    // A deque never moves its elements, so references returned by getString() stay valid
+    std::deque<std::string> fStrings;
+    mutable pthread_mutex_t fMutex;
+
+public:
+    /*
+     * ENSURE(properlyInitialized(), "StringInterner constructor did not end in an initialized state")
+     */
+    StringInterner();
+
+    virtual ~StringInterner();
+
+    bool properlyInitialized() const;
+
+    /*
+     * The interner that is shared by every object that refers to a street by its name.
+     */
+    static StringInterner &streetNames();
+
+    /*
+     * REQUIRE(properlyInitialized(), "StringInterner wasn't initialized when calling intern()")
+     *
+     * ENSURE(getString(id) == s, "intern() postcondition")
+     */
+    unsigned int intern(const std::string &s);
+
+    /*
+     * REQUIRE(properlyInitialized(), "StringInterner wasn't initialized when calling getString()")
+     * REQUIRE(id < size(), "The id was not handed out by this StringInterner")
+     */
+    const std::string &getString(unsigned int id) const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "StringInterner wasn't initialized when calling size()")
+     */
+    unsigned int size() const;
+};
+
+
+#endif
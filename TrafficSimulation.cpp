@@ -8,6 +8,7 @@
 #include <iostream>
 #include <algorithm>
 #include <sstream>
+#include <iomanip>
 #include "TrafficSimulation.h"
 #include "DesignByContract.h"
 #include "Variables.h"
@@ -16,9 +17,21 @@
 #include "objects/Vehicle.h"
 #include "objects/VehicleGenerator.h"
 #include "objects/BusStop.h"
+#include "objects/Detector.h"
+#include "objects/Demand.h"
+#include "routing/RoadNetwork.h"
+#include "StreetPool.h"
 
-TrafficSimulation::TrafficSimulation() {
+TrafficSimulation::TrafficSimulation() : fRandom(1) {
+    TrafficSimulation::fVehicleTypes = VehicleTypeRegistry::builtInTypes().clone();
     TrafficSimulation::fTime = 0;
+    TrafficSimulation::fTick = 0;
+    TrafficSimulation::fNetwork = NULL;
+    TrafficSimulation::fLog = &std::cout;
+    TrafficSimulation::fCrossroadsChanged = false;
+    TrafficSimulation::fStreetPool = NULL;
+    TrafficSimulation::fTravelStatistics = NULL;
+    TrafficSimulation::fQueueListener = NULL;
     TrafficSimulation::_initCheck = this;
 
     ENSURE(properlyInitialized(), "TrafficSimulation constructor did not end in an initialized state");
@@ -26,6 +39,8 @@ TrafficSimulation::TrafficSimulation() {
 
 TrafficSimulation::~TrafficSimulation() {
     clearSimulation();
+    delete fStreetPool;
+    delete fVehicleTypes;
 
     ENSURE(fStreets.empty(), "TrafficSimulation destructor did not end in an empty state");
 }
@@ -34,20 +49,128 @@ bool TrafficSimulation::properlyInitialized() const {
     return TrafficSimulation::_initCheck == this;
 }
 
+void TrafficSimulation::copySimulation(const TrafficSimulation &source) {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling copySimulation()");
+    REQUIRE(source.properlyInitialized(), "The source wasn't initialized when calling copySimulation()");
+    REQUIRE(fStreets.empty(), "The simulation must be empty when calling copySimulation()");
+
+    delete fVehicleTypes;
+    fVehicleTypes = source.fVehicleTypes->clone();
+    std::map<const Street*, Street*> streets;
+    for (unsigned int i = 0; i < source.fStreets.size(); i++) {
+        Street* copy = source.fStreets[i]->clone();
+        copy->setVehicleTypes(*fVehicleTypes);
+        copy->setTravelStatistics(fTravelStatistics);
+        copy->setQueueListener(fQueueListener);
+        streets[source.fStreets[i]] = copy;
+        fStreets.push_back(copy);
+    }
+    for (unsigned int i = 0; i < source.fStreets.size(); i++) {
+        const std::map<Street*,int> &crossroads = source.fStreets[i]->getCrossroads();
+        for (std::map<Street*,int>::const_iterator it = crossroads.begin(); it != crossroads.end(); it++) {
+            fStreets[i]->addCrossroad(streets[it->first], it->second);
+        }
+    }
+    if (source.fNetwork != NULL) {
+        fNetwork = source.fNetwork->clone(fStreets);
+    }
+    for (unsigned int i = 0; i < source.fDemands.size(); i++) {
+        fDemands.push_back(source.fDemands[i]->clone());
+        fDemandStreets.push_back(streets[source.fDemandStreets[i]]);
+        fDemandDestinations.push_back(source.fDemandDestinations[i]);
+    }
+    fTime = source.fTime;
+    fTick = source.fTick;
+    fNetworkSlots = source.fNetworkSlots;
+    fRandom.setSeed(source.fRandom.getSeed());
+    scheduleSources();
+
+    ENSURE(fStreets.size() == source.getStreets().size(), "copySimulation() postcondition");
+}
+
+void TrafficSimulation::setSeed(unsigned int seed) {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling setSeed()");
+
+    fRandom.setSeed(seed);
+
+    ENSURE(getSeed() == seed, "setSeed() postcondition");
+}
+
+unsigned int TrafficSimulation::getSeed() const {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getSeed()");
+
+    return fRandom.getSeed();
+}
+
+void TrafficSimulation::setStreetLevel(EStreetLevel level) {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling setStreetLevel()");
+
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        fStreets[i]->setLevel(level);
+    }
+}
+
+void TrafficSimulation::setTravelStatistics(TravelStatistics *statistics) {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling setTravelStatistics()");
+
+    fTravelStatistics = statistics;
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        fStreets[i]->setTravelStatistics(statistics);
+    }
+}
+
+void TrafficSimulation::setQueueListener(QueueListener *listener) {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling setQueueListener()");
+
+    fQueueListener = listener;
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        fStreets[i]->setQueueListener(listener);
+    }
+}
+
+void TrafficSimulation::setLogStream(std::ostream *log) {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling setLogStream()");
+
+    fLog = log;
+}
+
+void TrafficSimulation::setThreads(unsigned int threads) {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling setThreads()");
+    REQUIRE(threads > 0, "A simulation needs at least one thread");
+
+    delete fStreetPool;
+    fStreetPool = threads > 1 ? new StreetPool(threads) : NULL;
+
+    ENSURE(getThreads() <= threads, "setThreads() postcondition");
+}
+
+unsigned int TrafficSimulation::getThreads() const {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getThreads()");
+
+    return fStreetPool == NULL ? 1 : fStreetPool->getThreads();
+}
+
 EParserSuccess TrafficSimulation::parseInputFile(const std::string &filename, std::ostream &errStream) {
     REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling parseInputFile()");
     REQUIRE(errStream.good(), "The errorStream wasn't good when calling parseInputFile()");
 
     EParserSuccess parseSuccess = Success;
 
-    ElementParser parser;
+    ElementParser parser(*fVehicleTypes);
     parseSuccess = parser.parseFile(filename, errStream);
 
     TrafficSimulation::fStreets = parser.getStreets();
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        fStreets[i]->setIndex(i);
+    }
     std::vector<TrafficLight*> trafficLights = parser.getTrafficLights();
     std::vector<Vehicle*> vehicles = parser.getVehicles();
+    const std::vector<std::string> &vehicleDestinations = parser.getVehicleDestinations();
     std::vector<VehicleGenerator*> vehicleGenerators = parser.getVehicleGenerators();
+    const std::vector<std::string> &vehicleGeneratorDestinations = parser.getVehicleGeneratorDestinations();
     std::vector<BusStop*> busStops = parser.getBusStops();
+    std::vector<Detector*> detectors = parser.getDetectors();
+    std::vector<Demand*> demands = parser.getDemands();
     std::vector<std::pair<std::pair<std::string, unsigned int>, std::pair<std::string, unsigned int> > > crossroads = parser.getCrossroads();
 
     for (long unsigned int i = 0; i < trafficLights.size(); i++) {
@@ -76,8 +199,15 @@ EParserSuccess TrafficSimulation::parseInputFile(const std::string &filename, st
 
     for (long unsigned int i = 0; i < vehicles.size(); i++) {
         Vehicle* curVehicle = vehicles[i];
+        curVehicle->setId(0, i);
         Street* curStreet = getStreetFromString(curVehicle->getStreet());
-        if (curStreet != NULL && curVehicle->getPosition() < curStreet->getLength()) {
+        Street* destination = getStreetFromString(vehicleDestinations[i]);
+        bool validDestination = vehicleDestinations[i].empty() || destination != NULL;
+        if (curStreet != NULL && curVehicle->getPosition() < curStreet->getLength() && curVehicle->getLane() < curStreet->getLanes()
+                && validDestination) {
+            if (destination != NULL) {
+                curVehicle->setDestination(destination->getIndex());
+            }
             curStreet->addVehicle(curVehicle);
         } else {
             errStream << "XML IMPORT ABORT: The simulation is not consistent." << std::endl;
@@ -88,7 +218,12 @@ EParserSuccess TrafficSimulation::parseInputFile(const std::string &filename, st
     for (long unsigned int i = 0; i < vehicleGenerators.size(); i++) {
         VehicleGenerator* curVehicleGenerator = vehicleGenerators[i];
         Street* curStreet = getStreetFromString(curVehicleGenerator->getStreet());
-        if (curStreet != NULL && !curStreet->hasVehicleGenerator()) {
+        Street* destination = getStreetFromString(vehicleGeneratorDestinations[i]);
+        bool validDestination = vehicleGeneratorDestinations[i].empty() || destination != NULL;
+        if (curStreet != NULL && !curStreet->hasVehicleGenerator() && validDestination) {
+            if (destination != NULL) {
+                curVehicleGenerator->setDestination(destination->getIndex());
+            }
             curStreet->setVehicleGenerator(curVehicleGenerator);
         } else {
             errStream << "XML IMPORT ABORT: The simulation is not consistent." << std::endl;
@@ -107,6 +242,17 @@ EParserSuccess TrafficSimulation::parseInputFile(const std::string &filename, st
         }
     }
 
+    for (long unsigned int i = 0; i < detectors.size(); i++) {
+        Detector* curDetector = detectors[i];
+        Street* curStreet = getStreetFromString(curDetector->getStreet());
+        if (curStreet != NULL && curDetector->getPosition() >= 0 && curDetector->getPosition() < curStreet->getLength()) {
+            curStreet->addDetector(curDetector);
+        } else {
+            errStream << "XML IMPORT ABORT: The simulation is not consistent." << std::endl;
+            return ImportAborted;
+        }
+    }
+
     for (long unsigned int i = 0; i < crossroads.size(); i++) {
         std::pair<std::string, unsigned int> curPair1 = crossroads[i].first;
         std::pair<std::string, unsigned int> curPair2 = crossroads[i].second;
@@ -120,9 +266,32 @@ EParserSuccess TrafficSimulation::parseInputFile(const std::string &filename, st
         curStreet2->addCrossroad(curStreet1, curPair2.second);
     }
 
+    // Demand matrices can have a cell for every pair of streets, so the streets are looked up by name in a map
+    std::map<std::string, Street*> streetsByName;
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        streetsByName[fStreets[i]->getName()] = fStreets[i];
+    }
+    for (long unsigned int i = 0; i < demands.size(); i++) {
+        Demand* curDemand = demands[i];
+        std::map<std::string, Street*>::const_iterator origin = streetsByName.find(curDemand->getOrigin());
+        std::map<std::string, Street*>::const_iterator destination = streetsByName.find(curDemand->getDestination());
+        if (origin != streetsByName.end() && destination != streetsByName.end()) {
+            fDemands.push_back(curDemand);
+            fDemandStreets.push_back(origin->second);
+            fDemandDestinations.push_back(destination->second->getIndex());
+        } else {
+            errStream << "XML IMPORT ABORT: The simulation is not consistent." << std::endl;
+            return ImportAborted;
+        }
+    }
+
     for (unsigned int i = 0; i < fStreets.size(); i++) {
         fStreets[i]->sortVehicles();
     }
+    std::vector<unsigned int> destinations;
+    collectDestinations(destinations);
+    buildNetwork(destinations);
+    scheduleSources();
 
     ENSURE(errStream.good(), "The errorStream wasn't good at the end of parseInputFile()");
     ENSURE(parseSuccess == Success || parseSuccess == PartialImport || parseSuccess == ImportAborted, "The parser did not return a proper success or aborted value");
@@ -152,6 +321,60 @@ void TrafficSimulation::writeOn(std::ostream &onstream) const {
     ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeOn()");
 }
 
+void TrafficSimulation::writeDetectors(std::ostream &onstream) const {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling writeDetectors()");
+    REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeDetectors()");
+
+    onstream << "street,position,interval_start,interval_end,count,occupancy" << std::endl;
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        const std::vector<Detector*> &detectors = fStreets[i]->getDetectors();
+        for (unsigned int j = 0; j < detectors.size(); j++) {
+            detectors[j]->writeOn(onstream);
+        }
+    }
+
+    ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeDetectors()");
+}
+
+void TrafficSimulation::writeQueues(std::ostream &onstream) const {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling writeQueues()");
+    REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeQueues()");
+
+    onstream << "street,position,interval_start,max_queue_length" << std::endl;
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        const std::vector<TrafficLight*> &trafficLights = fStreets[i]->getTrafficLights();
+        for (unsigned int j = 0; j < trafficLights.size(); j++) {
+            const std::vector<unsigned int> &samples = trafficLights[j]->getQueueSamples();
+            for (unsigned int k = 0; k < samples.size(); k++) {
+                onstream << fStreets[i]->getName() << "," << trafficLights[j]->getPosition() << ","
+                         << k * gQueueSampleInterval << "," << samples[k] << std::endl;
+            }
+        }
+    }
+
+    ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeQueues()");
+}
+
+void TrafficSimulation::writeEntryQueues(std::ostream &onstream) const {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling writeEntryQueues()");
+    REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeEntryQueues()");
+
+    onstream << "street,generated,waiting,max_queue_length,mean_queue_length,mean_wait" << std::endl;
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        const Street* street = fStreets[i];
+        if (street->getGeneratedVehicles() == 0) {
+            continue;
+        }
+        unsigned int waiting = street->getEntryQueue().size();
+        unsigned int entered = street->getGeneratedVehicles() - waiting;
+        onstream << street->getName() << "," << street->getGeneratedVehicles() << "," << waiting << ","
+                 << street->getMaxEntryQueue() << "," << (fTime > 0 ? street->getEntryQueueTime() / fTime : 0) << ","
+                 << (entered > 0 ? street->getEntryQueueTime() / entered : 0) << std::endl;
+    }
+
+    ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeEntryQueues()");
+}
+
 void TrafficSimulation::visualize(std::ostream &onstream) const {
     REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling visualize()");
     REQUIRE(onstream.good(), "The outputStream wasn't good when calling visualize()");
@@ -163,23 +386,8 @@ void TrafficSimulation::visualize(std::ostream &onstream) const {
         << "\"cars\": [ ";
         for (unsigned int k = 0; k < fStreets[i]->getVehicles().size(); k++) {
             Vehicle* curVehicle = fStreets[i]->getVehicles()[k];
-            onstream << "{\"x\": " << curVehicle->getPosition();
-            std::string curType = curVehicle->getType();
-            if (curType == "Car") {
-                onstream << ", \"type\": \"car\"}";
-            }
-            else if (curType == "Bus") {
-                onstream << ", \"type\": \"bus\"}";
-            }
-            else if (curType == "FireEngine") {
-                onstream << ", \"type\": \"firetruck\"}";
-            }
-            else if (curType == "Ambulance") {
-                onstream << ", \"type\": \"ambulance\"}";
-            }
-            else {
-                onstream << ", \"type\": \"police_cruiser\"}";
-            }
+            onstream << "{\"x\": " << curVehicle->getPosition()
+                     << ", \"type\": \"" << curVehicle->getParameters().visualizerName << "\"}";
             if (k != fStreets[i]->getVehicles().size()-1) {
                 onstream << ", ";
             }
@@ -215,54 +423,52 @@ void TrafficSimulation::graph(std::ostream &onstream) const {
     REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling graph()");
     REQUIRE(onstream.good(), "The outputStream wasn't good when calling graph()");
 
-    std::string verkeerslichten = " > verkeerslichten";
-    std::string bushaltes = " > bushaltes";
-
-    for(int i = 0; i<(int)getStreets().size(); i++){
-        std::vector<Vehicle*> vehicles = getStreets()[i]->getVehicles();
-        std::vector<TrafficLight*> lights = getStreets()[i]->getTrafficLights();
-        std::vector<BusStop*> busstops = getStreets()[i]->getBusStops();
-        
-        std::vector<int> sizes; sizes.push_back(fStreets[i]->getName().size()); sizes.push_back(bushaltes.size()); sizes.push_back(verkeerslichten.size());
-        int alignment = *max_element(sizes.begin(),sizes.end()) + 2;
+    const std::string verkeerslichten = " > verkeerslichten";
+    const std::string bushaltes = " > bushaltes";
 
-        int streetlength = (int)getStreets()[i]->getLength()/10;
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        const std::vector<Vehicle*> &vehicles = fStreets[i]->getVehicles();
+        const std::vector<TrafficLight*> &lights = fStreets[i]->getTrafficLights();
+        const std::vector<BusStop*> &busstops = fStreets[i]->getBusStops();
 
-        std::string line1; std::string line2; std::string line3;
+        int alignment = (int) std::max(fStreets[i]->getName().size(), std::max(bushaltes.size(), verkeerslichten.size())) + 2;
 
-        for(int stl = 0; stl<streetlength;stl++){
-            line1 += "="; line2 += " "; line3 += " ";
+        int streetlength = fStreets[i]->getLength()/10;
+        if (streetlength < 0) {
+            streetlength = 0;
         }
 
-        for(int s = 0; s < (int)getStreets()[i]->getLength()/10;s++){
-            for(int j = 0; j < (int)vehicles.size(); j++){
-                if(s == (int)vehicles[j]->getPosition()/10){
-                    line1[s] = vehicles[j]->getAcronym();
-                }
-            }
-
-            for(int l = 0; l < (int)lights.size(); l++){
-
-                if(s == (int)lights[l]->getPosition()/10){
-                    char state = 'R';
-
-                    if(lights[l]->isGreen()){state = 'G';}
+        // The buffers keep their capacity between calls, so they only grow for the longest street seen so far
+        fGraphLine1.assign(streetlength, '=');
+        fGraphLine2.assign(streetlength, ' ');
+        fGraphLine3.assign(streetlength, ' ');
 
-                    line2[s] = state;
-                }
+        // Every entity is placed exactly once, later entities overwrite earlier ones in the same cell
+        for (unsigned int j = 0; j < vehicles.size(); j++) {
+            int cell = (int)vehicles[j]->getPosition()/10;
+            if (cell >= 0 && cell < streetlength) {
+                fGraphLine1[cell] = vehicles[j]->getAcronym();
             }
-
-            for(int b = 0; b<(int)busstops.size();b++){
-                line3[busstops[b]->getPosition()/10] = 'B';
-                line2[busstops[b]->getPosition()/10] = '|';
+        }
+        for (unsigned int l = 0; l < lights.size(); l++) {
+            int cell = lights[l]->getPosition()/10;
+            if (cell >= 0 && cell < streetlength) {
+                fGraphLine2[cell] = lights[l]->isGreen() ? 'G' : 'R';
+            }
+        }
+        // Bus stops are drawn last as they take precedence over traffic lights on the second line
+        for (unsigned int b = 0; b < busstops.size(); b++) {
+            int cell = busstops[b]->getPosition()/10;
+            if (cell >= 0 && cell < streetlength) {
+                fGraphLine3[cell] = 'B';
+                fGraphLine2[cell] = '|';
             }
-
         }
 
         onstream << std::left;
-        onstream.width(alignment); onstream  << fStreets[i]->getName()  << "| " << line1 << std::endl;
-        onstream.width(alignment); onstream  << verkeerslichten         << "| " << line2 << std::endl;
-        onstream.width(alignment); onstream  << bushaltes               << "| " << line3 << std::endl;
+        onstream.width(alignment); onstream  << fStreets[i]->getName()  << "| " << fGraphLine1 << std::endl;
+        onstream.width(alignment); onstream  << verkeerslichten         << "| " << fGraphLine2 << std::endl;
+        onstream.width(alignment); onstream  << bushaltes               << "| " << fGraphLine3 << std::endl;
         onstream  << std::endl;
     }
 
@@ -273,35 +479,127 @@ void TrafficSimulation::simulate() {
     REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling simulate()");
 
     unsigned int beginSize = fStreets.size();
-    for (long unsigned int i = 0; i < fStreets.size(); i++) {
-        simCrossroads();
-        fStreets[i]->simGenerator(fTime);
-        fStreets[i]->driveVehicles();
-        fStreets[i]->simTrafficLights(fTime);
-        fStreets[i]->simBusStops(fTime);
+    spawnVehicles();
+
+    bool pooled = fStreetPool != NULL && fTravelStatistics == NULL && fQueueListener == NULL;
+    if (pooled) {
+        fPoolStreets.clear();
+        for (unsigned int i = 0; i < fStreets.size(); i++) {
+            if (fStreets[i]->getCrossroads().empty() && !fStreets[i]->isIdle()) {
+                fPoolStreets.push_back(fStreets[i]);
+            }
+        }
+        fStreetPool->run(fPoolStreets, fTime);
+    }
+
+    // simCrossroads() only looks at the vehicles on streets with crossroads, so it does the same as the last time
+    // until one of them drives or until the last time changed something
+    bool crossroadsChanged = true;
+    unsigned int slots = fNetworkSlots.empty() ? fStreets.size() : fNetworkSlots.size();
+    for (long unsigned int i = 0; i < slots; i++) {
+        if (crossroadsChanged) {
+            simCrossroads();
+            crossroadsChanged = fCrossroadsChanged;
+        }
+        int street = fNetworkSlots.empty() ? (int) i : fNetworkSlots[i];
+        if (street < 0 || fStreets[street]->isIdle()) {
+            continue;
+        }
+        bool crossroads = !fStreets[street]->getCrossroads().empty();
+        if (pooled && !crossroads) {
+            continue;
+        }
+        fStreets[street]->driveVehicles();
+        fStreets[street]->simTrafficLights(fTime);
+        fStreets[street]->simBusStops(fTime);
+        crossroadsChanged = crossroadsChanged || crossroads;
     }
 
     fTime += gSimulationTime;
+    fTick++;
 
     ENSURE(fStreets.size() == beginSize, "The number of streets changed when calling simulate()");
 }
 
+void TrafficSimulation::keepStreets(const std::vector<unsigned int> &streets) {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling keepStreets()");
+
+    std::vector<int> local(fStreets.size(), -1);
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        REQUIRE(streets[i] < fStreets.size() && (i == 0 || streets[i - 1] < streets[i]), "The streets must be ascending indices of streets");
+        local[streets[i]] = i;
+    }
+    std::map<const Street*, bool> kept;
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        kept[fStreets[i]] = local[i] >= 0;
+    }
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        const std::map<Street*,int> &crossroads = fStreets[streets[i]]->getCrossroads();
+        for (std::map<Street*,int>::const_iterator it = crossroads.begin(); it != crossroads.end(); it++) {
+            REQUIRE(kept[it->first], "A kept street has a crossroad with a street that isn't kept");
+        }
+    }
+
+    // Vehicles of the streets that aren't kept can still arrive here, so their destinations keep their routes
+    std::vector<unsigned int> destinations;
+    collectDestinations(destinations);
+
+    std::vector<Demand*> demands;
+    std::vector<Street*> demandStreets;
+    std::vector<unsigned int> demandDestinations;
+    for (unsigned int i = 0; i < fDemands.size(); i++) {
+        if (kept[fDemandStreets[i]]) {
+            demands.push_back(fDemands[i]);
+            demandStreets.push_back(fDemandStreets[i]);
+            demandDestinations.push_back(fDemandDestinations[i]);
+        } else {
+            delete fDemands[i];
+        }
+    }
+    fDemands = demands;
+    fDemandStreets = demandStreets;
+    fDemandDestinations = demandDestinations;
+
+    std::vector<Street*> keptStreets;
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        if (local[i] >= 0) {
+            keptStreets.push_back(fStreets[i]);
+        } else {
+            delete fStreets[i];
+        }
+    }
+    fStreets = keptStreets;
+
+    if (fNetworkSlots.empty()) {
+        fNetworkSlots = local;
+    } else {
+        for (unsigned int i = 0; i < fNetworkSlots.size(); i++) {
+            if (fNetworkSlots[i] >= 0) {
+                fNetworkSlots[i] = local[fNetworkSlots[i]];
+            }
+        }
+    }
+    buildNetwork(destinations);
+    scheduleSources();
+
+    ENSURE(fStreets.size() == streets.size(), "keepStreets() postcondition");
+}
 
 void TrafficSimulation::simCrossroads() {
     REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling simCrossroads()");
 
+    fCrossroadsChanged = false;
     for(int s = 0; s<(int)fStreets.size();s++) {
-        std::map<Street*,int> kruispunten = fStreets[s]->getCrossroads();
+        const std::map<Street*,int> &kruispunten = fStreets[s]->getCrossroads();
 
         for(int v = 0; v<(int)fStreets[s]->getVehicles().size();v++){
 
             Vehicle * veh = fStreets[s]->getVehicles()[v];
 
             int pos_veh = veh->getPosition();
-            std::string str_veh = veh->getStreet();
-            std::string type_veh = veh->getType();
 
-            for (std::map<Street*, int>::iterator it = kruispunten.begin(); it != kruispunten.end(); it++){
+            unsigned int k = 0;
+            for (std::map<Street*, int>::const_iterator it = kruispunten.begin(); it != kruispunten.end(); it++, k++){
                 int pos_new = findPosition(fStreets[s],it->first->getCrossroads());
 
                 Street * kruispunt = it->first;
@@ -310,30 +608,46 @@ void TrafficSimulation::simCrossroads() {
                     return;
                 }
                 if(pos_veh == at_pos && !veh->hasTurned()){
-                    std::cout << "DRIVING (" << pos_veh << ", " << str_veh << ", " << veh << ") ---> (" << at_pos << ", " << kruispunt->getName() << ", " << pos_new<<")" << std::endl;
+                    fCrossroadsChanged = true;
+                    if (fLog != NULL) {
+                        *fLog << "DRIVING (" << pos_veh << ", " << veh->getStreet() << ", " << veh << ") ---> (" << at_pos << ", " << kruispunt->getName() << ", " << pos_new<<")" << std::endl;
+                    }
 
-                    if(rand() % 2){
+                    ERouteChoice choice = RouteUnknown;
+                    if (fNetwork != NULL && veh->hasDestination() && fNetwork->hasRoutes(veh->getDestination())) {
+                        choice = fNetwork->getChoice(veh->getDestination(), s, k);
+                    }
+                    bool turn = choice == RouteTurn;
+                    if (choice == RouteUnknown) {
+                        turn = fRandom.draw(veh->getOrigin(), veh->getSerial(), fTick, kruispunt->getIndex()) % 2;
+                    }
 
-                        std::string type = veh->getType();
+                    if(turn){
 
                         Vehicle * newVehicle;
-                        newVehicle = fStreets[s]->CreateTypeVehicle(type,kruispunt->getName(),pos_new);
+                        newVehicle = fStreets[s]->CreateTypeVehicle(veh->getVehicleType(),kruispunt->getId(),pos_new,*fVehicleTypes);
                         newVehicle->setTurn(true);
+                        newVehicle->continueJourney(*veh);
 
                         it->first->addVehicle(newVehicle);
                         it->first->sortVehicles();
 
-                        std::cout << "C H O S E N - " << veh  <<std::endl<<std::endl;
+                        if (fLog != NULL) {
+                            *fLog << "C H O S E N - " << veh  <<std::endl<<std::endl;
+                        }
                         fStreets[s]->removeVehicleAddress(veh,v);
                         break;
                     }
                     else{
-                        std::cout << "S K I P P E D - " << veh <<std::endl<<std::endl;
+                        if (fLog != NULL) {
+                            *fLog << "S K I P P E D - " << veh <<std::endl<<std::endl;
+                        }
                         veh->setTurn(true);
                         continue;
                     }
                 }
                 else if(pos_veh != at_pos && veh->hasTurned() && !contains(pos_veh,kruispunten)){
+                    fCrossroadsChanged = true;
                     veh->setTurn(false);
                 }
             }
@@ -341,17 +655,18 @@ void TrafficSimulation::simCrossroads() {
     }
 }
 
-int TrafficSimulation::findPosition(Street * street, std::map<Street *, int> kruispunten) {
-    for (std::map<Street*, int>::iterator it = kruispunten.begin(); it != kruispunten.end(); it++){
-        if(it->first->getName() == street->getName()){
+int TrafficSimulation::findPosition(Street * street, const std::map<Street *, int> &kruispunten) const {
+    unsigned int streetId = street->getId();
+    for (std::map<Street*, int>::const_iterator it = kruispunten.begin(); it != kruispunten.end(); it++){
+        if(it->first->getId() == streetId){
             return it->second;
         }
     }
     return -1;
 }
-bool TrafficSimulation::contains(int pos_veh, std::map<Street *, int> kruispunten) {
+bool TrafficSimulation::contains(int pos_veh, const std::map<Street *, int> &kruispunten) const {
     bool exists = false;
-    for (std::map<Street*, int>::iterator it = kruispunten.begin(); it != kruispunten.end(); it++){
+    for (std::map<Street*, int>::const_iterator it = kruispunten.begin(); it != kruispunten.end(); it++){
         if(it->second == pos_veh){
             exists = true;
         }
@@ -362,14 +677,45 @@ void TrafficSimulation::clearSimulation() {
     REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling clearSimulation()");
 
     fTime = 0;
+    fTick = 0;
+    delete fNetwork;
+    fNetwork = NULL;
     for (unsigned int i = 0; i < fStreets.size(); i++) {
         delete fStreets[i];
     }
     fStreets.clear();
+    for (unsigned int i = 0; i < fDemands.size(); i++) {
+        delete fDemands[i];
+    }
+    fDemands.clear();
+    fDemandStreets.clear();
+    fDemandDestinations.clear();
+    fScheduler.clear();
+    fNetworkSlots.clear();
+    delete fVehicleTypes;
+    fVehicleTypes = VehicleTypeRegistry::builtInTypes().clone();
 
     ENSURE(fStreets.empty(), "The streets vector wasn't empty at the end of clearSimulation()");
 }
 
+const std::vector<Demand*> &TrafficSimulation::getDemands() const {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getDemands()");
+
+    return fDemands;
+}
+
+const RoadNetwork *TrafficSimulation::getNetwork() const {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getNetwork()");
+
+    return fNetwork;
+}
+
+const VehicleTypeRegistry &TrafficSimulation::getVehicleTypes() const {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getVehicleTypes()");
+
+    return *fVehicleTypes;
+}
+
 const std::vector<Street *> &TrafficSimulation::getStreets() const {
     REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getStreets()");
 
@@ -382,6 +728,29 @@ double TrafficSimulation::getTime() const {
     return fTime;
 }
 
+unsigned int TrafficSimulation::getTick() const {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getTick()");
+
+    return fTick;
+}
+
+unsigned int TrafficSimulation::queryVehicles(const unsigned int* streets, unsigned int count, VehicleBuffers &buffers) const {
+    REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling queryVehicles()");
+
+    unsigned int total = 0;
+    if (streets == NULL) {
+        for (unsigned int i = 0; i < fStreets.size(); i++) {
+            total += fStreets[i]->copyVehicles(buffers, total, i);
+        }
+        return total;
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        REQUIRE(streets[i] < fStreets.size(), "The street of a query doesn't exist");
+        total += fStreets[streets[i]]->copyVehicles(buffers, total, streets[i]);
+    }
+    return total;
+}
+
 void TrafficSimulation::createImage(unsigned int i, const std::string &size) {
     REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling createImage()");
 
@@ -449,19 +818,10 @@ void TrafficSimulation::createImage(unsigned int i, const std::string &size) {
 
             std::string centerVehicle = "(" + convert7.str() + ", " + convert6.str() + ", 0)";
 
-            std::string color;
-            std::string type = vehicles[l]->getType();
-            if (type == "Ambulance") {
-                color = "(1.00, 1.00, 1.00)";
-            } else if (type == "Bus") {
-                color = "(0.00, 1.00, 0.00)";
-            } else if (type == "Car") {
-                color = "(0.00, 0.00, 0.00)";
-            } else if (type == "FireEngine") {
-                color = "(1.00, 0.00, 0.00)";
-            } else {
-                color = "(0.00, 0.00, 1.00)";
-            }
+            const unsigned char* rgb = vehicles[l]->getParameters().color;
+            std::ostringstream color;
+            color << std::fixed << std::setprecision(2) << "(" << rgb[0] / 255.0 << ", " << rgb[1] / 255.0 << ", "
+                  << rgb[2] / 255.0 << ")";
 
             ini << "[Figure" << convert5.str() << "]" << std::endl
             << "type = \"Cube\"" << std::endl
@@ -470,7 +830,7 @@ void TrafficSimulation::createImage(unsigned int i, const std::string &size) {
             << "rotateY = 0" << std::endl
             << "rotateZ = 0" << std::endl
             << "center = " << centerVehicle << std::endl
-            << "ambientReflection = " << color << std::endl << std::endl;
+            << "ambientReflection = " << color.str() << std::endl << std::endl;
 
             figureNumber += 1;
         }
@@ -540,6 +900,68 @@ void TrafficSimulation::createImage(unsigned int i, const std::string &size) {
     system(command.c_str());
 }
 
+void TrafficSimulation::collectDestinations(std::vector<unsigned int> &destinations) const {
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        const std::vector<Vehicle*> &vehicles = fStreets[i]->getVehicles();
+        for (unsigned int j = 0; j < vehicles.size(); j++) {
+            if (vehicles[j]->hasDestination()) {
+                destinations.push_back(vehicles[j]->getDestination());
+            }
+        }
+        const std::deque<Vehicle*> &queue = fStreets[i]->getEntryQueue();
+        for (unsigned int j = 0; j < queue.size(); j++) {
+            if (queue[j]->hasDestination()) {
+                destinations.push_back(queue[j]->getDestination());
+            }
+        }
+        if (fStreets[i]->hasVehicleGenerator() && fStreets[i]->getVehicleGenerator()->hasDestination()) {
+            destinations.push_back(fStreets[i]->getVehicleGenerator()->getDestination());
+        }
+    }
+    destinations.insert(destinations.end(), fDemandDestinations.begin(), fDemandDestinations.end());
+}
+
+void TrafficSimulation::buildNetwork(const std::vector<unsigned int> &destinations) {
+    delete fNetwork;
+    fNetwork = destinations.empty() ? NULL : new RoadNetwork(fStreets, destinations);
+}
+
+void TrafficSimulation::scheduleSources() {
+    fScheduler.clear();
+    for (unsigned int i = 0; i < fStreets.size(); i++) {
+        if (fStreets[i]->hasVehicleGenerator()) {
+            fScheduler.schedule(fStreets[i]->getVehicleGenerator()->getTimeSinceLastSpawn(), i);
+        }
+    }
+    for (unsigned int i = 0; i < fDemands.size(); i++) {
+        if (fDemands[i]->getNextArrival() >= 0) {
+            fScheduler.schedule(fDemands[i]->getNextArrival(), fStreets.size() + i);
+        }
+    }
+}
+
+void TrafficSimulation::spawnVehicles() {
+    while (fScheduler.isDue(fTime)) {
+        unsigned int source = fScheduler.pop();
+        if (source < fStreets.size()) {
+            // Keyed like the draws of the vehicle the generator spawns, with a tick that is never reached
+            Street* street = fStreets[source];
+            double uniform = fRandom.draw(street->getIndex() + 1, street->getGeneratedVehicles(), 0xFFFFFFFFu, 0) / 4294967296.0;
+            street->simGenerator(fTime, uniform, *fVehicleTypes);
+            fScheduler.schedule(street->getVehicleGenerator()->getTimeSinceLastSpawn(), source);
+            continue;
+        }
+        Demand* demand = fDemands[source - fStreets.size()];
+        Street* street = fDemandStreets[source - fStreets.size()];
+        Vehicle* vehicle = street->CreateTypeVehicle(demand->arrive(), street->getId(), 0, *fVehicleTypes);
+        vehicle->setDestination(fDemandDestinations[source - fStreets.size()]);
+        street->spawnVehicle(vehicle, fTime);
+        if (demand->getNextArrival() >= 0) {
+            fScheduler.schedule(demand->getNextArrival(), source);
+        }
+    }
+}
+
 Street *TrafficSimulation::getStreetFromString(const std::string &name) const {
     for (long unsigned int i = 0; i < fStreets.size(); i++) {
         if (fStreets[i]->getName() == name) {
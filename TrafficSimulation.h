@@ -12,14 +12,59 @@
 #include <fstream>
 #include <map>
 #include "parsers/ElementParser.h"
+#include "CounterRandom.h"
+#include "SpawnScheduler.h"
+#include "objects/Street.h"
 
 class Street;
+class TravelStatistics;
+class QueueListener;
+class RoadNetwork;
+class Demand;
+class StreetPool;
 
 class TrafficSimulation {
     TrafficSimulation* _initCheck;
 
     std::vector<Street*> fStreets;
+    // The built-in vehicle types and the ones of the parsed file, the vehicles of the simulation point into it
+    VehicleTypeRegistry* fVehicleTypes;
     double fTime;
+    unsigned int fTick;
+
+    // Decides whether a vehicle turns, keyed by the vehicle id, the tick and the crossing street so the outcome
+    // doesn't depend on the order in which the streets are simulated
+    CounterRandom fRandom;
+    // The routes of the vehicles with a destination, built after parsing
+    RoadNetwork* fNetwork;
+    // The cells of the origin-destination matrix, the street on which the vehicles of each of them enter and the index
+    // of the street they head for
+    std::vector<Demand*> fDemands;
+    std::vector<Street*> fDemandStreets;
+    std::vector<unsigned int> fDemandDestinations;
+    // The next arrival of every vehicle generator (source i is the generator of street i) and every demand (source
+    // fStreets.size() + j is demand j)
+    SpawnScheduler fScheduler;
+    // Empty for a whole network. After keepStreets() one slot per street of the whole network, in its order: the index
+    // of the street in fStreets, or -1 if another partition simulates it
+    std::vector<int> fNetworkSlots;
+    // Where simCrossroads() reports the turns, NULL to stay silent
+    std::ostream* fLog;
+    // Whether the last simCrossroads() turned a vehicle or changed whether one turned
+    bool fCrossroadsChanged;
+
+    // Simulates the streets without crossroads on several threads, NULL to simulate every street in turn
+    StreetPool* fStreetPool;
+    // The streets of the current tick for the pool, reused between ticks
+    std::vector<Street*> fPoolStreets;
+    // Shared by all streets, so streets that report to them are simulated in turn. Not owned.
+    TravelStatistics* fTravelStatistics;
+    QueueListener* fQueueListener;
+
+    // Line buffers reused by graph() between ticks
+    mutable std::string fGraphLine1;
+    mutable std::string fGraphLine2;
+    mutable std::string fGraphLine3;
 
 public:
     /*
@@ -34,6 +79,73 @@ public:
 
     bool properlyInitialized() const;
 
+    /*
+     * Makes this simulation a deep copy of `source`, including its time and seed. The travel statistics and queue
+     * listener of this simulation stay attached, those of `source` aren't copied.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling copySimulation()")
+     * REQUIRE(source.properlyInitialized(), "The source wasn't initialized when calling copySimulation()")
+     * REQUIRE(fStreets.empty(), "The simulation must be empty when calling copySimulation()")
+     *
+     * ENSURE(fStreets.size() == source.getStreets().size(), "copySimulation() postcondition")
+     */
+    void copySimulation(const TrafficSimulation &source);
+
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling setSeed()")
+     *
+     * ENSURE(getSeed() == seed, "setSeed() postcondition")
+     */
+    void setSeed(unsigned int seed);
+
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getSeed()")
+     */
+    unsigned int getSeed() const;
+
+    /*
+     * Sets the level of every street that is currently in the simulation.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling setStreetLevel()")
+     */
+    void setStreetLevel(EStreetLevel level);
+
+    /*
+     * Records the journey of every vehicle that leaves the network from now on in `statistics`, or stops recording if
+     * it is NULL. The statistics are not owned by the simulation.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling setTravelStatistics()")
+     */
+    void setTravelStatistics(TravelStatistics* statistics);
+
+    /*
+     * Sets the listener of the spillbacks on every street, NULL to stay silent. The listener is not owned.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling setQueueListener()")
+     */
+    void setQueueListener(QueueListener* listener);
+
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling setLogStream()")
+     */
+    void setLogStream(std::ostream* log);
+
+    /*
+     * Simulates the streets without crossroads on `threads` threads, 1 simulates every street in turn. The result is
+     * the same for any amount of threads. A copy of the simulation simulates every street in turn.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling setThreads()")
+     * REQUIRE(threads > 0, "A simulation needs at least one thread")
+     *
+     * ENSURE(getThreads() <= threads, "setThreads() postcondition")
+     */
+    void setThreads(unsigned int threads);
+
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getThreads()")
+     */
+    unsigned int getThreads() const;
+
     /*
      * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling parseInputFile()")
      * REQUIRE(errStream.good(), "The errorStream wasn't good when calling parseInputFile()")
@@ -51,6 +163,37 @@ public:
      */
     void writeOn(std::ostream &onstream = std::cout) const;
 
+    /*
+     * Writes the counts and occupancy of every detector per interval as a CSV table.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling writeDetectors()")
+     * REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeDetectors()")
+     *
+     * ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeDetectors()")
+     */
+    void writeDetectors(std::ostream &onstream) const;
+
+    /*
+     * Writes the longest queue of every interval of gQueueSampleInterval seconds of every traffic light as a CSV table.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling writeQueues()")
+     * REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeQueues()")
+     *
+     * ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeQueues()")
+     */
+    void writeQueues(std::ostream &onstream) const;
+
+    /*
+     * Writes the entry queue of every street on which vehicles are generated as a CSV table: the generated vehicles,
+     * the vehicles still waiting, the longest and mean queue length and the time waited per vehicle that entered.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling writeEntryQueues()")
+     * REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeEntryQueues()")
+     *
+     * ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeEntryQueues()")
+     */
+    void writeEntryQueues(std::ostream &onstream) const;
+
     /*
      * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling visualize()")
      * REQUIRE(onstream.good(), "The outputStream wasn't good when calling visualize()")
@@ -68,6 +211,10 @@ public:
     void graph(std::ostream &onstream = std::cout) const;
 
     /*
+     * Streets that are idle (Street::isIdle()) are skipped. simCrossroads() is left out before a street when nothing
+     * it looks at changed since it last changed nothing, which gives the same result. Streets without crossroads are
+     * never touched by simCrossroads(), so with several threads they are simulated on the pool before the others.
+     *
      * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling simulate()")
      *
      * ENSURE(fStreets.size() == beginSize, "The number of streets changed when calling simulate()")
@@ -75,6 +222,22 @@ public:
     void simulate();
 
     /*
+     * Turns the simulation into a partition of itself: only the streets in `streets` (indices in getStreets(), in
+     * ascending order) are kept, with their vehicles, generators and the demands that start on them. The crossroads are
+     * still checked before the turn of every street of the whole network, so a partition of whole connected parts of
+     * the network simulates its streets exactly like the whole network does.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling keepStreets()")
+     * REQUIRE(streets[i] < fStreets.size() && (i == 0 || streets[i - 1] < streets[i]), "The streets must be ascending indices of streets")
+     * REQUIRE(kept[crossroad street], "A kept street has a crossroad with a street that isn't kept")
+     *
+     * ENSURE(fStreets.size() == streets.size(), "keepStreets() postcondition")
+     */
+    void keepStreets(const std::vector<unsigned int> &streets);
+
+    /*
+    * A vehicle with a destination turns when the road network says so, the others turn at random.
+    *
     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling simCrossroads()")
     */
     void simCrossroads();
@@ -86,24 +249,73 @@ public:
      */
     void clearSimulation();
 
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getDemands()")
+     */
+    const std::vector<Demand*> &getDemands() const;
+
+    /*
+     * Returns the road network of the parsed streets, NULL before parsing or when nothing has a destination.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getNetwork()")
+     */
+    const RoadNetwork* getNetwork() const;
+
     /*
      * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getStreets()")
      */
     const std::vector<Street *> &getStreets() const;
 
+    /*
+     * Returns the built-in vehicle types and the ones defined in the parsed file.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getVehicleTypes()")
+     */
+    const VehicleTypeRegistry &getVehicleTypes() const;
+
     /*
      * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getTime()")
      */
     double getTime() const;
 
-    bool contains(int pos_veh,std::map<Street*,int> kruispunten);
+    /*
+     * Returns the amount of times simulate() was called.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling getTick()")
+     */
+    unsigned int getTick() const;
+
+    /*
+     * Writes the state of the vehicles on the `count` streets in `streets`, or on all streets if `streets` is NULL,
+     * into `buffers` in one call: street by street and on every street from front to back, as far as they fit. Streets
+     * are given by their index in getStreets(). Returns the amount of vehicles on those streets, so a call with a
+     * capacity of 0 counts them.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficSimulation wasn't initialized when calling queryVehicles()")
+     * REQUIRE(streets[i] < getStreets().size(), "The street of a query doesn't exist")
+     */
+    unsigned int queryVehicles(const unsigned int* streets, unsigned int count, VehicleBuffers &buffers) const;
+
+    bool contains(int pos_veh, const std::map<Street*,int> &kruispunten) const;
 
-    int findPosition(Street * street, std::map<Street*,int> kruispunten);
+    int findPosition(Street * street, const std::map<Street*,int> &kruispunten) const;
 
     void createImage(unsigned int i, const std::string &size);
 
 private:
     Street* getStreetFromString(const std::string &name) const;
+
+    // Adds the destination of every vehicle, vehicle generator and demand
+    void collectDestinations(std::vector<unsigned int> &destinations) const;
+
+    // Replaces the road network by one with routes to the destinations, or by NULL when there are none
+    void buildNetwork(const std::vector<unsigned int> &destinations);
+
+    // Schedules the next arrival of every vehicle generator and demand
+    void scheduleSources();
+
+    // Lets every vehicle generator and demand that is due spawn its vehicles
+    void spawnVehicles();
 };
 
 
@@ -1,6 +1,19 @@
 #include <iostream>
 #include <sstream>
+#include <fstream>
+#include <ctime>
+#include <unistd.h>
 #include "TrafficSimulation.h"
+#include "renderers/ImageRenderer.h"
+#include "runners/EnsembleRunner.h"
+#include "runners/PartitionedRunner.h"
+#include "runners/BatchRunner.h"
+#include "statistics/FlowAggregator.h"
+#include "statistics/TravelStatistics.h"
+#include "statistics/QueueListener.h"
+#include "server/SimulationServer.h"
+#include "ipc/StatePublisher.h"
+#include "Variables.h"
 
 int main(int argc, char** argv) {
     int retValue = 0;
@@ -13,13 +26,32 @@ int main(int argc, char** argv) {
     else {
         std::vector<std::string> args = std::vector<std::string>(argv+1, argv+argc);
         std::string fileName = "noFile";
+        std::string manifest = "noFile";
+        bool mesoscopic = false;
+        std::string flowFile = "noFile";
+        std::string detectorFile = "noFile";
+        bool travelStatistics = false;
+        std::string queueFile = "noFile";
+        std::string entryFile = "noFile";
+        std::string serverSocket = "noFile";
+        int serverPort = 0;
+        std::string sharedState = "noFile";
         int repetitions = -1;
         bool visualize = false;
         bool graph = false;
         bool simpleGraph = false;
         bool help = false;
         bool image = false;
+        bool iniImage = false;
+        bool imageThread = false;
+        EImageFormat imageFormat = PPMImage;
         std::string imageSize = "2048";
+        int replicas = 0;
+        int workers = 0;
+        int streetThreads = 1;
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        int threads = processors > 0 ? (int) processors : 1;
+        unsigned int seed = time(NULL);
         for (long unsigned int i = 0; i < args.size(); i++) {
             if (args[i] == "-h" || args[i] == "--help") {
                 help = true;
@@ -32,13 +64,36 @@ int main(int argc, char** argv) {
                 << "\t-v\t\t\t\toutput to use together with the python visualizer" << std::endl
                 << "\t-g\t\t\t\tget a graphical representation in the terminal" << std::endl
                 << "\t-h, --help\t\t\tshow this help message and exit" << std::endl
-                << "\t-sg\t\t\t\tget a simple graphical representation in the terminal" << std::endl;
+                << "\t-sg\t\t\t\tget a simple graphical representation in the terminal" << std::endl
+                << "\t-i SIZE\t\t\t\trender an image of every fifth step with the given width" << std::endl
+                << "\t-if FORMAT\t\t\tthe format of the images: ppm (default) or png" << std::endl
+                << "\t-iw\t\t\t\twrite the images on a separate thread" << std::endl
+                << "\t-ini SIZE\t\t\texport .ini files for the external engine instead" << std::endl
+                << "\t-e REPLICAS\t\t\trun independent replicas and print their statistics" << std::endl
+                << "\t-t THREADS\t\t\tthe amount of threads for the replicas (default: all processors)" << std::endl
+                << "\t-p WORKERS\t\t\tsimulate the connected parts of the network in separate processes" << std::endl
+                << "\t-w THREADS\t\t\tsimulate the streets without crossroads on several threads" << std::endl
+                << "\t-b MANIFEST\t\t\trun every job of a manifest instead of -f and -r" << std::endl
+                << "\t-meso\t\t\t\tonly simulate the vehicles near traffic lights, bus stops and crossroads in detail" << std::endl
+                << "\t-flow FILE\t\t\texport the density, flow and speed per street segment (.csv or .bin)" << std::endl
+                << "\t-det FILE\t\t\twrite the counts of the <DETECTOR>s as a CSV table" << std::endl
+                << "\t-queue FILE\t\t\twrite the queue lengths at the traffic lights as a CSV table and report spillbacks" << std::endl
+                << "\t-entry FILE\t\t\twrite the entry queues of the generated vehicles as a CSV table" << std::endl
+                << "\t-server PATH\t\t\tkeep the simulation of -f loaded and serve commands on a Unix domain socket" << std::endl
+                << "\t-port PORT\t\t\tserve the commands on a TCP port of 127.0.0.1 instead" << std::endl
+                << "\t-shm NAME\t\t\tpublish the state of every step in the shared-memory object /NAME" << std::endl
+                << "\t-stats\t\t\t\tprint the travel times and delays of the vehicles that left the network" << std::endl
+                << "\t--seed SEED\t\t\tthe seed of the random turns, runs with the same seed are identical" << std::endl;
                 break;
             } else {
                 if (args[i] == "-f") {
                     fileName = args[i+1];
                     i++;
                     continue;
+                } else if (args[i] == "-b") {
+                    manifest = args[i+1];
+                    i++;
+                    continue;
                 } else if (args[i] == "-r") {
                     std::string repetitionsString = args[i+1];
                     if ((std::istringstream(repetitionsString) >> repetitions).fail()) {
@@ -60,23 +115,191 @@ int main(int argc, char** argv) {
                 } else if (args[i] == "-sg") {
                     simpleGraph = true;
                     continue;
-                } else if (args[i] == "-i") {
+                } else if (args[i] == "-i" || args[i] == "-ini") {
                     image = true;
+                    iniImage = args[i] == "-ini";
                     imageSize = args[i+1];
                     i++;
                     continue;
+                } else if (args[i] == "-if") {
+                    if (args[i+1] == "png") {
+                        imageFormat = PNGImage;
+                    } else if (args[i+1] != "ppm") {
+                        std::cout << "the image format must be ppm or png" << std::endl;
+                    }
+                    i++;
+                    continue;
+                } else if (args[i] == "-iw") {
+                    imageThread = true;
+                    continue;
+                } else if (args[i] == "-e" || args[i] == "-t") {
+                    int &value = args[i] == "-e" ? replicas : threads;
+                    if ((std::istringstream(args[i+1]) >> value).fail() || value < 1) {
+                        std::cout << "the amount of " << (args[i] == "-e" ? "replicas" : "threads") << " must be a positive number" << std::endl;
+                        value = args[i] == "-e" ? 0 : 1;
+                    }
+                    i++;
+                    continue;
+                } else if (args[i] == "-p") {
+                    if ((std::istringstream(args[i+1]) >> workers).fail() || workers < 1) {
+                        std::cout << "the amount of workers must be a positive number" << std::endl;
+                        workers = 0;
+                    }
+                    i++;
+                    continue;
+                } else if (args[i] == "-w") {
+                    if ((std::istringstream(args[i+1]) >> streetThreads).fail() || streetThreads < 1) {
+                        std::cout << "the amount of threads must be a positive number" << std::endl;
+                        streetThreads = 1;
+                    }
+                    i++;
+                    continue;
+                } else if (args[i] == "-det") {
+                    detectorFile = args[i+1];
+                    i++;
+                    continue;
+                } else if (args[i] == "-queue") {
+                    queueFile = args[i+1];
+                    i++;
+                    continue;
+                } else if (args[i] == "-entry") {
+                    entryFile = args[i+1];
+                    i++;
+                    continue;
+                } else if (args[i] == "-server") {
+                    serverSocket = args[i+1];
+                    i++;
+                    continue;
+                } else if (args[i] == "-port") {
+                    if ((std::istringstream(args[i+1]) >> serverPort).fail() || serverPort < 1 || serverPort > 65535) {
+                        std::cout << "the port must be a number between 1 and 65535" << std::endl;
+                        serverPort = 0;
+                    }
+                    i++;
+                    continue;
+                } else if (args[i] == "-shm") {
+                    sharedState = args[i+1];
+                    i++;
+                    continue;
+                } else if (args[i] == "-stats") {
+                    travelStatistics = true;
+                    continue;
+                } else if (args[i] == "-flow") {
+                    flowFile = args[i+1];
+                    i++;
+                    continue;
+                } else if (args[i] == "-meso") {
+                    mesoscopic = true;
+                    continue;
+                } else if (args[i] == "--seed") {
+                    if ((std::istringstream(args[i+1]) >> seed).fail()) {
+                        std::cout << "the seed must be a number" << std::endl;
+                        seed = time(NULL);
+                    }
+                    i++;
+                    continue;
                 } else {
                     std::cout << "Argument " << args[i] << " not recognized. Use \"-h\" for help." << std::endl;
                 }
             }
         }
         unsigned int imageCounter = 0;
+        unsigned int imageWidth = 0;
+        if (image && ((std::istringstream(imageSize) >> imageWidth).fail() || imageWidth == 0)) {
+            std::cout << "the image size must be a positive number" << std::endl;
+            image = false;
+        }
         TrafficSimulation sim;
-        if (fileName != "noFile" && repetitions != -1) {
+        if (manifest != "noFile") {
+            BatchRunner runner(threads, seed);
+            if (runner.parseManifest(manifest)) {
+                runner.run();
+                runner.writeOn();
+            } else {
+                retValue = -1;
+            }
+        } else if (fileName != "noFile" && (serverSocket != "noFile" || serverPort != 0)) {
+            sim.setLogStream(NULL);
+            if (sim.parseInputFile(fileName) == ImportAborted) {
+                std::cout << "the server was not started because " << fileName << " could not be imported" << std::endl;
+                retValue = -1;
+            } else {
+                if (mesoscopic) {
+                    sim.setStreetLevel(MesoscopicLevel);
+                }
+                sim.setSeed(seed);
+                SimulationServer server(sim);
+                bool listening = serverPort != 0 ? server.listenTcp(serverPort) : server.listenUnix(serverSocket);
+                if (listening) {
+                    server.run();
+                } else {
+                    std::cout << "the server could not listen on " << (serverPort != 0 ? "the given port" : serverSocket) << std::endl;
+                    retValue = -1;
+                }
+            }
+        } else if (fileName != "noFile" && repetitions != -1 && replicas > 0) {
+            sim.parseInputFile(fileName);
+            if (mesoscopic) {
+                sim.setStreetLevel(MesoscopicLevel);
+            }
+            EnsembleRunner runner(sim, replicas, threads, seed);
+            runner.run(repetitions);
+            runner.writeOn();
+        } else if (fileName != "noFile" && repetitions != -1 && workers > 0) {
+            sim.setLogStream(NULL);
             sim.parseInputFile(fileName);
-            srand(time(NULL));
+            if (mesoscopic) {
+                sim.setStreetLevel(MesoscopicLevel);
+            }
+            sim.setSeed(seed);
+            PartitionedRunner runner(sim, workers, gSharedStateCapacity);
+            if (runner.run(repetitions)) {
+                runner.writeOn();
+            } else {
+                std::cout << "the partitioned run failed" << std::endl;
+                retValue = -1;
+            }
+        } else if (fileName != "noFile" && repetitions != -1) {
+            ImageRenderer* renderer = NULL;
+            if (image && !iniImage) {
+                renderer = new ImageRenderer(imageWidth, imageFormat, imageThread);
+            }
+            FlowAggregator* flow = NULL;
+            if (flowFile != "noFile") {
+                flow = new FlowAggregator(gFlowSegmentLength, gFlowWindow);
+            }
+            sim.parseInputFile(fileName);
+            if (mesoscopic) {
+                sim.setStreetLevel(MesoscopicLevel);
+            }
+            sim.setSeed(seed);
+            sim.setThreads(streetThreads);
+            TravelStatistics* statistics = NULL;
+            if (travelStatistics) {
+                statistics = new TravelStatistics(10, 60);
+                sim.setTravelStatistics(statistics);
+            }
+            QueueAlertWriter alerts;
+            if (queueFile != "noFile") {
+                sim.setQueueListener(&alerts);
+            }
+            StatePublisher* publisher = NULL;
+            if (sharedState != "noFile") {
+                publisher = new StatePublisher(sharedState, gSharedStateCapacity);
+                if (!publisher->open(sim)) {
+                    std::cout << "the shared-memory object " << publisher->getName() << " could not be created" << std::endl;
+                    delete publisher;
+                    publisher = NULL;
+                }
+            }
             for (int k = 0; k < repetitions; k++) {
                 sim.simulate();
+                if (publisher != NULL) {
+                    publisher->publish(sim);
+                }
+                if (flow != NULL) {
+                    flow->sample(sim);
+                }
                 if (visualize) {
                     sim.visualize();
                 }
@@ -87,11 +310,62 @@ int main(int argc, char** argv) {
                     sim.writeOn();
                 } if (image) {
                     if (k % 5 == 0) {
-                        sim.createImage(imageCounter, imageSize);
+                        if (renderer != NULL) {
+                            std::ostringstream convert;
+                            convert << imageCounter+1;
+                            renderer->render(sim, "images/image" + convert.str() + renderer->getExtension());
+                        } else {
+                            sim.createImage(imageCounter, imageSize);
+                        }
                         imageCounter++;
                     }
                 }
             }
+            delete renderer;
+            delete publisher;
+            if (statistics != NULL) {
+                statistics->writeOn();
+                sim.setTravelStatistics(NULL);
+                delete statistics;
+            }
+            if (queueFile != "noFile") {
+                sim.setQueueListener(NULL);
+                std::ofstream output(queueFile.c_str());
+                if (output.is_open()) {
+                    sim.writeQueues(output);
+                } else {
+                    std::cout << "the queue lengths could not be written to " << queueFile << std::endl;
+                }
+            }
+            if (entryFile != "noFile") {
+                std::ofstream output(entryFile.c_str());
+                if (output.is_open()) {
+                    sim.writeEntryQueues(output);
+                } else {
+                    std::cout << "the entry queues could not be written to " << entryFile << std::endl;
+                }
+            }
+            if (detectorFile != "noFile") {
+                std::ofstream output(detectorFile.c_str());
+                if (output.is_open()) {
+                    sim.writeDetectors(output);
+                } else {
+                    std::cout << "the detector counts could not be written to " << detectorFile << std::endl;
+                }
+            }
+            if (flow != NULL) {
+                flow->finish();
+                bool binary = flowFile.size() >= 4 && flowFile.substr(flowFile.size() - 4) == ".bin";
+                std::ofstream output(flowFile.c_str(), binary ? std::ios::out | std::ios::binary : std::ios::out);
+                if (!output.is_open()) {
+                    std::cout << "the flow export could not be written to " << flowFile << std::endl;
+                } else if (binary) {
+                    flow->writeBinary(output);
+                } else {
+                    flow->writeCsv(output);
+                }
+                delete flow;
+            }
         } else if (!help) {
             std::cout << "both a file and the amount of repetitions must be given" <<std::endl;
         }
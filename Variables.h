@@ -5,5 +5,29 @@ const double gSimulationTime = 0.0166;
 const double gBrakeDistance = 50.0;
 const double gStopDistance = 15.0;
 const double gSlowFactor = 0.4;
+// Vehicles driving slower than this (in m/s) are counted as queued
+const double gQueueSpeed = 1.0;
+// Vehicles on a mesoscopic street are only simulated microscopically this far (in m) before a traffic light, bus stop,
+// crossroad or the end of the street
+const double gObservedDistance = 100.0;
+// Vehicles per second that can enter the observed part of a mesoscopic street
+const double gMesoscopicCapacity = 0.5;
+// Length of the street segments (in m) and of the time windows (in s) of the `-flow` export
+const double gFlowSegmentLength = 50.0;
+const double gFlowWindow = 60.0;
+// Default interval (in s) over which a detector counts the passing vehicles
+const double gDetectorInterval = 60.0;
+// A queued vehicle belongs to the queue of a traffic light if its front is this close (in m) to the light or to the rear
+// of the vehicle in front of it in the queue
+const double gQueueGap = 15.0;
+// Interval (in s) of the queue length time series of the traffic lights
+const double gQueueSampleInterval = 5.0;
+// Lane changes (MOBIL): the share of the loss of acceleration (in m/s^2) of the other vehicles a driver takes into
+// account, the gain a lane change must bring and the hardest the new follower may have to brake for it
+const double gPoliteness = 0.3;
+const double gLaneChangeThreshold = 0.2;
+const double gSafeBraking = 4.0;
+// Vehicles per frame of the `-shm` shared-memory state
+const unsigned int gSharedStateCapacity = 65536;
 
 #endif
\ No newline at end of file
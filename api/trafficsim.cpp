@@ -0,0 +1,151 @@
+// ===========================================================
+// Name         : trafficsim.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the C API of libtrafficsim, which lets other languages load, step and query a
+//                TrafficSimulation in their own process
+// ===========================================================
+
+#include <cstring>
+#include <new>
+#include <sstream>
+#include "trafficsim.h"
+#include "../TrafficSimulation.h"
+#include "../objects/Street.h"
+
+struct ts_simulation {
+    TrafficSimulation simulation;
+    std::string error;
+};
+
+namespace {
+    const Street* findStreet(const ts_simulation* simulation, unsigned int street) {
+        if (simulation == NULL || street >= simulation->simulation.getStreets().size()) {
+            return NULL;
+        }
+        return simulation->simulation.getStreets()[street];
+    }
+}
+
+unsigned int ts_api_version(void) {
+    return TS_API_VERSION;
+}
+
+ts_simulation* ts_create(void) {
+    ts_simulation* simulation = new (std::nothrow) ts_simulation();
+    if (simulation != NULL) {
+        simulation->simulation.setLogStream(NULL);
+    }
+    return simulation;
+}
+
+void ts_destroy(ts_simulation* simulation) {
+    delete simulation;
+}
+
+int ts_load(ts_simulation* simulation, const char* path) {
+    if (simulation == NULL || path == NULL) {
+        return TS_INVALID_ARGUMENT;
+    }
+    simulation->simulation.clearSimulation();
+    std::ostringstream errors;
+    EParserSuccess success = simulation->simulation.parseInputFile(path, errors);
+    simulation->error = errors.str();
+    if (success == ImportAborted) {
+        simulation->simulation.clearSimulation();
+        return TS_IMPORT_ABORTED;
+    }
+    return success == PartialImport ? TS_PARTIAL_IMPORT : TS_OK;
+}
+
+const char* ts_last_error(const ts_simulation* simulation) {
+    if (simulation == NULL) {
+        return "";
+    }
+    return simulation->error.c_str();
+}
+
+int ts_set_seed(ts_simulation* simulation, unsigned int seed) {
+    if (simulation == NULL) {
+        return TS_INVALID_ARGUMENT;
+    }
+    simulation->simulation.setSeed(seed);
+    return TS_OK;
+}
+
+int ts_step(ts_simulation* simulation, unsigned int ticks) {
+    if (simulation == NULL) {
+        return TS_INVALID_ARGUMENT;
+    }
+    for (unsigned int i = 0; i < ticks; i++) {
+        simulation->simulation.simulate();
+    }
+    return TS_OK;
+}
+
+double ts_time(const ts_simulation* simulation) {
+    if (simulation == NULL) {
+        return -1;
+    }
+    return simulation->simulation.getTime();
+}
+
+unsigned int ts_tick(const ts_simulation* simulation) {
+    if (simulation == NULL) {
+        return 0;
+    }
+    return simulation->simulation.getTick();
+}
+
+unsigned int ts_street_count(const ts_simulation* simulation) {
+    if (simulation == NULL) {
+        return 0;
+    }
+    return simulation->simulation.getStreets().size();
+}
+
+size_t ts_street_name(const ts_simulation* simulation, unsigned int street, char* buffer, size_t size) {
+    const Street* found = findStreet(simulation, street);
+    if (found == NULL) {
+        return 0;
+    }
+    const std::string &name = found->getName();
+    if (buffer != NULL && size > 0) {
+        size_t copied = name.size() < size ? name.size() : size - 1;
+        memcpy(buffer, name.data(), copied);
+        buffer[copied] = '\0';
+    }
+    return name.size();
+}
+
+double ts_street_length(const ts_simulation* simulation, unsigned int street) {
+    const Street* found = findStreet(simulation, street);
+    if (found == NULL) {
+        return -1;
+    }
+    return found->getLength();
+}
+
+unsigned int ts_vehicle_count(const ts_simulation* simulation, unsigned int street) {
+    return ts_vehicles(simulation, &street, 1, NULL, NULL, NULL, NULL, NULL, 0);
+}
+
+unsigned int ts_street_vehicles(const ts_simulation* simulation, unsigned int street, double* positions,
+                                double* speeds, unsigned int* types, unsigned int capacity) {
+    return ts_vehicles(simulation, &street, 1, positions, speeds, NULL, types, NULL, capacity);
+}
+
+unsigned int ts_vehicles(const ts_simulation* simulation, const unsigned int* streets, unsigned int count,
+                         double* positions, double* speeds, unsigned int* street_indices, unsigned int* types,
+                         unsigned int* lanes, unsigned int capacity) {
+    if (simulation == NULL) {
+        return 0;
+    }
+    for (unsigned int i = 0; streets != NULL && i < count; i++) {
+        if (findStreet(simulation, streets[i]) == NULL) {
+            return 0;
+        }
+    }
+    VehicleBuffers buffers = {positions, speeds, street_indices, types, lanes, capacity};
+    return simulation->simulation.queryVehicles(streets, count, buffers);
+}
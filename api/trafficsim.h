@@ -0,0 +1,133 @@
+/* ===========================================================
+ * Name         : trafficsim.h
+ * Author       : Laurens De Wachter & Nabil El Ouaamari
+ * Version      : 1.0
+ * Description  : This code is contains the C API of libtrafficsim, which lets other languages load, step and query a
+ *                TrafficSimulation in their own process
+ * =========================================================== */
+
+#ifndef TRAFFICSIMULATION_TRAFFICSIM_H
+#define TRAFFICSIMULATION_TRAFFICSIM_H
+
+#include <stddef.h>
+
+#if defined(__GNUC__)
+#define TS_API __attribute__((visibility("default")))
+#else
+#define TS_API
+#endif
+
+/* Raised whenever a function is added; functions are never removed or changed */
+#define TS_API_VERSION 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Unlike the C++ classes, no function checks its arguments with a contract: a wrong handle or index would abort the
+ * process of the caller. The functions return TS_INVALID_ARGUMENT, 0 or -1 instead. A handle may only be used by one
+ * thread at a time; different handles are independent.
+ */
+typedef struct ts_simulation ts_simulation;
+
+enum ts_status {
+    TS_OK = 0,
+    /* The file was loaded, but some elements were skipped, see ts_last_error() */
+    TS_PARTIAL_IMPORT = 1,
+    /* The file couldn't be loaded or isn't consistent, the simulation is empty, see ts_last_error() */
+    TS_IMPORT_ABORTED = 2,
+    TS_INVALID_ARGUMENT = 3
+};
+
+/*
+ * Returns TS_API_VERSION of the library, which can be newer than the header the caller was built with.
+ */
+TS_API unsigned int ts_api_version(void);
+
+/*
+ * Returns a new, empty simulation that doesn't log, or NULL if it couldn't be created.
+ */
+TS_API ts_simulation* ts_create(void);
+
+/*
+ * Frees the simulation and everything in it. NULL is ignored.
+ */
+TS_API void ts_destroy(ts_simulation* simulation);
+
+/*
+ * Replaces the simulation by the one in the xml-file at `path` and starts it at time 0.
+ */
+TS_API int ts_load(ts_simulation* simulation, const char* path);
+
+/*
+ * Returns the errors of the last ts_load(), an empty string if there were none. The string stays valid until the next
+ * ts_load() or ts_destroy().
+ */
+TS_API const char* ts_last_error(const ts_simulation* simulation);
+
+/*
+ * Sets the seed of the random turns and headways, see --seed.
+ */
+TS_API int ts_set_seed(ts_simulation* simulation, unsigned int seed);
+
+/*
+ * Simulates `ticks` steps.
+ */
+TS_API int ts_step(ts_simulation* simulation, unsigned int ticks);
+
+/*
+ * Returns the simulated time in s, -1 for NULL.
+ */
+TS_API double ts_time(const ts_simulation* simulation);
+
+/*
+ * Returns the amount of simulated steps.
+ */
+TS_API unsigned int ts_tick(const ts_simulation* simulation);
+
+/*
+ * Returns the amount of streets. Streets are numbered from 0 in the order of the xml-file.
+ */
+TS_API unsigned int ts_street_count(const ts_simulation* simulation);
+
+/*
+ * Copies the name of `street` into `buffer` like snprintf() and returns its length, so a name was cut off if the
+ * result isn't smaller than `size`. Returns 0 for a street that doesn't exist.
+ */
+TS_API size_t ts_street_name(const ts_simulation* simulation, unsigned int street, char* buffer, size_t size);
+
+/*
+ * Returns the length of `street` in m, -1 for a street that doesn't exist.
+ */
+TS_API double ts_street_length(const ts_simulation* simulation, unsigned int street);
+
+/*
+ * Returns the amount of vehicles on `street`.
+ */
+TS_API unsigned int ts_vehicle_count(const ts_simulation* simulation, unsigned int street);
+
+/*
+ * Writes the position (in m), speed (in m/s) and type of at most `capacity` vehicles on `street`, from front to back,
+ * into the arrays that aren't NULL. Types are numbered in the order of the vehicle types. Returns the amount of
+ * vehicles on the street, which is more than was written if the arrays were too small.
+ */
+TS_API unsigned int ts_street_vehicles(const ts_simulation* simulation, unsigned int street, double* positions,
+                                       double* speeds, unsigned int* types, unsigned int capacity);
+
+/*
+ * Writes the position (in m), speed (in m/s), street, type and lane of the vehicles on the `count` streets in
+ * `streets`, or on all streets if `streets` is NULL, into the arrays that aren't NULL, in one call: street by street and
+ * on every street from front to back, at most `capacity` vehicles. Lanes are numbered from 0 for the rightmost lane.
+ * Returns the amount of vehicles on those streets, so a call with a capacity of 0 counts them, and 0 if a street
+ * doesn't exist. Since version 2.
+ */
+TS_API unsigned int ts_vehicles(const ts_simulation* simulation, const unsigned int* streets, unsigned int count,
+                                double* positions, double* speeds, unsigned int* street_indices, unsigned int* types,
+                                unsigned int* lanes, unsigned int capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,304 @@
+// ===========================================================
+// Name         : StatePublisher.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `StatePublisher` and `StateReader` classes which share the state of every
+//                tick of a simulation with other processes through POSIX shared memory
+// ===========================================================
+
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "StatePublisher.h"
+#include "../DesignByContract.h"
+#include "../TrafficSimulation.h"
+#include "../objects/Street.h"
+#include "../objects/TrafficLight.h"
+
+namespace {
+    // "TSST"
+    const uint32_t gSharedStateMagic = 0x54535354;
+    const uint32_t gSharedStateVersion = 1;
+
+    uint64_t align(uint64_t offset) {
+        return (offset + 7) & ~(uint64_t) 7;
+    }
+
+    std::string objectName(const std::string &name) {
+        return !name.empty() && name[0] == '/' ? name : "/" + name;
+    }
+
+    // Offsets of the arrays within a frame
+    uint64_t speedsOffset(uint32_t capacity) {
+        return sizeof(SharedFrameHeader) + 8 * (uint64_t) capacity;
+    }
+
+    uint64_t streetsOffset(uint32_t capacity) {
+        return sizeof(SharedFrameHeader) + 16 * (uint64_t) capacity;
+    }
+
+    uint64_t typesOffset(uint32_t capacity) {
+        return sizeof(SharedFrameHeader) + 20 * (uint64_t) capacity;
+    }
+
+    uint64_t lanesOffset(uint32_t capacity) {
+        return sizeof(SharedFrameHeader) + 24 * (uint64_t) capacity;
+    }
+
+    uint64_t greenOffset(uint32_t capacity) {
+        return sizeof(SharedFrameHeader) + 28 * (uint64_t) capacity;
+    }
+}
+
+StatePublisher::StatePublisher(const std::string &name, unsigned int capacity) : fName(objectName(name)),
+            fCapacity(capacity), fMemory(NULL), fHeader(NULL) {
+    REQUIRE(capacity > 0, "A StatePublisher needs room for at least one vehicle");
+
+    StatePublisher::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "StatePublisher constructor did not end in an initialized state");
+}
+
+StatePublisher::~StatePublisher() {
+    if (fMemory != NULL) {
+        munmap(fMemory, fHeader->size);
+        shm_unlink(fName.c_str());
+    }
+}
+
+bool StatePublisher::properlyInitialized() const {
+    return StatePublisher::_initCheck == this;
+}
+
+bool StatePublisher::open(const TrafficSimulation &simulation) {
+    REQUIRE(properlyInitialized(), "StatePublisher wasn't initialized when calling open()");
+    REQUIRE(!isOpen(), "The StatePublisher is already open");
+
+    const std::vector<Street*> &streets = simulation.getStreets();
+    uint64_t namesSize = 0;
+    uint32_t lights = 0;
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        namesSize += streets[i]->getName().size() + 1;
+        lights += streets[i]->getTrafficLights().size();
+    }
+    SharedStateHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = gSharedStateMagic;
+    header.version = gSharedStateVersion;
+    header.capacity = fCapacity;
+    header.streets = streets.size();
+    header.lights = lights;
+    header.namesOffset = align(sizeof(SharedStateHeader));
+    header.lengthsOffset = align(header.namesOffset + namesSize);
+    header.lightStreetsOffset = header.lengthsOffset + 8 * (uint64_t) streets.size();
+    header.lightPositionsOffset = align(header.lightStreetsOffset + 4 * (uint64_t) lights);
+    header.frameOffsets[0] = header.lightPositionsOffset + 8 * (uint64_t) lights;
+    header.frameOffsets[1] = header.frameOffsets[0] + align(greenOffset(fCapacity) + lights);
+    header.size = header.frameOffsets[1] + align(greenOffset(fCapacity) + lights);
+
+    shm_unlink(fName.c_str());
+    int descriptor = shm_open(fName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (descriptor < 0) {
+        return false;
+    }
+    void* memory = MAP_FAILED;
+    if (ftruncate(descriptor, header.size) == 0) {
+        memory = mmap(NULL, header.size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    }
+    close(descriptor);
+    if (memory == MAP_FAILED) {
+        shm_unlink(fName.c_str());
+        return false;
+    }
+    fMemory = (char*) memory;
+    fHeader = (SharedStateHeader*) fMemory;
+
+    char* names = fMemory + header.namesOffset;
+    double* lengths = (double*) (fMemory + header.lengthsOffset);
+    uint32_t* lightStreets = (uint32_t*) (fMemory + header.lightStreetsOffset);
+    double* lightPositions = (double*) (fMemory + header.lightPositionsOffset);
+    unsigned int light = 0;
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        const std::string &name = streets[i]->getName();
+        memcpy(names, name.c_str(), name.size() + 1);
+        names += name.size() + 1;
+        lengths[i] = streets[i]->getLength();
+        for (unsigned int j = 0; j < streets[i]->getTrafficLights().size(); j++, light++) {
+            lightStreets[light] = i;
+            lightPositions[light] = streets[i]->getTrafficLights()[j]->getPosition();
+        }
+    }
+    // The magic goes last, so a reader never sees a half written header
+    uint32_t magic = header.magic;
+    header.magic = 0;
+    memcpy(fHeader, &header, sizeof(header));
+    __sync_synchronize();
+    fHeader->magic = magic;
+    return true;
+}
+
+bool StatePublisher::isOpen() const {
+    REQUIRE(properlyInitialized(), "StatePublisher wasn't initialized when calling isOpen()");
+
+    return fMemory != NULL;
+}
+
+void StatePublisher::publish(const TrafficSimulation &simulation) {
+    REQUIRE(properlyInitialized(), "StatePublisher wasn't initialized when calling publish()");
+    REQUIRE(isOpen(), "The StatePublisher isn't open");
+    REQUIRE(simulation.getStreets().size() == fHeader->streets, "The simulation isn't the one the StatePublisher was opened with");
+
+    unsigned long published = getPublished();
+
+    uint32_t index = 1 - fHeader->latest;
+    char* frame = fMemory + fHeader->frameOffsets[index];
+    SharedFrameHeader* header = (SharedFrameHeader*) frame;
+    header->sequence++;
+    __sync_synchronize();
+
+    header->time = simulation.getTime();
+    header->tick = simulation.getTick();
+    VehicleBuffers buffers = {(double*) (frame + sizeof(SharedFrameHeader)), (double*) (frame + speedsOffset(fCapacity)),
+                              (unsigned int*) (frame + streetsOffset(fCapacity)), (unsigned int*) (frame + typesOffset(fCapacity)),
+                              (unsigned int*) (frame + lanesOffset(fCapacity)), fCapacity};
+    header->vehicles = simulation.queryVehicles(NULL, 0, buffers);
+    header->written = header->vehicles < fCapacity ? header->vehicles : fCapacity;
+    unsigned char* green = (unsigned char*) (frame + greenOffset(fCapacity));
+    const std::vector<Street*> &streets = simulation.getStreets();
+    unsigned int light = 0;
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        const std::vector<TrafficLight*> &lights = streets[i]->getTrafficLights();
+        for (unsigned int j = 0; j < lights.size() && light < fHeader->lights; j++, light++) {
+            green[light] = lights[j]->isGreen();
+        }
+    }
+
+    __sync_synchronize();
+    header->sequence++;
+    __sync_synchronize();
+    fHeader->latest = index;
+    fHeader->published++;
+
+    ENSURE(getPublished() == published + 1, "publish() postcondition");
+}
+
+unsigned long StatePublisher::getPublished() const {
+    REQUIRE(properlyInitialized(), "StatePublisher wasn't initialized when calling getPublished()");
+
+    return fHeader == NULL ? 0 : fHeader->published;
+}
+
+const std::string &StatePublisher::getName() const {
+    REQUIRE(properlyInitialized(), "StatePublisher wasn't initialized when calling getName()");
+
+    return fName;
+}
+
+StateReader::StateReader() : fMemory(NULL), fSize(0), fHeader(NULL) {
+    StateReader::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "StateReader constructor did not end in an initialized state");
+}
+
+StateReader::~StateReader() {
+    if (fMemory != NULL) {
+        munmap((void*) fMemory, fSize);
+    }
+}
+
+bool StateReader::properlyInitialized() const {
+    return StateReader::_initCheck == this;
+}
+
+bool StateReader::attach(const std::string &name) {
+    REQUIRE(properlyInitialized(), "StateReader wasn't initialized when calling attach()");
+    REQUIRE(!isAttached(), "The StateReader is already attached");
+
+    int descriptor = shm_open(objectName(name).c_str(), O_RDONLY, 0);
+    if (descriptor < 0) {
+        return false;
+    }
+    struct stat status;
+    void* memory = MAP_FAILED;
+    if (fstat(descriptor, &status) == 0 && (size_t) status.st_size >= sizeof(SharedStateHeader)) {
+        memory = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+    }
+    close(descriptor);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+    const SharedStateHeader* header = (const SharedStateHeader*) memory;
+    if (header->magic != gSharedStateMagic || header->version != gSharedStateVersion
+            || header->size != (uint64_t) status.st_size) {
+        munmap(memory, status.st_size);
+        return false;
+    }
+    fMemory = (const char*) memory;
+    fSize = status.st_size;
+    fHeader = header;
+    return true;
+}
+
+bool StateReader::isAttached() const {
+    REQUIRE(properlyInitialized(), "StateReader wasn't initialized when calling isAttached()");
+
+    return fMemory != NULL;
+}
+
+std::vector<std::string> StateReader::getStreetNames() const {
+    REQUIRE(properlyInitialized(), "StateReader wasn't initialized when calling getStreetNames()");
+    REQUIRE(isAttached(), "The StateReader isn't attached");
+
+    std::vector<std::string> names;
+    const char* name = fMemory + fHeader->namesOffset;
+    for (unsigned int i = 0; i < fHeader->streets; i++) {
+        names.push_back(name);
+        name += names.back().size() + 1;
+    }
+    return names;
+}
+
+bool StateReader::read(SharedStateFrame &frame) const {
+    REQUIRE(properlyInitialized(), "StateReader wasn't initialized when calling read()");
+    REQUIRE(isAttached(), "The StateReader isn't attached");
+
+    if (fHeader->published == 0) {
+        return false;
+    }
+    uint32_t capacity = fHeader->capacity;
+    while (true) {
+        uint32_t index = fHeader->latest;
+        __sync_synchronize();
+        const char* data = fMemory + fHeader->frameOffsets[index & 1];
+        const SharedFrameHeader* header = (const SharedFrameHeader*) data;
+        uint32_t sequence = header->sequence;
+        __sync_synchronize();
+        if (sequence % 2 == 1) {
+            continue;
+        }
+
+        frame.time = header->time;
+        frame.tick = header->tick;
+        frame.vehicles = header->vehicles;
+        uint32_t written = header->written <= capacity ? header->written : capacity;
+        const double* positions = (const double*) (data + sizeof(SharedFrameHeader));
+        const double* speeds = (const double*) (data + speedsOffset(capacity));
+        const uint32_t* streets = (const uint32_t*) (data + streetsOffset(capacity));
+        const uint32_t* types = (const uint32_t*) (data + typesOffset(capacity));
+        const uint32_t* lanes = (const uint32_t*) (data + lanesOffset(capacity));
+        const unsigned char* green = (const unsigned char*) (data + greenOffset(capacity));
+        frame.positions.assign(positions, positions + written);
+        frame.speeds.assign(speeds, speeds + written);
+        frame.streets.assign(streets, streets + written);
+        frame.types.assign(types, types + written);
+        frame.lanes.assign(lanes, lanes + written);
+        frame.green.assign(green, green + fHeader->lights);
+
+        __sync_synchronize();
+        if (header->sequence == sequence) {
+            return true;
+        }
+    }
+}
@@ -0,0 +1,183 @@
+// ===========================================================
+// Name         : StatePublisher.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `StatePublisher` and `StateReader` classes which share the state of every
+//                tick of a simulation with other processes through POSIX shared memory
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_STATEPUBLISHER_H
+#define TRAFFICSIMULATION_STATEPUBLISHER_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+class TrafficSimulation;
+
+/*
+ * The segment starts with a SharedStateHeader. The streets and traffic lights are written once, at the offsets in the
+ * header: the names of the streets one after the other, each ended by a NUL byte, an f64 length per street, a u32
+ * street per traffic light and an f64 position per traffic light. Streets are numbered in the order of
+ * TrafficSimulation::getStreets() and traffic lights street by street.
+ *
+ * Every tick is written into one of two frames, the one that wasn't published last, so readers can copy the latest
+ * frame while the next one is written. A frame is a SharedFrameHeader followed by arrays of `capacity` elements: f64
+ * positions, f64 speeds, u32 streets, u32 types and u32 lanes, followed by a u8 per traffic light that is 1 when it is
+ * green. The sequence of a frame is odd while it is written: a reader copies a frame with an even sequence and tries
+ * again if the sequence changed in the meantime.
+ */
+struct SharedStateHeader {
+    uint32_t magic;
+    uint32_t version;
+    // Vehicles per frame
+    uint32_t capacity;
+    uint32_t streets;
+    uint32_t lights;
+    // Frame that was published last
+    volatile uint32_t latest;
+    // Amount of published frames, 0 until the first one
+    volatile uint64_t published;
+    uint64_t namesOffset;
+    uint64_t lengthsOffset;
+    uint64_t lightStreetsOffset;
+    uint64_t lightPositionsOffset;
+    uint64_t frameOffsets[2];
+    // Size of the whole segment
+    uint64_t size;
+};
+
+struct SharedFrameHeader {
+    volatile uint32_t sequence;
+    uint32_t tick;
+    double time;
+    // Vehicles on the network, only the first `capacity` of them are in the frame
+    uint32_t vehicles;
+    uint32_t written;
+};
+
+// Copy of a frame in the memory of the reader
+struct SharedStateFrame {
+    double time;
+    unsigned int tick;
+    unsigned int vehicles;
+    std::vector<double> positions;
+    std::vector<double> speeds;
+    std::vector<unsigned int> streets;
+    std::vector<unsigned int> types;
+    std::vector<unsigned int> lanes;
+    std::vector<unsigned char> green;
+};
+
+class StatePublisher {
+    StatePublisher* _initCheck;
+
+    std::string fName;
+    unsigned int fCapacity;
+    char* fMemory;
+    SharedStateHeader* fHeader;
+
+public:
+    /*
+     * A publisher for the POSIX shared-memory object `name` ("/name", a slash is added if it is missing) with room for
+     * `capacity` vehicles per frame.
+     *
+     * REQUIRE(capacity > 0, "A StatePublisher needs room for at least one vehicle")
+     *
+     * ENSURE(properlyInitialized(), "StatePublisher constructor did not end in an initialized state")
+     */
+    StatePublisher(const std::string &name, unsigned int capacity);
+
+    /*
+     * Unmaps and removes the shared-memory object; readers that are attached keep their mapping.
+     */
+    virtual ~StatePublisher();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Creates the shared-memory object, replacing an old one with the same name, and writes the streets and traffic
+     * lights of `simulation` into it. Returns whether it succeeded.
+     *
+     * REQUIRE(properlyInitialized(), "StatePublisher wasn't initialized when calling open()")
+     * REQUIRE(!isOpen(), "The StatePublisher is already open")
+     */
+    bool open(const TrafficSimulation &simulation);
+
+    /*
+     * REQUIRE(properlyInitialized(), "StatePublisher wasn't initialized when calling isOpen()")
+     */
+    bool isOpen() const;
+
+    /*
+     * Writes the time, vehicles and traffic lights of `simulation` into the frame readers aren't reading and publishes
+     * it. The vehicles are copied straight into the shared memory with TrafficSimulation::queryVehicles().
+     *
+     * REQUIRE(properlyInitialized(), "StatePublisher wasn't initialized when calling publish()")
+     * REQUIRE(isOpen(), "The StatePublisher isn't open")
+     * REQUIRE(simulation.getStreets().size() == fHeader->streets, "The simulation isn't the one the StatePublisher was opened with")
+     *
+     * ENSURE(getPublished() == published + 1, "publish() postcondition")
+     */
+    void publish(const TrafficSimulation &simulation);
+
+    /*
+     * REQUIRE(properlyInitialized(), "StatePublisher wasn't initialized when calling getPublished()")
+     */
+    unsigned long getPublished() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "StatePublisher wasn't initialized when calling getName()")
+     */
+    const std::string &getName() const;
+};
+
+class StateReader {
+    StateReader* _initCheck;
+
+    const char* fMemory;
+    size_t fSize;
+    const SharedStateHeader* fHeader;
+
+public:
+    /*
+     * ENSURE(properlyInitialized(), "StateReader constructor did not end in an initialized state")
+     */
+    StateReader();
+
+    virtual ~StateReader();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Maps the shared-memory object `name` of a StatePublisher read-only. Returns whether it exists and has the layout
+     * of this version.
+     *
+     * REQUIRE(properlyInitialized(), "StateReader wasn't initialized when calling attach()")
+     * REQUIRE(!isAttached(), "The StateReader is already attached")
+     */
+    bool attach(const std::string &name);
+
+    /*
+     * REQUIRE(properlyInitialized(), "StateReader wasn't initialized when calling isAttached()")
+     */
+    bool isAttached() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "StateReader wasn't initialized when calling getStreetNames()")
+     * REQUIRE(isAttached(), "The StateReader isn't attached")
+     */
+    std::vector<std::string> getStreetNames() const;
+
+    /*
+     * Copies the latest frame into `frame`. Returns false if nothing was published yet.
+     *
+     * REQUIRE(properlyInitialized(), "StateReader wasn't initialized when calling read()")
+     * REQUIRE(isAttached(), "The StateReader isn't attached")
+     */
+    bool read(SharedStateFrame &frame) const;
+};
+
+
+#endif
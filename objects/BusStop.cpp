@@ -7,8 +7,9 @@
 
 #include "BusStop.h"
 #include "../DesignByContract.h"
+#include "../StringInterner.h"
 
-BusStop::BusStop(const std::string &street, int position, int waitTime) : fStreet(street), fPosition(position), fWaitTime(waitTime) {
+BusStop::BusStop(const std::string &street, int position, int waitTime) : fStreet(StringInterner::streetNames().intern(street)), fPosition(position), fWaitTime(waitTime) {
     BusStop::_initCheck = this;
 
     ENSURE(properlyInitialized(), "BusStop constructor did not end in an initialized state");
@@ -20,9 +21,33 @@ bool BusStop::properlyInitialized() const {
     return BusStop::_initCheck == this;
 }
 
+BusStop *BusStop::clone(const std::map<const Vehicle*, Vehicle*> &vehicles) const {
+    REQUIRE(properlyInitialized(), "BusStop wasn't initialized when calling clone()");
+
+    BusStop* copy = new BusStop(*this);
+    copy->_initCheck = copy;
+    copy->arrivedBusses.clear();
+    for (unsigned int i = 0; i < arrivedBusses.size(); i++) {
+        std::map<const Vehicle*, Vehicle*>::const_iterator it = vehicles.find(arrivedBusses[i]);
+        if (it != vehicles.end()) {
+            copy->arrivedBusses.push_back(it->second);
+        }
+    }
+
+    ENSURE(copy->properlyInitialized(), "clone() postcondition");
+
+    return copy;
+}
+
 const std::string &BusStop::getStreet() const {
     REQUIRE(properlyInitialized(), "BusStop wasn't initialized when calling getStreet()");
 
+    return StringInterner::streetNames().getString(fStreet);
+}
+
+unsigned int BusStop::getStreetId() const {
+    REQUIRE(properlyInitialized(), "BusStop wasn't initialized when calling getStreetId()");
+
     return fStreet;
 }
 
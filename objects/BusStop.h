@@ -10,12 +10,13 @@
 
 #include <iostream>
 #include <vector>
+#include <map>
 #include "Vehicle.h"
 
 class BusStop {
     BusStop* _initCheck;
 
-    std::string fStreet;
+    unsigned int fStreet;
     int fPosition;
     int fWaitTime;
     std::vector<Vehicle*> arrivedBusses;
@@ -30,11 +31,26 @@ public:
 
     bool properlyInitialized() const;
 
+    /*
+     * Returns a copy of this bus stop that is owned by the caller, the arrived busses are replaced by their copies in
+     * `vehicles`. Busses that are not in `vehicles` have left the street and are dropped.
+     *
+     * REQUIRE(properlyInitialized(), "BusStop wasn't initialized when calling clone()")
+     *
+     * ENSURE(copy->properlyInitialized(), "clone() postcondition")
+     */
+    BusStop* clone(const std::map<const Vehicle*, Vehicle*> &vehicles) const;
+
     /*
      * REQUIRE(properlyInitialized(), "BusStop wasn't initialized when calling getStreet()")
      */
     const std::string &getStreet() const;
 
+    /*
+     * REQUIRE(properlyInitialized(), "BusStop wasn't initialized when calling getStreetId()")
+     */
+    unsigned int getStreetId() const;
+
     /*
      * REQUIRE(this->properlyInitialized(), "BusStop wasn't initialized when calling getPosition")
      */
@@ -0,0 +1,174 @@
+// ===========================================================
+// Name         : Demand.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `Demand` class, one cell of an origin-destination matrix: the vehicles per
+//                hour that enter the network on one street and want to leave it at the end of another
+// ===========================================================
+
+#include <algorithm>
+#include "Demand.h"
+#include "VehicleType.h"
+#include "../DesignByContract.h"
+#include "../StringInterner.h"
+
+Demand::Demand(const std::string &origin, const std::string &destination) :
+            fOrigin(StringInterner::streetNames().intern(origin)), fDestination(StringInterner::streetNames().intern(destination)),
+            fNextArrival(-1), fArrivals(0) {
+    Demand::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "Demand constructor did not end in an initialized state");
+}
+
+Demand::~Demand() {}
+
+bool Demand::properlyInitialized() const {
+    return Demand::_initCheck == this;
+}
+
+Demand *Demand::clone() const {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling clone()");
+
+    Demand* copy = new Demand(*this);
+    copy->_initCheck = copy;
+
+    ENSURE(copy->properlyInitialized(), "clone() postcondition");
+
+    return copy;
+}
+
+double Demand::expectedArrival(double time, double vehicles) const {
+    for (unsigned int i = 0; i < fPeriods.size(); i++) {
+        const DemandPeriod &period = fPeriods[i];
+        if (period.end <= time || period.rate <= 0) {
+            continue;
+        }
+        double from = std::max(time, period.start);
+        double expected = period.rate * (period.end - from) / 3600.0;
+        if (expected >= vehicles) {
+            return from + vehicles * 3600.0 / period.rate;
+        }
+        vehicles -= expected;
+    }
+    return -1;
+}
+
+void Demand::addPeriod(double start, double end, double rate) {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling addPeriod()");
+    REQUIRE(start >= 0 && end > start, "The period must end after it starts");
+    REQUIRE(rate >= 0, "The rate of a period can't be negative");
+    REQUIRE(rate == 0 || end + 3600.0 / rate > end, "The arrivals of a period must be apart in time");
+    REQUIRE(fPeriods.empty() || start >= fPeriods.back().end, "The periods must be added in order");
+
+    DemandPeriod period;
+    period.start = start;
+    period.end = end;
+    period.rate = rate;
+    fPeriods.push_back(period);
+    if (fArrivals == 0) {
+        fNextArrival = expectedArrival(0, 1);
+    }
+
+    ENSURE(fPeriods.back().rate == rate, "addPeriod() postcondition");
+}
+
+void Demand::addType(unsigned int type, double share) {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling addType()");
+    REQUIRE(share > 0, "The share of a type must be greater than 0");
+
+    fTypes.push_back(type);
+    fShares.push_back(share);
+    fCredits.push_back(0);
+
+    ENSURE(fTypes.back() == type, "addType() postcondition");
+}
+
+const std::string &Demand::getOrigin() const {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getOrigin()");
+
+    return StringInterner::streetNames().getString(fOrigin);
+}
+
+unsigned int Demand::getOriginId() const {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getOriginId()");
+
+    return fOrigin;
+}
+
+const std::string &Demand::getDestination() const {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getDestination()");
+
+    return StringInterner::streetNames().getString(fDestination);
+}
+
+const std::vector<DemandPeriod> &Demand::getPeriods() const {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getPeriods()");
+
+    return fPeriods;
+}
+
+const std::vector<unsigned int> &Demand::getTypes() const {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getTypes()");
+
+    return fTypes;
+}
+
+const std::vector<double> &Demand::getShares() const {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getShares()");
+
+    return fShares;
+}
+
+double Demand::getRate(double time) const {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getRate()");
+
+    for (unsigned int i = 0; i < fPeriods.size(); i++) {
+        if (fPeriods[i].start <= time && time < fPeriods[i].end) {
+            return fPeriods[i].rate;
+        }
+    }
+    return 0;
+}
+
+double Demand::getNextArrival() const {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getNextArrival()");
+
+    return fNextArrival;
+}
+
+unsigned int Demand::getArrivals() const {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getArrivals()");
+
+    return fArrivals;
+}
+
+unsigned int Demand::arrive() {
+    REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling arrive()");
+    REQUIRE(fNextArrival >= 0, "No vehicle arrives anymore");
+
+    unsigned int startArrivals = fArrivals;
+
+    unsigned int type = CarVehicle;
+    if (!fTypes.empty()) {
+        double total = 0;
+        for (unsigned int i = 0; i < fShares.size(); i++) {
+            total += fShares[i];
+        }
+        unsigned int chosen = 0;
+        for (unsigned int i = 0; i < fCredits.size(); i++) {
+            fCredits[i] += fShares[i] / total;
+            if (fCredits[i] > fCredits[chosen]) {
+                chosen = i;
+            }
+        }
+        fCredits[chosen] -= 1;
+        type = fTypes[chosen];
+    }
+
+    fNextArrival = expectedArrival(fNextArrival, 1);
+    fArrivals++;
+
+    ENSURE(fArrivals == startArrivals + 1, "arrive() postcondition");
+
+    return type;
+}
@@ -0,0 +1,150 @@
+// ===========================================================
+// Name         : Demand.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `Demand` class, one cell of an origin-destination matrix: the vehicles per
+//                hour that enter the network on one street and want to leave it at the end of another
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_DEMAND_H
+#define TRAFFICSIMULATION_DEMAND_H
+
+#include <iostream>
+#include <vector>
+
+struct DemandPeriod {
+    // Start and end (in s) of the period
+    double start;
+    double end;
+    // Vehicles per hour during the period
+    double rate;
+};
+
+/*
+ * The vehicles arrive at the times where the expected amount of vehicles since the previous arrival, the integral of the
+ * rate, reaches one. The types are handed out in proportion to their shares with a smooth weighted round robin, so with
+ * shares of 0.75 and 0.25 every fourth vehicle gets the second type.
+ */
+class Demand {
+    Demand* _initCheck;
+
+    unsigned int fOrigin;
+    unsigned int fDestination;
+    // Sorted on their start and not overlapping
+    std::vector<DemandPeriod> fPeriods;
+    std::vector<unsigned int> fTypes;
+    std::vector<double> fShares;
+    // State of the round robin, one credit per type
+    std::vector<double> fCredits;
+    // Time (in s) of the next arrival, -1 if no vehicle arrives anymore
+    double fNextArrival;
+    unsigned int fArrivals;
+
+    // Returns the time at which `vehicles` vehicles are expected to have arrived since `time`, -1 if never
+    double expectedArrival(double time, double vehicles) const;
+
+public:
+    /*
+     * ENSURE(properlyInitialized(), "Demand constructor did not end in an initialized state")
+     */
+    Demand(const std::string &origin, const std::string &destination);
+
+    virtual ~Demand();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Returns a copy of this demand that is owned by the caller.
+     *
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling clone()")
+     *
+     * ENSURE(copy->properlyInitialized(), "clone() postcondition")
+     */
+    Demand* clone() const;
+
+    /*
+     * Adds a period in which `rate` vehicles per hour arrive, after the periods added before.
+     *
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling addPeriod()")
+     * REQUIRE(start >= 0 && end > start, "The period must end after it starts")
+     * REQUIRE(rate >= 0, "The rate of a period can't be negative")
+     * REQUIRE(rate == 0 || end + 3600.0 / rate > end, "The arrivals of a period must be apart in time")
+     * REQUIRE(getPeriods().empty() || start >= getPeriods().back().end, "The periods must be added in order")
+     *
+     * ENSURE(getPeriods().back().rate == rate, "addPeriod() postcondition")
+     */
+    void addPeriod(double start, double end, double rate);
+
+    /*
+     * Adds a type of the vehicles, index `type` in the registry of the simulation. The shares don't have to add up to
+     * one. Without types, every vehicle is a car.
+     *
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling addType()")
+     * REQUIRE(share > 0, "The share of a type must be greater than 0")
+     *
+     * ENSURE(getTypes().back() == type, "addType() postcondition")
+     */
+    void addType(unsigned int type, double share);
+
+    /*
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getOrigin()")
+     */
+    const std::string &getOrigin() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getOriginId()")
+     */
+    unsigned int getOriginId() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getDestination()")
+     */
+    const std::string &getDestination() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getPeriods()")
+     */
+    const std::vector<DemandPeriod> &getPeriods() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getTypes()")
+     */
+    const std::vector<unsigned int> &getTypes() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getShares()")
+     */
+    const std::vector<double> &getShares() const;
+
+    /*
+     * Returns the vehicles per hour at `time`.
+     *
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getRate()")
+     */
+    double getRate(double time) const;
+
+    /*
+     * Returns the time (in s) of the next arrival, -1 if no vehicle arrives anymore.
+     *
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getNextArrival()")
+     */
+    double getNextArrival() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling getArrivals()")
+     */
+    unsigned int getArrivals() const;
+
+    /*
+     * Returns the type of the vehicle that arrives at getNextArrival() and moves on to the arrival after it.
+     *
+     * REQUIRE(properlyInitialized(), "Demand wasn't initialized when calling arrive()")
+     * REQUIRE(getNextArrival() >= 0, "No vehicle arrives anymore")
+     *
+     * ENSURE(getArrivals() == startArrivals + 1, "arrive() postcondition")
+     */
+    unsigned int arrive();
+};
+
+
+#endif
@@ -0,0 +1,147 @@
+// ===========================================================
+// Name         : Detector.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `Detector` class, a virtual induction loop that counts the vehicles
+//                passing a position on a street
+// ===========================================================
+
+#include <cmath>
+#include <algorithm>
+#include "Detector.h"
+#include "Vehicle.h"
+#include "../DesignByContract.h"
+#include "../StringInterner.h"
+#include "../Variables.h"
+
+Detector::Detector(const std::string &street, int position, double interval) : fStreet(StringInterner::streetNames().intern(street)),
+            fPosition(position), fTicks(0) {
+    REQUIRE(interval > 0, "The interval of a detector must be greater than 0");
+
+    fIntervalTicks = std::max(1, (int) floor(interval / gSimulationTime + 0.5));
+    Detector::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "Detector constructor did not end in an initialized state");
+}
+
+Detector::~Detector() {}
+
+bool Detector::properlyInitialized() const {
+    return Detector::_initCheck == this;
+}
+
+Detector *Detector::clone() const {
+    REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling clone()");
+
+    Detector* copy = new Detector(*this);
+    copy->_initCheck = copy;
+
+    ENSURE(copy->properlyInitialized(), "clone() postcondition");
+
+    return copy;
+}
+
+const std::string &Detector::getStreet() const {
+    REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling getStreet()");
+
+    return StringInterner::streetNames().getString(fStreet);
+}
+
+unsigned int Detector::getStreetId() const {
+    REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling getStreetId()");
+
+    return fStreet;
+}
+
+int Detector::getPosition() const {
+    REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling getPosition()");
+
+    return fPosition;
+}
+
+double Detector::getInterval() const {
+    REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling getInterval()");
+
+    return fIntervalTicks * gSimulationTime;
+}
+
+void Detector::measure(const std::vector<Vehicle*> &vehicles, unsigned int lanes) {
+    REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling measure()");
+    REQUIRE(lanes > 0, "The street must have a lane");
+
+    if (fTicks == 0) {
+        fCounts.push_back(0);
+        fOccupiedTimes.push_back(0);
+    }
+
+    // Binary search for the first vehicle that hasn't reached the detector yet
+    unsigned int low = 0;
+    unsigned int high = vehicles.size();
+    while (low < high) {
+        unsigned int middle = (low + high) / 2;
+        if (vehicles[middle]->getPosition() >= fPosition) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    // The vehicles that passed during this tick are the last ones of their lane in front of the detector
+    std::vector<bool> passing(lanes, true);
+    std::vector<bool> nearest(lanes, true);
+    unsigned int passingLanes = lanes;
+    bool occupied = false;
+    for (unsigned int i = low; i > 0 && passingLanes > 0; i--) {
+        Vehicle* vehicle = vehicles[i-1];
+        unsigned int lane = vehicle->getLane();
+        if (!passing[lane]) {
+            continue;
+        }
+        if (nearest[lane]) {
+            nearest[lane] = false;
+            occupied = occupied || vehicle->getPosition() - vehicle->getLength() < fPosition;
+        }
+        if (vehicle->getPreviousPosition() < fPosition) {
+            fCounts.back()++;
+        } else {
+            passing[lane] = false;
+            passingLanes--;
+        }
+    }
+    if (occupied) {
+        fOccupiedTimes.back() += gSimulationTime;
+    }
+
+    fTicks++;
+    if (fTicks == fIntervalTicks) {
+        fTicks = 0;
+    }
+}
+
+const std::vector<unsigned int> &Detector::getCounts() const {
+    REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling getCounts()");
+
+    return fCounts;
+}
+
+double Detector::getOccupancy(unsigned int interval) const {
+    REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling getOccupancy()");
+    REQUIRE(interval < getCounts().size(), "The interval wasn't measured");
+
+    unsigned int ticks = interval + 1 == fCounts.size() && fTicks > 0 ? fTicks : fIntervalTicks;
+    return fOccupiedTimes[interval] / (ticks * gSimulationTime);
+}
+
+void Detector::writeOn(std::ostream &onstream) const {
+    REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling writeOn()");
+    REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeOn()");
+
+    double interval = getInterval();
+    for (unsigned int i = 0; i < fCounts.size(); i++) {
+        double end = i + 1 == fCounts.size() && fTicks > 0 ? (i * fIntervalTicks + fTicks) * gSimulationTime : (i + 1) * interval;
+        onstream << getStreet() << "," << fPosition << "," << i * interval << "," << end << "," << fCounts[i] << ","
+                 << getOccupancy(i) << "\n";
+    }
+
+    ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeOn()");
+}
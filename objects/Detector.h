@@ -0,0 +1,111 @@
+// ===========================================================
+// Name         : Detector.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `Detector` class, a virtual induction loop that counts the vehicles
+//                passing a position on a street
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_DETECTOR_H
+#define TRAFFICSIMULATION_DETECTOR_H
+
+#include <iostream>
+#include <vector>
+
+class Vehicle;
+
+class Detector {
+    Detector* _initCheck;
+
+    unsigned int fStreet;
+    int fPosition;
+    unsigned int fIntervalTicks;
+
+    // Vehicles that passed the detector and the time (in s) it was occupied, per interval
+    std::vector<unsigned int> fCounts;
+    std::vector<double> fOccupiedTimes;
+    // Ticks measured in the last interval
+    unsigned int fTicks;
+
+public:
+    /*
+     * The interval (in s) is rounded to a whole amount of ticks.
+     *
+     * REQUIRE(interval > 0, "The interval of a detector must be greater than 0")
+     *
+     * ENSURE(properlyInitialized(), "Detector constructor did not end in an initialized state")
+     */
+    Detector(const std::string &street, int position, double interval);
+
+    virtual ~Detector();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Returns a copy of this detector that is owned by the caller.
+     *
+     * REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling clone()")
+     *
+     * ENSURE(copy->properlyInitialized(), "clone() postcondition")
+     */
+    Detector* clone() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling getStreet()")
+     */
+    const std::string &getStreet() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling getStreetId()")
+     */
+    unsigned int getStreetId() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling getPosition()")
+     */
+    int getPosition() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling getInterval()")
+     */
+    double getInterval() const;
+
+    /*
+     * Measures one tick. `vehicles` are the vehicles on the street of the detector after they drove, sorted from
+     * front to back, so only the vehicles right in front of the detector have to be checked. The vehicles can drive on
+     * `lanes` lanes, and every lane is checked until its first vehicle that was already past the detector.
+     *
+     * REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling measure()")
+     * REQUIRE(lanes > 0, "The street must have a lane")
+     */
+    void measure(const std::vector<Vehicle*> &vehicles, unsigned int lanes = 1);
+
+    /*
+     * Returns the vehicles that passed the detector per interval, the last interval may be incomplete.
+     *
+     * REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling getCounts()")
+     */
+    const std::vector<unsigned int> &getCounts() const;
+
+    /*
+     * Returns the fraction of the time a vehicle stood on the detector, per interval.
+     *
+     * REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling getOccupancy()")
+     * REQUIRE(interval < getCounts().size(), "The interval wasn't measured")
+     */
+    double getOccupancy(unsigned int interval) const;
+
+    /*
+     * Writes one line per interval with the street, the position, the start and end of the interval, the count and
+     * the occupancy, separated by commas.
+     *
+     * REQUIRE(properlyInitialized(), "Detector wasn't initialized when calling writeOn()")
+     * REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeOn()")
+     *
+     * ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeOn()")
+     */
+    void writeOn(std::ostream &onstream) const;
+};
+
+
+#endif
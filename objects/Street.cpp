@@ -12,16 +12,18 @@
 #include "TrafficLight.h"
 #include "VehicleGenerator.h"
 #include "BusStop.h"
+#include "Detector.h"
+#include "../statistics/TravelStatistics.h"
+#include "../statistics/QueueListener.h"
 #include "Vehicle.h"
-#include "vehicles/Car.h"
-#include "vehicles/Bus.h"
-#include "vehicles/FireEngine.h"
-#include "vehicles/Ambulance.h"
-#include "vehicles/PoliceCar.h"
 #include "../Variables.h"
+#include "../StringInterner.h"
 
-Street::Street(const std::string &name, int length) : fName(name), fLength(length) {
+Street::Street(const std::string &name, int length) : fName(name), fId(StringInterner::streetNames().intern(name)), fIndex(0), fLength(length),
+            fLevel(MicroscopicLevel), fLanes(1), fChangeLeft(false), fEntryHeadway(0), fExitedVehicles(0), fGeneratedVehicles(0), fMaxEntryQueue(0), fEntryQueueTime(0), fFinishedVehicles(0), fFinishedTravelTime(0) {
     Street::fVehicleGenerator = NULL;
+    Street::fTravelStatistics = NULL;
+    Street::fQueueListener = NULL;
     Street::_initCheck = this;
 
     ENSURE(properlyInitialized(), "Street constructor did not end in an initialized state");
@@ -37,6 +39,12 @@ Street::~Street() {
     for (unsigned int i = 0; i < fBusStops.size(); i++) {
         delete Street::fBusStops[i];
     }
+    for (unsigned int i = 0; i < fDetectors.size(); i++) {
+        delete Street::fDetectors[i];
+    }
+    for (unsigned int i = 0; i < fEntryQueue.size(); i++) {
+        delete Street::fEntryQueue[i];
+    }
     delete Street::fVehicleGenerator;
 }
 
@@ -44,9 +52,63 @@ bool Street::properlyInitialized() const {
     return Street::_initCheck == this;
 }
 
+Street *Street::clone() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling clone()");
+
+    Street* copy = new Street(fName, fLength);
+    for (unsigned int i = 0; i < fTrafficLights.size(); i++) {
+        copy->fTrafficLights.push_back(fTrafficLights[i]->clone());
+    }
+    std::map<const Vehicle*, Vehicle*> vehicles;
+    for (unsigned int i = 0; i < fVehicles.size(); i++) {
+        Vehicle* vehicle = fVehicles[i]->clone();
+        vehicles[fVehicles[i]] = vehicle;
+        copy->fVehicles.push_back(vehicle);
+    }
+    for (unsigned int i = 0; i < fBusStops.size(); i++) {
+        copy->fBusStops.push_back(fBusStops[i]->clone(vehicles));
+    }
+    for (unsigned int i = 0; i < fDetectors.size(); i++) {
+        copy->fDetectors.push_back(fDetectors[i]->clone());
+    }
+    for (unsigned int i = 0; i < fEntryQueue.size(); i++) {
+        copy->fEntryQueue.push_back(fEntryQueue[i]->clone());
+    }
+    if (fVehicleGenerator != NULL) {
+        copy->fVehicleGenerator = fVehicleGenerator->clone();
+    }
+    copy->fIndex = fIndex;
+    copy->fLevel = fLevel;
+    copy->fLanes = fLanes;
+    copy->fChangeLeft = fChangeLeft;
+    copy->fEntryHeadway = fEntryHeadway;
+    copy->fExitedVehicles = fExitedVehicles;
+    copy->fGeneratedVehicles = fGeneratedVehicles;
+    copy->fMaxEntryQueue = fMaxEntryQueue;
+    copy->fEntryQueueTime = fEntryQueueTime;
+    copy->fFinishedVehicles = fFinishedVehicles;
+    copy->fFinishedTravelTime = fFinishedTravelTime;
+
+    ENSURE(copy->properlyInitialized(), "clone() postcondition");
+    ENSURE(copy->getVehicles().size() == fVehicles.size(), "clone() postcondition");
+
+    return copy;
+}
+
+void Street::setVehicleTypes(const VehicleTypeRegistry &types) {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling setVehicleTypes()");
+
+    for (unsigned int i = 0; i < fVehicles.size(); i++) {
+        fVehicles[i]->setVehicleTypes(types);
+    }
+    for (unsigned int i = 0; i < fEntryQueue.size(); i++) {
+        fEntryQueue[i]->setVehicleTypes(types);
+    }
+}
+
 void Street::addTrafficLight(TrafficLight *t) {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling addTrafficLight()");
-    REQUIRE(t->getStreet() == fName, "The traffic light did not have the same name as the street it was added to");
+    REQUIRE(t->getStreetId() == fId, "The traffic light did not have the same name as the street it was added to");
     REQUIRE(t->getPosition() <= fLength, "The traffic light stands of the road");
     REQUIRE(t->getPosition() >= 0, "The traffic light stands of the road");
 
@@ -58,9 +120,10 @@ void Street::addTrafficLight(TrafficLight *t) {
 
 void Street::addVehicle(Vehicle *v) {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling addVehicle()");
-    REQUIRE(v->getStreet() == fName, "The vehicle did not have the same name as the street it was added to");
+    REQUIRE(v->getStreetId() == fId, "The vehicle did not have the same name as the street it was added to");
     REQUIRE(v->getPosition() <= fLength, "The vehicle stands of the road");
     REQUIRE(v->getPosition() >= 0, "The vehicle stands of the road");
+    REQUIRE(v->getLane() < fLanes, "The vehicle drives on a lane that doesn't exist");
 
     unsigned int vehiclesSize = fVehicles.size();
     fVehicles.push_back(v);
@@ -70,7 +133,7 @@ void Street::addVehicle(Vehicle *v) {
 
 void Street::addBusStop(BusStop *b) {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling addBusStop()");
-    REQUIRE(b->getStreet() == fName, "The traffic light did not have the same name as the street it was added to");
+    REQUIRE(b->getStreetId() == fId, "The traffic light did not have the same name as the street it was added to");
     REQUIRE(b->getPosition() <= fLength, "The traffic light stands of the road");
     REQUIRE(b->getPosition() >= 0, "The traffic light stands of the road");
 
@@ -80,6 +143,18 @@ void Street::addBusStop(BusStop *b) {
     ENSURE(fBusStops.size() == busStopsSize+1, "addBusStop() postcondition");
 }
 
+void Street::addDetector(Detector *d) {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling addDetector()");
+    REQUIRE(d->getStreetId() == fId, "The detector did not have the same name as the street it was added to");
+    REQUIRE(d->getPosition() < fLength, "The detector lies of the road");
+    REQUIRE(d->getPosition() >= 0, "The detector lies of the road");
+
+    unsigned int detectorsSize = fDetectors.size();
+    fDetectors.push_back(d);
+
+    ENSURE(fDetectors.size() == detectorsSize+1, "addDetector() postcondition");
+}
+
 void Street::addCrossroad(Street* crossingStreet, unsigned int position) {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling addCrossroad()");
 
@@ -92,34 +167,94 @@ void Street::addCrossroad(Street* crossingStreet, unsigned int position) {
 
 void Street::setVehicleGenerator(VehicleGenerator *vg) {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling addVehicleGenerator()");
-    REQUIRE(vg->getStreet() == fName, "The generator did not have the same name as the street it was added to");
+    REQUIRE(vg->getStreetId() == fId, "The generator did not have the same name as the street it was added to");
 
     fVehicleGenerator = vg;
 
     ENSURE(fVehicleGenerator == vg, "addVehicleGenerator() postcondition");
 }
 
+void Street::setLevel(EStreetLevel level) {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling setLevel()");
+
+    fLevel = level;
+
+    ENSURE(getLevel() == level, "setLevel() postcondition");
+}
+
+void Street::setLanes(unsigned int lanes) {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling setLanes()");
+    REQUIRE(lanes > 0, "A street needs at least one lane");
+    for (unsigned int i = 0; i < fVehicles.size(); i++) {
+        REQUIRE(fVehicles[i]->getLane() < lanes, "A vehicle drives on a lane that doesn't exist");
+    }
+
+    fLanes = lanes;
+
+    ENSURE(getLanes() == lanes, "setLanes() postcondition");
+}
+
+void Street::setTravelStatistics(TravelStatistics *statistics) {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling setTravelStatistics()");
+
+    fTravelStatistics = statistics;
+
+    ENSURE(fTravelStatistics == statistics, "setTravelStatistics() postcondition");
+}
+
+void Street::setQueueListener(QueueListener *listener) {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling setQueueListener()");
+
+    fQueueListener = listener;
+
+    ENSURE(fQueueListener == listener, "setQueueListener() postcondition");
+}
+
 void Street::removeVehicle() {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling removeVehicle()");
 
     unsigned int vehiclesSize = fVehicles.size();
-    delete fVehicles[0];
+    finishVehicle(fVehicles[0]);
     fVehicles.erase(fVehicles.begin());
 
     ENSURE(fVehicles.size() == vehiclesSize-1, "removeVehicle() postcondition");
 }
 
+void Street::finishVehicle(Vehicle *vehicle) {
+    fExitedVehicles++;
+    fFinishedVehicles++;
+    fFinishedTravelTime += vehicle->getTravelTime();
+    if (fTravelStatistics != NULL) {
+        fTravelStatistics->record(*vehicle);
+    }
+    delete vehicle;
+}
+
 void Street::removeVehicleAddress(Vehicle * veh,int index) {
+    fExitedVehicles++;
     delete fVehicles[index];
 
     for(int i = 0; i<(int)fVehicles.size();i++){
         if (fVehicles[i] == veh){
             fVehicles.erase(fVehicles.begin()+index);
 
-            if(i == 0 && !fVehicles.empty()){
+            if (fLanes > 1) {
+                // Drive the vehicle that took its place behind the vehicle in front of it in its lane
+                Vehicle* vehicleInFront = NULL;
+                for (int j = i - 1; j >= 0 && i < (int) fVehicles.size(); j--) {
+                    if (fVehicles[j]->getLane() == fVehicles[i]->getLane()) {
+                        vehicleInFront = fVehicles[j];
+                        break;
+                    }
+                }
+                if (i < (int) fVehicles.size()) {
+                    fVehicles[i]->drive(vehicleInFront);
+                }
+            }
+            else if(i == 0 && !fVehicles.empty()){
                 fVehicles[i]->drive(fVehicles[i]);
             }
-            else if(fVehicles.size()>1){
+            else if(fVehicles.size()>1 && i < (int) fVehicles.size()){
                 fVehicles[i]->drive(fVehicles[i-1]);
             }
         }
@@ -130,53 +265,188 @@ const std::string &Street::getName() const {
 
     return Street::fName;
 }
+
+unsigned int Street::getId() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getId()");
+
+    return Street::fId;
+}
+
+unsigned int Street::getIndex() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getIndex()");
+
+    return Street::fIndex;
+}
+
+void Street::setIndex(unsigned int index) {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling setIndex()");
+
+    Street::fIndex = index;
+
+    ENSURE(getIndex() == index, "setIndex() postcondition");
+}
 int Street::getLength() const {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getLength()");
 
     return Street::fLength;
 }
 
-std::vector<TrafficLight *> Street::getTrafficLights() const {
+const std::vector<TrafficLight *> &Street::getTrafficLights() const {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getTrafficLights()");
 
     return fTrafficLights;
 }
 
-std::vector<Vehicle*> Street::getVehicles() const {
+const std::vector<Vehicle*> &Street::getVehicles() const {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getVehicles()");
 
     return fVehicles;
 }
 
-std::vector<BusStop*> Street::getBusStops() const {
+unsigned int Street::copyVehicles(VehicleBuffers &buffers, unsigned int offset, unsigned int street) const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling copyVehicles()");
+
+    unsigned int end = fVehicles.size();
+    if (offset >= buffers.capacity) {
+        end = 0;
+    } else if (buffers.capacity - offset < end) {
+        end = buffers.capacity - offset;
+    }
+    for (unsigned int i = 0; i < end; i++) {
+        fVehicles[i]->copyState(buffers, offset + i);
+        if (buffers.streets != NULL) {
+            buffers.streets[offset + i] = street;
+        }
+    }
+    return fVehicles.size();
+}
+
+const std::vector<BusStop*> &Street::getBusStops() const {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getBusStops()");
 
     return fBusStops;
 }
 
-std::map<Street*,int> Street::getCrossroads() const {
+const std::vector<Detector*> &Street::getDetectors() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getDetectors()");
+
+    return fDetectors;
+}
+
+const std::map<Street*,int> &Street::getCrossroads() const {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getCrossroads()");
 
     return fCrossroads;
 }
 
-Vehicle *Street::CreateTypeVehicle(std::string type,std::string street,int position) {
-    Vehicle* newVehicle;
-    if (type == "Car") {
-        newVehicle = new Car(street, position);
-    } else if (type == "Bus") {
-        newVehicle = new Bus(street, position);
-    } else if (type == "FireEngine") {
-        newVehicle = new FireEngine(street, position);
-    } else if (type == "Ambulance") {
-        newVehicle = new Ambulance(street, position);
-    } else if (type == "PoliceCar") {
-        newVehicle = new PoliceCar(street, position);
+unsigned int Street::getExitedVehicles() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getExitedVehicles()");
+
+    return fExitedVehicles;
+}
+
+unsigned int Street::getGeneratedVehicles() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getGeneratedVehicles()");
+
+    return fGeneratedVehicles;
+}
+
+const std::deque<Vehicle*> &Street::getEntryQueue() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getEntryQueue()");
+
+    return fEntryQueue;
+}
+
+unsigned int Street::getMaxEntryQueue() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getMaxEntryQueue()");
+
+    return fMaxEntryQueue;
+}
+
+bool Street::isIdle() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling isIdle()");
+
+    return fVehicles.empty() && fEntryQueue.empty() && fTrafficLights.empty() && fDetectors.empty();
+}
+
+double Street::getEntryQueueTime() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getEntryQueueTime()");
+
+    return fEntryQueueTime;
+}
+
+unsigned int Street::getFinishedVehicles() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getFinishedVehicles()");
+
+    return fFinishedVehicles;
+}
+
+double Street::getFinishedTravelTime() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getFinishedTravelTime()");
+
+    return fFinishedTravelTime;
+}
+
+unsigned int Street::getLanes() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getLanes()");
+
+    return fLanes;
+}
+
+std::vector<Vehicle*> Street::getLaneVehicles(unsigned int lane) const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getLaneVehicles()");
+    REQUIRE(lane < getLanes(), "The lane doesn't exist");
+
+    std::vector<Vehicle*> vehicles;
+    for (unsigned int i = 0; i < fVehicles.size(); i++) {
+        if (fVehicles[i]->getLane() == lane) {
+            vehicles.push_back(fVehicles[i]);
+        }
     }
-    else {
-        std::cout << "Type of car does not exist" << std::endl;
+    return vehicles;
+}
+
+EStreetLevel Street::getLevel() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getLevel()");
+
+    return fLevel;
+}
+
+double Street::getObservedStart() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getObservedStart()");
+
+    if (fLevel == MicroscopicLevel) {
+        return 0;
+    }
+    double firstObserved = fLength;
+    for (unsigned int i = 0; i < fTrafficLights.size(); i++) {
+        firstObserved = std::min(firstObserved, (double) fTrafficLights[i]->getPosition());
+    }
+    for (unsigned int i = 0; i < fBusStops.size(); i++) {
+        firstObserved = std::min(firstObserved, (double) fBusStops[i]->getPosition());
+    }
+    for (std::map<Street*,int>::const_iterator it = fCrossroads.begin(); it != fCrossroads.end(); it++) {
+        firstObserved = std::min(firstObserved, (double) it->second);
     }
-    return newVehicle;
+    return std::max(0.0, firstObserved - gObservedDistance);
+}
+
+unsigned int Street::getQueueLength() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getQueueLength()");
+
+    unsigned int queueLength = 0;
+    for (unsigned int i = 0; i < fVehicles.size(); i++) {
+        if (fVehicles[i]->getSpeed() < gQueueSpeed) {
+            queueLength++;
+        }
+    }
+    return queueLength;
+}
+
+Vehicle *Street::CreateTypeVehicle(unsigned int type, unsigned int street, int position, const VehicleTypeRegistry &types) {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling CreateTypeVehicle()");
+
+    return new Vehicle(street, position, type, types);
 }
 
 bool Street::hasVehicleGenerator() const {
@@ -185,16 +455,42 @@ bool Street::hasVehicleGenerator() const {
     return fVehicleGenerator != NULL;
 }
 
+const VehicleGenerator *Street::getVehicleGenerator() const {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getVehicleGenerator()");
+    REQUIRE(hasVehicleGenerator(), "The street has no vehicle generator");
+
+    return fVehicleGenerator;
+}
+
 void Street::driveVehicles() {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling driveVehicles()");
 
+    if (!fEntryQueue.empty()) {
+        enterVehicles();
+        fEntryQueueTime += fEntryQueue.size() * gSimulationTime;
+    }
+
     if (fVehicles.empty()) {
+        for (unsigned int i = 0; i < fDetectors.size(); i++) {
+            fDetectors[i]->measure(fVehicles);
+        }
+        return;
+    }
+
+    double observedStart = getObservedStart();
+    fEntryHeadway = std::max(0.0, fEntryHeadway - gSimulationTime);
+    if (fLanes > 1) {
+        driveLanes(observedStart);
         return;
     }
 
     std::vector<double> originalPositions;
     for (unsigned int i = 0; i < fVehicles.size(); i++) {
         originalPositions.push_back(fVehicles[i]->getPosition());
+        if (observedStart > 0 && fVehicles[i]->getPosition() <= observedStart) {
+            driveMesoscopic(fVehicles[i], i > 0 ? fVehicles[i-1] : NULL, observedStart);
+            continue;
+        }
         if (i == 0) {
             fVehicles[i]->drive(NULL);
             if (fVehicles[i]->getPosition() > fLength) {
@@ -206,17 +502,180 @@ void Street::driveVehicles() {
         }
         fVehicles[i]->drive(fVehicles[i-1]);
     }
+    for (unsigned int i = 0; i < fDetectors.size(); i++) {
+        fDetectors[i]->measure(fVehicles);
+    }
 
     for (unsigned int i = 0; i < fVehicles.size(); i++) {
         ENSURE(fVehicles[i]->getPosition() >= originalPositions[i] - 0.001, "driveVehicles() postcondition");
     }
 }
 
+void Street::enterVehicles() {
+    while (!fEntryQueue.empty()) {
+        // The rear of the last vehicle of every lane, found from the back of the street
+        std::vector<double> lastRears(fLanes, fLength + 1.0);
+        std::vector<bool> found(fLanes, false);
+        unsigned int lanesFound = 0;
+        for (unsigned int i = fVehicles.size(); i > 0 && lanesFound < fLanes; i--) {
+            unsigned int lane = fVehicles[i-1]->getLane();
+            if (!found[lane]) {
+                found[lane] = true;
+                lastRears[lane] = fVehicles[i-1]->getPosition() - fVehicles[i-1]->getLength();
+                lanesFound++;
+            }
+        }
+        unsigned int lane = std::max_element(lastRears.begin(), lastRears.end()) - lastRears.begin();
+        Vehicle* vehicle = fEntryQueue.front();
+        if (lastRears[lane] < vehicle->getParameters().minFollowDistance) {
+            return;
+        }
+        vehicle->setLane(lane);
+        fVehicles.push_back(vehicle);
+        fEntryQueue.pop_front();
+    }
+}
+
+void Street::driveMesoscopic(Vehicle *vehicle, Vehicle *vehicleInFront, double observedStart) {
+    double position = vehicle->getPosition();
+    double target = position + vehicle->getMaxSpeed() * gSimulationTime;
+    if (vehicleInFront != NULL) {
+        double queueEnd = vehicleInFront->getPosition() - vehicleInFront->getLength() - vehicle->getParameters().minFollowDistance;
+        target = std::min(target, queueEnd);
+    }
+    if (target > observedStart) {
+        if (fEntryHeadway > 0) {
+            target = observedStart;
+        } else {
+            fEntryHeadway = 1 / (gMesoscopicCapacity * fLanes);
+        }
+    }
+    vehicle->advance(std::max(0.0, target - position));
+}
+
+void Street::driveLanes(double observedStart) {
+    // The vehicles are sorted from front to back, so every lane is as well
+    fLaneVehicles.resize(fLanes);
+    for (unsigned int l = 0; l < fLanes; l++) {
+        fLaneVehicles[l].clear();
+    }
+    for (unsigned int i = 0; i < fVehicles.size(); i++) {
+        fLaneVehicles[fVehicles[i]->getLane()].push_back(fVehicles[i]);
+    }
+    changeLanes(observedStart);
+
+    unsigned int vehicles = 0;
+    for (unsigned int l = 0; l < fLanes; l++) {
+        std::vector<Vehicle*> &lane = fLaneVehicles[l];
+        for (unsigned int i = 0; i < lane.size(); i++) {
+            Vehicle* vehicleInFront = i > 0 ? lane[i-1] : NULL;
+            if (observedStart > 0 && lane[i]->getPosition() <= observedStart) {
+                driveMesoscopic(lane[i], vehicleInFront, observedStart);
+                continue;
+            }
+            lane[i]->drive(vehicleInFront);
+            if (i == 0 && lane[i]->getPosition() > fLength) {
+                finishVehicle(lane[i]);
+                lane.erase(lane.begin());
+                i -= 1;
+            }
+        }
+        vehicles += lane.size();
+    }
+
+    // Merge the lanes back into one list from front to back
+    fVehicles.clear();
+    std::vector<unsigned int> next(fLanes, 0);
+    while (fVehicles.size() < vehicles) {
+        unsigned int front = fLanes;
+        for (unsigned int l = 0; l < fLanes; l++) {
+            if (next[l] < fLaneVehicles[l].size() && (front == fLanes
+                    || fLaneVehicles[l][next[l]]->getPosition() > fLaneVehicles[front][next[front]]->getPosition())) {
+                front = l;
+            }
+        }
+        fVehicles.push_back(fLaneVehicles[front][next[front]]);
+        next[front]++;
+    }
+    for (unsigned int i = 0; i < fDetectors.size(); i++) {
+        fDetectors[i]->measure(fVehicles, fLanes);
+    }
+
+    for (unsigned int i = 0; i < fVehicles.size(); i++) {
+        ENSURE(fVehicles[i]->getPosition() >= fVehicles[i]->getPreviousPosition() - 0.001, "driveVehicles() postcondition");
+    }
+}
+
+void Street::changeLanes(double observedStart) {
+    fChangeLeft = !fChangeLeft;
+    for (unsigned int l = 0; l < fLanes; l++) {
+        if ((fChangeLeft && l + 1 >= fLanes) || (!fChangeLeft && l == 0)) {
+            continue;
+        }
+        unsigned int target = fChangeLeft ? l + 1 : l - 1;
+        const std::vector<Vehicle*> &lane = fLaneVehicles[l];
+        const std::vector<Vehicle*> &targetLane = fLaneVehicles[target];
+
+        // The vehicles of the target lane before `gap` are ahead of the current vehicle
+        unsigned int gap = 0;
+        unsigned int claimedGap = targetLane.size() + 1;
+        for (unsigned int i = 0; i < lane.size(); i++) {
+            Vehicle* vehicle = lane[i];
+            while (gap < targetLane.size() && targetLane[gap]->getPosition() >= vehicle->getPosition()) {
+                gap++;
+            }
+            // Vehicles on the mesoscopic part or braking for a traffic light or bus stop keep their lane
+            if ((observedStart > 0 && vehicle->getPosition() <= observedStart)
+                    || vehicle->getMaxSpeed() < vehicle->getParameters().maxSpeed || gap == claimedGap) {
+                continue;
+            }
+            Vehicle* leader = i > 0 ? lane[i-1] : NULL;
+            Vehicle* follower = i + 1 < lane.size() ? lane[i+1] : NULL;
+            Vehicle* newLeader = gap > 0 ? targetLane[gap-1] : NULL;
+            Vehicle* newFollower = gap < targetLane.size() ? targetLane[gap] : NULL;
+            if (newLeader != NULL && newLeader->getPosition() - newLeader->getLength() - vehicle->getPosition()
+                    <= vehicle->getParameters().minFollowDistance) {
+                continue;
+            }
+            if (newFollower != NULL && vehicle->getPosition() - vehicle->getLength() - newFollower->getPosition()
+                    <= newFollower->getParameters().minFollowDistance) {
+                continue;
+            }
+
+            double incentive = vehicle->getFollowingAcceleration(newLeader) - vehicle->getFollowingAcceleration(leader);
+            double othersGain = 0;
+            if (newFollower != NULL) {
+                double newFollowerAcceleration = newFollower->getFollowingAcceleration(vehicle);
+                if (newFollowerAcceleration < -gSafeBraking) {
+                    continue;
+                }
+                othersGain += newFollowerAcceleration - newFollower->getFollowingAcceleration(newLeader);
+            }
+            if (follower != NULL) {
+                othersGain += follower->getFollowingAcceleration(leader) - follower->getFollowingAcceleration(vehicle);
+            }
+            if (incentive + gPoliteness * othersGain > gLaneChangeThreshold) {
+                vehicle->setLane(target);
+                claimedGap = gap;
+            }
+        }
+    }
+
+    // Move the vehicles that changed lanes, the lanes stay sorted from front to back
+    for (unsigned int l = 0; l < fLanes; l++) {
+        fLaneVehicles[l].clear();
+    }
+    for (unsigned int i = 0; i < fVehicles.size(); i++) {
+        fLaneVehicles[fVehicles[i]->getLane()].push_back(fVehicles[i]);
+    }
+}
+
 void Street::simTrafficLights(double &time) {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling simTrafficLights()");
     if (fTrafficLights.empty()) {
         return;
     }
+    measureQueues(time);
 
     std::vector<bool> originalStates;
     for (unsigned int i = 0; i < fTrafficLights.size(); i++) {
@@ -240,36 +699,42 @@ void Street::simTrafficLights(double &time) {
         if (fVehicles.empty()) {
             return;
         }
-        Vehicle *closestVehicle = NULL;
+        // On a street with several lanes the closest vehicle of every lane reacts to the light
+        std::vector<Vehicle*> closestVehicles(fLanes, NULL);
         for (unsigned int v = 0; v < fVehicles.size(); v++) {
             if (fVehicles[v]->hasPriority()) {
                 continue;
             }
             if (fVehicles[v]->getPosition() < curTrafficLight->getPosition()) {
+                Vehicle* &closestVehicle = closestVehicles[fVehicles[v]->getLane()];
                 if (closestVehicle == NULL || fVehicles[v]->getPosition() > closestVehicle->getPosition()) {
                     closestVehicle = fVehicles[v];
                 }
             }
         }
 
-        // Go to next traffic light if there is no vehicle before the traffic light
-        if (closestVehicle == NULL) {
-            continue;
-        }
+        for (unsigned int l = 0; l < fLanes; l++) {
+            Vehicle* closestVehicle = closestVehicles[l];
 
-        // Traffic light is green
-        if (curTrafficLight->isGreen()) {
-            closestVehicle->setMaxSpeed();
-        }
+            // Go to next lane if there is no vehicle before the traffic light
+            if (closestVehicle == NULL) {
+                continue;
+            }
 
-        // Traffic light is red
-        else {
-            double distance = curTrafficLight->getPosition() - closestVehicle->getPosition();
-            if (distance > 0 && distance < gStopDistance) {
-                closestVehicle->stop();
+            // Traffic light is green
+            if (curTrafficLight->isGreen()) {
+                closestVehicle->setMaxSpeed();
             }
-            else if (distance > 0 && distance < gBrakeDistance) {
-                closestVehicle->brake();
+
+            // Traffic light is red
+            else {
+                double distance = curTrafficLight->getPosition() - closestVehicle->getPosition();
+                if (distance > 0 && distance < gStopDistance) {
+                    closestVehicle->stop();
+                }
+                else if (distance > 0 && distance < gBrakeDistance) {
+                    closestVehicle->brake();
+                }
             }
         }
     }
@@ -279,13 +744,67 @@ void Street::simTrafficLights(double &time) {
     }
 }
 
-void Street::simGenerator(double &time) {
+void Street::measureQueues(double time) {
+    for (unsigned int i = 0; i < fTrafficLights.size(); i++) {
+        TrafficLight* trafficLight = fTrafficLights[i];
+        int lightPosition = trafficLight->getPosition();
+
+        // The vehicles are sorted from front to back, so the queue starts at the first vehicle behind the light
+        unsigned int low = 0;
+        unsigned int high = fVehicles.size();
+        while (low < high) {
+            unsigned int middle = (low + high) / 2;
+            if (fVehicles[middle]->getPosition() < lightPosition) {
+                high = middle;
+            } else {
+                low = middle + 1;
+            }
+        }
+        // Every lane has its own queue, the longest one decides the length in meters
+        unsigned int length = 0;
+        std::vector<double> laneEnds(fLanes, lightPosition);
+        std::vector<bool> queueing(fLanes, true);
+        unsigned int queueingLanes = fLanes;
+        double queueEnd = lightPosition;
+        for (unsigned int v = low; v < fVehicles.size() && queueingLanes > 0; v++) {
+            Vehicle* vehicle = fVehicles[v];
+            unsigned int lane = vehicle->getLane();
+            if (!queueing[lane]) {
+                continue;
+            }
+            if (vehicle->getSpeed() >= gQueueSpeed || laneEnds[lane] - vehicle->getPosition() > gQueueGap) {
+                queueing[lane] = false;
+                queueingLanes--;
+                continue;
+            }
+            length++;
+            laneEnds[lane] = vehicle->getPosition() - vehicle->getLength();
+            queueEnd = std::min(queueEnd, laneEnds[lane]);
+        }
+        trafficLight->updateQueue(length, std::max(0.0, lightPosition - queueEnd), time);
+
+        // The queue spills back when it reaches the closest crossroad upstream of the light
+        int crossroad = -1;
+        for (std::map<Street*,int>::const_iterator it = fCrossroads.begin(); it != fCrossroads.end(); ++it) {
+            if (it->second < lightPosition && it->second > crossroad) {
+                crossroad = it->second;
+            }
+        }
+        bool spillback = length > 0 && crossroad >= 0 && queueEnd <= crossroad;
+        if (spillback && !trafficLight->hasSpillback() && fQueueListener != NULL) {
+            fQueueListener->spillback(*this, *trafficLight, crossroad, time);
+        }
+        trafficLight->setSpillback(spillback);
+    }
+}
+
+void Street::simGenerator(double &time, double uniform, const VehicleTypeRegistry &types) {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling simGenerator()");
 
-    long unsigned int startSize = fVehicles.size();
+    long unsigned int startSize = fVehicles.size() + fEntryQueue.size();
 
     if (fVehicleGenerator == NULL) {
-        ENSURE(fVehicles.size() == startSize, "simGenerator() postcondition");
+        ENSURE(fVehicles.size() + fEntryQueue.size() == startSize, "simGenerator() postcondition");
         return;
     }
 
@@ -293,33 +812,57 @@ void Street::simGenerator(double &time) {
     if (fVehicleGenerator->getTimeSinceLastSpawn() < time) {
         spawn = true;
 
-        Vehicle* newVehicle;
-        std::string type = fVehicleGenerator->getType();
-        if (type == "auto") {
-            newVehicle = new Car(fName, 0);
-        } else if (type == "bus") {
-            newVehicle = new Bus(fName, 0);
-        } else if (type == "brandweerwagen") {
-            newVehicle = new FireEngine(fName, 0);
-        } else if (type == "ziekenwagen") {
-            newVehicle = new Ambulance(fName, 0);
-        } else {
-            newVehicle = new PoliceCar(fName, 0);
+        Vehicle* newVehicle = CreateTypeVehicle(fVehicleGenerator->getVehicleType(), fId, 0, types);
+        if (fVehicleGenerator->hasDestination()) {
+            newVehicle->setDestination(fVehicleGenerator->getDestination());
         }
+        spawnVehicle(newVehicle, time);
 
-        fVehicles.push_back(newVehicle);
-
-        fVehicleGenerator->setTimeSinceLastSpawn(fVehicleGenerator->getTimeSinceLastSpawn() + fVehicleGenerator->getFrequency());
+        fVehicleGenerator->setTimeSinceLastSpawn(fVehicleGenerator->getTimeSinceLastSpawn() + fVehicleGenerator->drawHeadway(uniform));
     }
 
     if (spawn) {
-        ENSURE(fVehicles.size() == startSize+1, "simGenerator() postcondition");
+        ENSURE(fVehicles.size() + fEntryQueue.size() == startSize+1, "simGenerator() postcondition");
     }
     else {
-        ENSURE(fVehicles.size() == startSize, "simGenerator() postcondition");
+        ENSURE(fVehicles.size() + fEntryQueue.size() == startSize, "simGenerator() postcondition");
     }
 }
 
+void Street::spawnVehicle(Vehicle *vehicle, double time) {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling spawnVehicle()");
+    REQUIRE(vehicle->getStreetId() == fId, "The vehicle did not have the same name as the street it was added to");
+
+    long unsigned int startSize = fVehicles.size() + fEntryQueue.size();
+
+    vehicle->setId(fIndex + 1, fGeneratedVehicles++);
+    vehicle->setSpawnTime(time);
+    fEntryQueue.push_back(vehicle);
+    enterVehicles();
+    fMaxEntryQueue = std::max(fMaxEntryQueue, (unsigned int) fEntryQueue.size());
+
+    ENSURE(fVehicles.size() + fEntryQueue.size() == startSize + 1, "spawnVehicle() postcondition");
+}
+
+void Street::injectVehicle(Vehicle *vehicle, double time) {
+    REQUIRE(properlyInitialized(), "Street wasn't initialized when calling injectVehicle()");
+    REQUIRE(vehicle->getStreetId() == fId, "The vehicle did not have the same name as the street it was added to");
+    REQUIRE(vehicle->getPosition() >= 0 && vehicle->getPosition() <= fLength, "The vehicle stands of the road");
+    REQUIRE(vehicle->getLane() < fLanes, "The vehicle drives on a lane that doesn't exist");
+
+    long unsigned int startSize = fVehicles.size();
+
+    vehicle->setId(fIndex + 1, fGeneratedVehicles++);
+    vehicle->setSpawnTime(time);
+    unsigned int index = 0;
+    while (index < fVehicles.size() && fVehicles[index]->getPosition() >= vehicle->getPosition()) {
+        index++;
+    }
+    fVehicles.insert(fVehicles.begin() + index, vehicle);
+
+    ENSURE(fVehicles.size() == startSize + 1, "injectVehicle() postcondition");
+}
+
 void Street::simBusStops(double &time) {
     REQUIRE(properlyInitialized(), "Street wasn't initialized when calling simBusStops()");
     if (fBusStops.empty()) {
@@ -335,7 +878,7 @@ void Street::simBusStops(double &time) {
         }
         Vehicle *closestBus = NULL;
         for (unsigned int v = 0; v < fVehicles.size(); v++) {
-            if (fVehicles[v]->getType() != "Bus") {
+            if (!fVehicles[v]->stopsAtBusStops()) {
                 continue;
             }
             if (fVehicles[v]->getPosition() < curBusStop->getPosition()) {
@@ -349,18 +892,16 @@ void Street::simBusStops(double &time) {
             continue;
         }
 
-        Bus* closestBusType = dynamic_cast<Bus*>(closestBus);
-
         double distance = curBusStop->getPosition() - closestBus->getPosition();
         if (distance > 0 && distance < gStopDistance) {
             closestBus->stop();
-            closestBusType->addWaitTime(gSimulationTime);
+            closestBus->addWaitTime(gSimulationTime);
         }
         else if (distance > 0 && distance < gBrakeDistance) {
             closestBus->brake();
         }
-        if (closestBusType->getWaitTime() > curBusStop->getWaitTime()) {
-            curBusStop->addArrivedBus(closestBusType);
+        if (closestBus->getWaitTime() > curBusStop->getWaitTime()) {
+            curBusStop->addArrivedBus(closestBus);
         }
     }
 }
@@ -11,23 +11,90 @@
 #include <iostream>
 #include <vector>
 #include <map>
+#include <deque>
+#include "Vehicle.h"
 
 class TrafficLight;
-class Vehicle;
 class VehicleGenerator;
 class BusStop;
+class Detector;
+class TravelStatistics;
+class QueueListener;
+
+// On a mesoscopic street only the vehicles close to a traffic light, bus stop, crossroad or the end of the street are
+// driven with the driving model, the others move at their maximum speed in a queue with a limited capacity
+enum EStreetLevel {
+    MicroscopicLevel,
+    MesoscopicLevel
+};
 
 class Street {
     Street* _initCheck;
 
     std::string fName;
+    unsigned int fId;
+    // Position of the street in its simulation. The random draws of the street are keyed on it instead of fId, which
+    // depends on the names the process interned before.
+    unsigned int fIndex;
     int fLength;
     std::vector<TrafficLight*> fTrafficLights;
     std::vector<Vehicle*> fVehicles;
     std::vector<BusStop*> fBusStops;
+    std::vector<Detector*> fDetectors;
     VehicleGenerator* fVehicleGenerator;
     std::map<Street*,int> fCrossroads;
+    EStreetLevel fLevel;
+    // Amount of lanes. Vehicles on a street with several lanes only follow the vehicle in front of them in their lane
+    // and change lanes with MOBIL, see changeLanes()
+    unsigned int fLanes;
+    // The vehicles of every lane from front to back, split from fVehicles at the start of every tick with several lanes
+    std::vector<std::vector<Vehicle*> > fLaneVehicles;
+    // Lane changes go to the left on one tick and to the right on the next, so no two vehicles enter the same gap
+    // from both sides
+    bool fChangeLeft;
+    // Time (in s) until the next vehicle may enter the observed part of a mesoscopic street
+    double fEntryHeadway;
+
+    // Vehicles that drove off the end of the street or turned onto another street
+    unsigned int fExitedVehicles;
+    // Vehicles created by the generator or a demand, used as the serial of their id
+    unsigned int fGeneratedVehicles;
+    // Generated vehicles that wait outside the network until there is room at the start of the street, first come
+    // first served, with the longest queue and the time (in vehicle-seconds) waited in it so far
+    std::deque<Vehicle*> fEntryQueue;
+    unsigned int fMaxEntryQueue;
+    double fEntryQueueTime;
+    // Vehicles that drove off the end of the street and so left the network, with their summed travel time
+    unsigned int fFinishedVehicles;
+    double fFinishedTravelTime;
+    // Records the journeys of the vehicles that leave the network, NULL if they aren't recorded. Not owned.
+    TravelStatistics* fTravelStatistics;
+    // Told when a queue before a traffic light spills back onto a crossroad, NULL to stay silent. Not owned.
+    QueueListener* fQueueListener;
+
+    // Moves the vehicle at `index` on the mesoscopic part of the street, it waits behind the vehicle in front of it
+    // and for the capacity of the observed part
+    void driveMesoscopic(Vehicle* vehicle, Vehicle* vehicleInFront, double observedStart);
+
+    // Lets the vehicles of the entry queue enter as long as the rear of the last vehicle of a lane is at least their
+    // minimal following distance from the start of the street
+    void enterVehicles();
+
+    // Drives the vehicles of a street with several lanes, every vehicle follows the vehicle in front of it in its lane
+    void driveLanes(double observedStart);
+
+    // Lets the vehicles in fLaneVehicles that gain enough by it change lanes, following MOBIL: the gain in acceleration
+    // of the vehicle minus gPoliteness times the loss of its old and new follower must exceed gLaneChangeThreshold, and
+    // the new follower may not have to brake harder than gSafeBraking. Every lane is walked once from front to back
+    // together with the lanes next to it, so the cost is linear in the amount of vehicles.
+    void changeLanes(double observedStart);
+
+    // Counts a vehicle that drove off the end of the street and deletes it
+    void finishVehicle(Vehicle* vehicle);
 
+    // Updates the queue of every traffic light: the queued vehicles upstream of the light that are at most gQueueGap
+    // behind the light or the previous vehicle of the queue in their lane
+    void measureQueues(double time);
 
 public:
     /*
@@ -39,9 +106,29 @@ public:
 
     bool properlyInitialized() const;
 
+    /*
+     * Returns a copy of this street that is owned by the caller, with copies of everything on it except for the
+     * crossroads as those point to other streets. The copied vehicles keep the vehicle types of this street, see
+     * setVehicleTypes().
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling clone()")
+     *
+     * ENSURE(copy->properlyInitialized(), "clone() postcondition")
+     * ENSURE(copy->getVehicles().size() == fVehicles.size(), "clone() postcondition")
+     */
+    Street* clone() const;
+
+    /*
+     * Lets the vehicles on the street and in its entry queue take their parameters from `types`, the registry of the
+     * simulation the street belongs to.
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling setVehicleTypes()")
+     */
+    void setVehicleTypes(const VehicleTypeRegistry &types);
+
     /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling addTrafficLight()")
-     * REQUIRE(t->getStreet() == fName, "The traffic light did not have the same name as the street it was added to");
+     * REQUIRE(t->getStreetId() == fId, "The traffic light did not have the same name as the street it was added to");
      * REQUIRE(t->getPosition() <= fLength, "The traffic light stands of the road");
      * REQUIRE(t->getPosition() >= 0, "The traffic light stands of the road");
      *
@@ -51,9 +138,10 @@ public:
 
     /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling addVehicle()")
-     * REQUIRE(v->getStreet() == fName, "The traffic light did not have the same name as the street it was added to");
+     * REQUIRE(v->getStreetId() == fId, "The traffic light did not have the same name as the street it was added to");
      * REQUIRE(v->getPosition() <= fLength, "The traffic light stands of the road");
      * REQUIRE(v->getPosition() >= 0, "The traffic light stands of the road");
+     * REQUIRE(v->getLane() < fLanes, "The vehicle drives on a lane that doesn't exist")
      *
      * ENSURE(fVehicles.size() == vehiclesSize+1, "addVehicle() postcondition")
      */
@@ -61,7 +149,7 @@ public:
 
      /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling addBusStop()")
-     * REQUIRE(b->getStreet() == fName, "The traffic light did not have the same name as the street it was added to");
+     * REQUIRE(b->getStreetId() == fId, "The traffic light did not have the same name as the street it was added to");
      * REQUIRE(b->getPosition() <= fLength, "The traffic light stands of the road");
      * REQUIRE(b->getPosition() >= 0, "The traffic light stands of the road");
      *
@@ -69,6 +157,16 @@ public:
      */
     void addBusStop(BusStop* b);
   
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling addDetector()")
+     * REQUIRE(d->getStreetId() == fId, "The detector did not have the same name as the street it was added to")
+     * REQUIRE(d->getPosition() < fLength, "The detector lies of the road")
+     * REQUIRE(d->getPosition() >= 0, "The detector lies of the road")
+     *
+     * ENSURE(fDetectors.size() == detectorsSize+1, "addDetector() postcondition")
+     */
+    void addDetector(Detector* d);
+
     /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling addCrossroad()")
      *
@@ -78,12 +176,46 @@ public:
 
     /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling addVehicleGenerator()")
-     * REQUIRE(vg->getStreet() == fName, "The generator did not have the same name as the street it was added to")
+     * REQUIRE(vg->getStreetId() == fId, "The generator did not have the same name as the street it was added to")
      *
      * ENSURE(fVehicleGenerator == vg, "addVehicleGenerator() postcondition")
      */
     void setVehicleGenerator(VehicleGenerator* vg);
 
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling setLevel()")
+     *
+     * ENSURE(getLevel() == level, "setLevel() postcondition")
+     */
+    void setLevel(EStreetLevel level);
+
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling setLanes()")
+     * REQUIRE(lanes > 0, "A street needs at least one lane")
+     * for (unsigned int i = 0; i < fVehicles.size(); i++) REQUIRE(fVehicles[i]->getLane() < lanes, "A vehicle drives on a lane that doesn't exist")
+     *
+     * ENSURE(getLanes() == lanes, "setLanes() postcondition")
+     */
+    void setLanes(unsigned int lanes);
+
+    /*
+     * The statistics are not owned by the street and are not copied by clone().
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling setTravelStatistics()")
+     *
+     * ENSURE(fTravelStatistics == statistics, "setTravelStatistics() postcondition")
+     */
+    void setTravelStatistics(TravelStatistics* statistics);
+
+    /*
+     * The listener is not owned by the street and is not copied by clone().
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling setQueueListener()")
+     *
+     * ENSURE(fQueueListener == listener, "setQueueListener() postcondition")
+     */
+    void setQueueListener(QueueListener* listener);
+
     /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling removeVehicle()")
      *
@@ -103,6 +235,23 @@ public:
      */
     const std::string &getName() const;
 
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getId()")
+     */
+    unsigned int getId() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getIndex()")
+     */
+    unsigned int getIndex() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling setIndex()")
+     *
+     * ENSURE(getIndex() == index, "setIndex() postcondition")
+     */
+    void setIndex(unsigned int index);
+
     /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getLength()")
      */
@@ -111,27 +260,126 @@ public:
     /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getTrafficLights()")
      */
-    std::vector<TrafficLight*> getTrafficLights() const;
+    const std::vector<TrafficLight*> &getTrafficLights() const;
 
     /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getVehicles()")
      */
-    std::vector<Vehicle*> getVehicles() const;
+    const std::vector<Vehicle*> &getVehicles() const;
+
+    /*
+     * Writes the state of the vehicles from front to back into `buffers`, starting at `offset`, as far as they fit,
+     * with `street` as the index of this street. Returns the amount of vehicles on the street.
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling copyVehicles()")
+     */
+    unsigned int copyVehicles(VehicleBuffers &buffers, unsigned int offset, unsigned int street) const;
 
     /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getBusStops()")
      */
-    std::vector<BusStop*> getBusStops() const;
+    const std::vector<BusStop*> &getBusStops() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getDetectors()")
+     */
+    const std::vector<Detector*> &getDetectors() const;
 
     /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getCrossroads()")
      */
-    std::map<Street*,int> getCrossroads() const;
+    const std::map<Street*,int> &getCrossroads() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getExitedVehicles()")
+     */
+    unsigned int getExitedVehicles() const;
 
     /*
+     * Returns the amount of vehicles generated on this street, including the ones in the entry queue, see
+     * spawnVehicle().
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getGeneratedVehicles()")
+     */
+    unsigned int getGeneratedVehicles() const;
+
+    /*
+     * Returns the vehicles that wait to enter the street, the first one enters first.
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getEntryQueue()")
+     */
+    const std::deque<Vehicle*> &getEntryQueue() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getMaxEntryQueue()")
+     */
+    unsigned int getMaxEntryQueue() const;
+
+    /*
+     * Returns whether a tick leaves the street as it is: it has no vehicles, no vehicles waiting to enter, no traffic
+     * lights that change and no detectors that measure, so driveVehicles(), simTrafficLights() and simBusStops() can
+     * be skipped.
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling isIdle()")
+     */
+    bool isIdle() const;
+
+    /*
+     * Returns the summed time (in s) the vehicles waited in the entry queue, which is also the integral of its length.
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getEntryQueueTime()")
+     */
+    double getEntryQueueTime() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getFinishedVehicles()")
+     */
+    unsigned int getFinishedVehicles() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getFinishedTravelTime()")
+     */
+    double getFinishedTravelTime() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getLanes()")
+     */
+    unsigned int getLanes() const;
+
+    /*
+     * Returns the vehicles on `lane` from front to back.
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getLaneVehicles()")
+     * REQUIRE(lane < getLanes(), "The lane doesn't exist")
+     */
+    std::vector<Vehicle*> getLaneVehicles(unsigned int lane) const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getLevel()")
+     */
+    EStreetLevel getLevel() const;
+
+    /*
+     * Returns the position from which the vehicles are simulated microscopically, this is `gObservedDistance` before
+     * the first traffic light, bus stop, crossroad or the end of the street. It is 0 on a microscopic street.
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getObservedStart()")
+     */
+    double getObservedStart() const;
+
+    /*
+     * Returns the amount of vehicles that drive slower than `gQueueSpeed`.
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getQueueLength()")
+     */
+    unsigned int getQueueLength() const;
+
+    /*
+     * Creates a vehicle of `type` in `types`, the registry of the simulation.
+     *
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling CreateTypeVehicle()")
      */
-    Vehicle * CreateTypeVehicle(std::string type,std::string street, int position);
+    Vehicle * CreateTypeVehicle(unsigned int type, unsigned int street, int position, const VehicleTypeRegistry &types);
 
     /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling hasVehicleGenerator()")
@@ -139,6 +387,14 @@ public:
     bool hasVehicleGenerator() const;
 
     /*
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling getVehicleGenerator()")
+     * REQUIRE(hasVehicleGenerator(), "The street has no vehicle generator")
+     */
+    const VehicleGenerator* getVehicleGenerator() const;
+
+    /*
+     * First lets the vehicles of the entry queue enter that fit.
+     *
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling driveVehicles()")
      *
      * for (unsigned int i = 0; i < fVehicles.size(); i++) ENSURE(fVehicles[i]->getPosition() >= originalPositions[i] - 0.001, "driveVehicles() postcondition")
@@ -146,6 +402,8 @@ public:
     void driveVehicles();
 
     /*
+    * Also updates the queues before the traffic lights, see TrafficLight::updateQueue().
+    *
     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling simTrafficLights()")
      *
      * for (unsigned int i = 0; i < fTrafficLights.size(); i++) ENSURE(fTrafficLights[i]->isGreen() == originalStates[i] || hasChanged[i], "simTrafficLights() postcondition")
@@ -153,12 +411,41 @@ public:
     void simTrafficLights(double &time);
 
     /*
+     * Spawns a vehicle of its type in `types` if the generator is due at `time` and schedules the next one after a
+     * headway drawn with `uniform`, a random number in [0, 1), see VehicleGenerator::drawHeadway().
+     *
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling simGenerator()")
      *
-     * if (spawn) ENSURE(fVehicles.size() == startSize+1, "simGenerator() postcondition")
-     * else ENSURE(fVehicles.size() == startSize, "simGenerator() postcondition")
+     * if (spawn) ENSURE(fVehicles.size() + fEntryQueue.size() == startSize+1, "simGenerator() postcondition")
+     * else ENSURE(fVehicles.size() + fEntryQueue.size() == startSize, "simGenerator() postcondition")
+     */
+    void simGenerator(double &time, double uniform, const VehicleTypeRegistry &types);
+
+    /*
+     * Lets `vehicle`, a new vehicle at the start of this street, arrive at `time`. It gets the next id of the vehicles
+     * generated on this street and joins the entry queue; it enters the street on the lane with the most room as soon
+     * as its rear is far enough from the start, so vehicles never overlap at the start. Its journey starts at `time`,
+     * so the time in the queue counts as delay.
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling spawnVehicle()")
+     * REQUIRE(vehicle->getStreetId() == fId, "The vehicle did not have the same name as the street it was added to")
+     *
+     * ENSURE(fVehicles.size() + fEntryQueue.size() == startSize + 1, "spawnVehicle() postcondition")
+     */
+    void spawnVehicle(Vehicle* vehicle, double time);
+
+    /*
+     * Puts `vehicle`, a new vehicle, at its position on this street at `time`, behind the vehicles in front of it. It
+     * gets the next id of the vehicles generated on this street.
+     *
+     * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling injectVehicle()")
+     * REQUIRE(vehicle->getStreetId() == fId, "The vehicle did not have the same name as the street it was added to")
+     * REQUIRE(vehicle->getPosition() >= 0 && vehicle->getPosition() <= fLength, "The vehicle stands of the road")
+     * REQUIRE(vehicle->getLane() < fLanes, "The vehicle drives on a lane that doesn't exist")
+     *
+     * ENSURE(fVehicles.size() == startSize + 1, "injectVehicle() postcondition")
      */
-    void simGenerator(double &time);
+    void injectVehicle(Vehicle* vehicle, double time);
 
     /*
      * REQUIRE(properlyInitialized(), "Street wasn't initialized when calling simBusStops()")
@@ -5,11 +5,14 @@
 // Description  : This code is contains the `TrafficLight` class
 // ===========================================================
 
+#include <algorithm>
 #include "TrafficLight.h"
 #include "../DesignByContract.h"
+#include "../StringInterner.h"
 #include "../Variables.h"
 
-TrafficLight::TrafficLight(const std::string &street, int position, int cycle) : fStreet(street), fPosition(position), fCycle(cycle) {
+TrafficLight::TrafficLight(const std::string &street, int position, int cycle) : fStreet(StringInterner::streetNames().intern(street)), fPosition(position), fCycle(cycle),
+            fQueueLength(0), fQueueDistance(0), fMaxQueueLength(0), fMaxQueueDistance(0), fSpillback(false) {
     TrafficLight::fIsgreen = true;
     TrafficLight::fLastUpdateTime = 0;
     TrafficLight::_initCheck = this;
@@ -23,6 +26,17 @@ bool TrafficLight::properlyInitialized() const {
     return TrafficLight::_initCheck == this;
 }
 
+TrafficLight *TrafficLight::clone() const {
+    REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling clone()");
+
+    TrafficLight* copy = new TrafficLight(*this);
+    copy->_initCheck = copy;
+
+    ENSURE(copy->properlyInitialized(), "clone() postcondition");
+
+    return copy;
+}
+
 void TrafficLight::setLastUpdateTime(double u) {
     REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling setLastUpdateTime()");
     REQUIRE(u >= 0, "LastUpdateTime must be greater than 0");
@@ -35,7 +49,13 @@ void TrafficLight::setLastUpdateTime(double u) {
 const std::string &TrafficLight::getStreet() const {
     REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getStreet()");
 
-    return TrafficLight::fStreet;
+    return StringInterner::streetNames().getString(fStreet);
+}
+
+unsigned int TrafficLight::getStreetId() const {
+    REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getStreetId()");
+
+    return fStreet;
 }
 
 int TrafficLight::getPosition() const {
@@ -50,6 +70,15 @@ int TrafficLight::getCycle() const {
     return TrafficLight::fCycle;
 }
 
+void TrafficLight::setCycle(int cycle) {
+    REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling setCycle()");
+    REQUIRE(cycle > 0, "The cycle of a traffic light must be greater than 0");
+
+    TrafficLight::fCycle = cycle;
+
+    ENSURE(getCycle() == cycle, "setCycle() postcondition");
+}
+
 bool TrafficLight::isGreen() const {
     REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling isGreen()");
 
@@ -67,3 +96,67 @@ void TrafficLight::changeLight() {
 
     fIsgreen = !fIsgreen;
 }
+
+void TrafficLight::updateQueue(unsigned int length, double distance, double time) {
+    REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling updateQueue()");
+    REQUIRE(distance >= 0, "The queue distance can't be negative");
+    REQUIRE(time >= 0, "The time can't be negative");
+
+    fQueueLength = length;
+    fQueueDistance = distance;
+    fMaxQueueLength = std::max(fMaxQueueLength, length);
+    fMaxQueueDistance = std::max(fMaxQueueDistance, distance);
+
+    unsigned int sample = (unsigned int) (time / gQueueSampleInterval);
+    if (fQueueSamples.size() <= sample) {
+        fQueueSamples.resize(sample + 1, 0);
+    }
+    fQueueSamples[sample] = std::max(fQueueSamples[sample], length);
+
+    ENSURE(getQueueLength() == length, "updateQueue() postcondition");
+    ENSURE(getMaxQueueLength() >= length, "updateQueue() postcondition");
+}
+
+unsigned int TrafficLight::getQueueLength() const {
+    REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getQueueLength()");
+
+    return fQueueLength;
+}
+
+double TrafficLight::getQueueDistance() const {
+    REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getQueueDistance()");
+
+    return fQueueDistance;
+}
+
+unsigned int TrafficLight::getMaxQueueLength() const {
+    REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getMaxQueueLength()");
+
+    return fMaxQueueLength;
+}
+
+double TrafficLight::getMaxQueueDistance() const {
+    REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getMaxQueueDistance()");
+
+    return fMaxQueueDistance;
+}
+
+const std::vector<unsigned int> &TrafficLight::getQueueSamples() const {
+    REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getQueueSamples()");
+
+    return fQueueSamples;
+}
+
+bool TrafficLight::hasSpillback() const {
+    REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling hasSpillback()");
+
+    return fSpillback;
+}
+
+void TrafficLight::setSpillback(bool spillback) {
+    REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling setSpillback()");
+
+    fSpillback = spillback;
+
+    ENSURE(hasSpillback() == spillback, "setSpillback() postcondition");
+}
@@ -9,16 +9,27 @@
 #define PSE_TRAFFICLIGHT_H
 
 #include <iostream>
+#include <vector>
 
 class TrafficLight {
     TrafficLight* _initCheck;
 
-    std::string fStreet;
+    unsigned int fStreet;
     int fPosition;
     int fCycle;
     bool fIsgreen;
     double fLastUpdateTime;
 
+    // The vehicles queued before the light and the distance (in m) from the light to the rear of the last one
+    unsigned int fQueueLength;
+    double fQueueDistance;
+    unsigned int fMaxQueueLength;
+    double fMaxQueueDistance;
+    // The longest queue of every interval of gQueueSampleInterval seconds
+    std::vector<unsigned int> fQueueSamples;
+    // Whether the queue reaches the crossroad upstream of the light
+    bool fSpillback;
+
 public:
     /*
      * ENSURE(properlyInitialized(), "TrafficLight constructor did not end in an initialized state");
@@ -29,6 +40,15 @@ public:
 
     bool properlyInitialized() const;
 
+    /*
+     * Returns a copy of this traffic light that is owned by the caller.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling clone()")
+     *
+     * ENSURE(copy->properlyInitialized(), "clone() postcondition")
+     */
+    TrafficLight* clone() const;
+
     /*
      * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling setLastUpdateTime()")
      * REQUIRE(u >= 0, "LastUpdateTime must be greater than 0")
@@ -42,6 +62,11 @@ public:
      */
     const std::string &getStreet() const;
 
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getStreetId()")
+     */
+    unsigned int getStreetId() const;
+
     /*
      * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getPosition()")
      */
@@ -52,6 +77,14 @@ public:
      */
     int getCycle() const;
 
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling setCycle()")
+     * REQUIRE(cycle > 0, "The cycle of a traffic light must be greater than 0")
+     *
+     * ENSURE(getCycle() == cycle, "setCycle() postcondition")
+     */
+    void setCycle(int cycle);
+
     /*
      * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling isGreen()")
      */
@@ -66,6 +99,56 @@ public:
      * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling changeLight()")
      */
     void changeLight();
+
+    /*
+     * Stores the queue before the light at `time`. The queue of every interval of gQueueSampleInterval seconds is the
+     * longest one stored during that interval.
+     *
+     * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling updateQueue()")
+     * REQUIRE(distance >= 0, "The queue distance can't be negative")
+     * REQUIRE(time >= 0, "The time can't be negative")
+     *
+     * ENSURE(getQueueLength() == length, "updateQueue() postcondition")
+     * ENSURE(getMaxQueueLength() >= length, "updateQueue() postcondition")
+     */
+    void updateQueue(unsigned int length, double distance, double time);
+
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getQueueLength()")
+     */
+    unsigned int getQueueLength() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getQueueDistance()")
+     */
+    double getQueueDistance() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getMaxQueueLength()")
+     */
+    unsigned int getMaxQueueLength() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getMaxQueueDistance()")
+     */
+    double getMaxQueueDistance() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling getQueueSamples()")
+     */
+    const std::vector<unsigned int> &getQueueSamples() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling hasSpillback()")
+     */
+    bool hasSpillback() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "TrafficLight wasn't initialized when calling setSpillback()")
+     *
+     * ENSURE(hasSpillback() == spillback, "setSpillback() postcondition")
+     */
+    void setSpillback(bool spillback);
 };
 
 
@@ -5,11 +5,32 @@
 // Description  : This code is contains the `Vehicle` class
 // ===========================================================
 
+#include <cmath>
 #include "Vehicle.h"
 #include "../DesignByContract.h"
+#include "../Variables.h"
+#include "../StringInterner.h"
 
-Vehicle::Vehicle(const std::string &street, double position) :
-            fStreet(street), fPosition(position), fSpeed(0), fAcceleration(0) {
+Vehicle::Vehicle(const std::string &street, double position, unsigned int type, const VehicleTypeRegistry &types) :
+            fStreet(StringInterner::streetNames().intern(street)), fOrigin(0), fSerial(0), fType(type), fPosition(position), fDestination(0), fHasDestination(false), fLane(0), fPreviousPosition(position), fSpeed(0),
+            fAcceleration(0), fTookTurn(false), fWaitTime(0), fTravelTime(0), fSpawnTime(0), fDistance(0), fStoppedTime(0),
+            fBrakingTime(0) {
+    REQUIRE(type < types.size(), "The vehicle type is not in the registry");
+
+    fParameters = &types.get(type);
+    fMaxSpeed = fParameters->maxSpeed;
+    Vehicle::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "Vehicle constructor did not end in an initialized state");
+}
+
+Vehicle::Vehicle(unsigned int street, double position, unsigned int type, const VehicleTypeRegistry &types) :
+            fStreet(street), fOrigin(0), fSerial(0), fType(type), fPosition(position), fDestination(0), fHasDestination(false), fLane(0), fPreviousPosition(position), fSpeed(0), fAcceleration(0), fTookTurn(false),
+            fWaitTime(0), fTravelTime(0), fSpawnTime(0), fDistance(0), fStoppedTime(0), fBrakingTime(0) {
+    REQUIRE(type < types.size(), "The vehicle type is not in the registry");
+
+    fParameters = &types.get(type);
+    fMaxSpeed = fParameters->maxSpeed;
     Vehicle::_initCheck = this;
 
     ENSURE(properlyInitialized(), "Vehicle constructor did not end in an initialized state");
@@ -21,30 +42,340 @@ bool Vehicle::properlyInitialized() const {
     return Vehicle::_initCheck == this;
 }
 
+Vehicle *Vehicle::clone() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling clone()");
+
+    Vehicle* copy = new Vehicle(*this);
+    copy->_initCheck = copy;
+
+    ENSURE(copy->properlyInitialized(), "clone() postcondition");
+
+    return copy;
+}
+
 const std::string &Vehicle::getStreet() const {
     REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getStreet()");
 
+    return StringInterner::streetNames().getString(fStreet);
+}
+
+unsigned int Vehicle::getStreetId() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getStreetId()");
+
     return fStreet;
 }
 
+void Vehicle::setId(unsigned int origin, unsigned int serial) {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setId()");
+
+    fOrigin = origin;
+    fSerial = serial;
+}
+
+unsigned int Vehicle::getOrigin() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getOrigin()");
+
+    return fOrigin;
+}
+
+unsigned int Vehicle::getSerial() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getSerial()");
+
+    return fSerial;
+}
+
 double Vehicle::getPosition() const {
     REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getPosition()");
 
     return fPosition;
 }
 
+double Vehicle::getPreviousPosition() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getPreviousPosition()");
+
+    return fPreviousPosition;
+}
+
+void Vehicle::setDestination(unsigned int street) {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setDestination()");
+
+    fDestination = street;
+    fHasDestination = true;
+
+    ENSURE(hasDestination(), "setDestination() postcondition");
+    ENSURE(getDestination() == street, "setDestination() postcondition");
+}
+
+bool Vehicle::hasDestination() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling hasDestination()");
+
+    return fHasDestination;
+}
+
+unsigned int Vehicle::getDestination() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getDestination()");
+    REQUIRE(hasDestination(), "The vehicle has no destination");
+
+    return fDestination;
+}
+
+unsigned int Vehicle::getLane() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getLane()");
+
+    return fLane;
+}
+
+void Vehicle::setLane(unsigned int lane) {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setLane()");
+
+    fLane = lane;
+
+    ENSURE(getLane() == lane, "setLane() postcondition");
+}
+
 double Vehicle::getSpeed() const {
     REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getSpeed()");
 
     return fSpeed;
 }
 
+void Vehicle::copyState(VehicleBuffers &buffers, unsigned int index) const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling copyState()");
+    REQUIRE(index < buffers.capacity, "The index is outside of the buffers");
+
+    if (buffers.positions != NULL) {
+        buffers.positions[index] = fPosition;
+    }
+    if (buffers.speeds != NULL) {
+        buffers.speeds[index] = fSpeed;
+    }
+    if (buffers.types != NULL) {
+        buffers.types[index] = fType;
+    }
+    if (buffers.lanes != NULL) {
+        buffers.lanes[index] = fLane;
+    }
+}
+
 double Vehicle::getMaxSpeed() const {
     REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getMaxSpeed()");
 
     return fMaxSpeed;
 }
 
+double Vehicle::getLength() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getLength()");
+
+    return fParameters->length;
+}
+
+unsigned int Vehicle::getVehicleType() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getVehicleType()");
+
+    return fType;
+}
+
+const VehicleType &Vehicle::getParameters() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getParameters()");
+
+    return *fParameters;
+}
+
+void Vehicle::setVehicleTypes(const VehicleTypeRegistry &types) {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setVehicleTypes()");
+    REQUIRE(fType < types.size(), "The vehicle type is not in the registry");
+
+    fParameters = &types.get(fType);
+
+    ENSURE(&getParameters() == &types.get(getVehicleType()), "setVehicleTypes() postcondition");
+}
+
+const std::string &Vehicle::getType() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getType()");
+
+    return fParameters->name;
+}
+
+char Vehicle::getAcronym() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getAcronym()");
+
+    return fParameters->acronym;
+}
+
+void Vehicle::drive(Vehicle *vehicleInFront) {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling drive()");
+
+    double startPosition = fPosition;
+    fPreviousPosition = fPosition;
+    fTravelTime += gSimulationTime;
+    if (fSpeed + (fAcceleration*gSimulationTime) < 0) {
+        fPosition -= pow(fSpeed, 2)/(2*fAcceleration);
+        fSpeed = 0;
+    }
+    else {
+        fSpeed += fAcceleration * gSimulationTime;
+        fPosition += fSpeed * gSimulationTime + fAcceleration*(pow(gSimulationTime, 2)/2);
+    }
+    fDistance += fPosition - startPosition;
+    if (fSpeed < gQueueSpeed) {
+        fStoppedTime += gSimulationTime;
+    }
+    if (fMaxSpeed < fParameters->maxSpeed) {
+        fBrakingTime += gSimulationTime;
+    }
+    fAcceleration = getFollowingAcceleration(vehicleInFront);
+
+    ENSURE(fPosition >= startPosition || std::abs(fPosition-startPosition) < 0.001, "drive() postcondition");
+}
+
+double Vehicle::getFollowingAcceleration(const Vehicle *vehicleInFront) const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getFollowingAcceleration()");
+
+    double delta = 0;
+    if (vehicleInFront != NULL) {
+        double deltaX = vehicleInFront->getPosition() - fPosition - vehicleInFront->getLength();
+        double deltaV = fSpeed - vehicleInFront->getSpeed();
+        delta = (fParameters->minFollowDistance + std::max(0.0, (fSpeed + ((fSpeed * deltaV) / (2 * sqrt(fParameters->maxAcceleration * fParameters->maxBrakeFactor)))))) / deltaX;
+    }
+    return fParameters->maxAcceleration * (1 - pow(fSpeed / fMaxSpeed, 4) - pow(delta, 2));
+}
+
+void Vehicle::advance(double distance) {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling advance()");
+    REQUIRE(distance >= 0, "A vehicle can't advance backwards");
+
+    fTravelTime += gSimulationTime;
+    fPreviousPosition = fPosition;
+    fPosition += distance;
+    fDistance += distance;
+    fSpeed = distance / gSimulationTime;
+    if (fSpeed < gQueueSpeed) {
+        fStoppedTime += gSimulationTime;
+    }
+    fAcceleration = 0;
+
+    ENSURE(getSpeed() == distance / gSimulationTime, "advance() postcondition");
+}
+
+void Vehicle::brake() {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling brake()");
+
+    double startMaxSpeed = fMaxSpeed;
+    fMaxSpeed = gSlowFactor * fParameters->maxSpeed;
+    if (fMaxSpeed == 0) {
+        fMaxSpeed = 0.0000000000000000000001;
+    }
+
+    ENSURE(fMaxSpeed <= fParameters->maxSpeed, "brake() postcondition");
+    ENSURE(fMaxSpeed <= startMaxSpeed, "brake() postcondition");
+}
+
+void Vehicle::stop() {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling stop()");
+
+    double startAcceleration = fAcceleration;
+    fAcceleration = -((fParameters->maxBrakeFactor * fSpeed) / fMaxSpeed);
+
+    ENSURE(fAcceleration <= startAcceleration, "stop() postcondition");
+}
+
+void Vehicle::setMaxSpeed() {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setMaxSpeed()");
+
+    fMaxSpeed = fParameters->maxSpeed;
+}
+
+bool Vehicle::hasPriority() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling hasPriority()");
+
+    return fParameters->priority;
+}
+
+bool Vehicle::stopsAtBusStops() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling stopsAtBusStops()");
+
+    return fParameters->stopsAtBusStops;
+}
+
+double Vehicle::getWaitTime() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getWaitTime()");
+
+    return fWaitTime;
+}
+
+void Vehicle::addWaitTime(double time) {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling addWaitTime()");
+
+    fWaitTime += time;
+}
+
+void Vehicle::clearWaitTime() {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling clearWaitTime()");
+
+    fWaitTime = 0;
+}
+
+double Vehicle::getTravelTime() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getTravelTime()");
+
+    return fTravelTime;
+}
+
+void Vehicle::setTravelTime(double time) {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setTravelTime()");
+    REQUIRE(time >= 0, "The travel time can't be negative");
+
+    fTravelTime = time;
+}
+
+double Vehicle::getSpawnTime() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getSpawnTime()");
+
+    return fSpawnTime;
+}
+
+void Vehicle::setSpawnTime(double time) {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setSpawnTime()");
+    REQUIRE(time >= 0, "The spawn time can't be negative");
+
+    fSpawnTime = time;
+}
+
+double Vehicle::getDistance() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getDistance()");
+
+    return fDistance;
+}
+
+double Vehicle::getStoppedTime() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getStoppedTime()");
+
+    return fStoppedTime;
+}
+
+double Vehicle::getBrakingTime() const {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getBrakingTime()");
+
+    return fBrakingTime;
+}
+
+void Vehicle::continueJourney(const Vehicle &vehicle) {
+    REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling continueJourney()");
+    REQUIRE(vehicle.properlyInitialized(), "The other vehicle wasn't initialized when calling continueJourney()");
+
+    fOrigin = vehicle.fOrigin;
+    fSerial = vehicle.fSerial;
+    fDestination = vehicle.fDestination;
+    fHasDestination = vehicle.fHasDestination;
+    fSpawnTime = vehicle.fSpawnTime;
+    fTravelTime = vehicle.fTravelTime;
+    fDistance = vehicle.fDistance;
+    fStoppedTime = vehicle.fStoppedTime;
+    fBrakingTime = vehicle.fBrakingTime;
+
+    ENSURE(getTravelTime() == vehicle.getTravelTime(), "continueJourney() postcondition");
+}
+
 bool Vehicle::hasTurned() {
     REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling hasTurned()");
 
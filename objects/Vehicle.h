@@ -9,69 +9,350 @@
 #define PSE_VEHICLE_H
 
 #include <iostream>
+#include "VehicleType.h"
+
+// Arrays of the caller that a bulk query fills, arrays that are NULL are skipped
+struct VehicleBuffers {
+    double* positions;
+    double* speeds;
+    // Index of the street in TrafficSimulation::getStreets()
+    unsigned int* streets;
+    unsigned int* types;
+    unsigned int* lanes;
+    // Amount of elements of every array that isn't NULL
+    unsigned int capacity;
+};
 
 class Vehicle {
 protected:
     Vehicle* _initCheck;
 
-    std::string fStreet;
+    unsigned int fStreet;
+    // Identifies the vehicle within its simulation, see setId()
+    unsigned int fOrigin;
+    unsigned int fSerial;
+    unsigned int fType;
+    // Entry of `fType` in the registry, kept so the per-tick functions don't have to look it up
+    const VehicleType* fParameters;
     double fPosition;
+    // Index (Street::getIndex()) of the street on which the vehicle wants to leave the network, only used if
+    // fHasDestination
+    unsigned int fDestination;
+    bool fHasDestination;
+    // Lane of the vehicle on a street with several lanes, 0 is the rightmost lane
+    unsigned int fLane;
+    // Position before the last call to drive() or advance()
+    double fPreviousPosition;
 
     double fSpeed;
     double fAcceleration;
     double fMaxSpeed;
-    double fTookTurn;
+    bool fTookTurn;
+    double fWaitTime;
+    // Time since the vehicle entered the network, it is carried over when the vehicle turns onto another street
+    double fTravelTime;
+    // The rest of its journey, carried over in the same way
+    double fSpawnTime;
+    double fDistance;
+    double fStoppedTime;
+    double fBrakingTime;
 public:
     /*
+     * The parameters of `type` are looked up in `types`, the registry of the simulation the vehicle belongs to, which
+     * must outlive the vehicle.
+     *
+     * REQUIRE(type < types.size(), "The vehicle type is not in the registry")
+     *
      * ENSURE(properlyInitialized(), "Vehicle constructor did not end in an initialized state")
      */
-    Vehicle(const std::string &street, double position);
+    Vehicle(const std::string &street, double position, unsigned int type,
+            const VehicleTypeRegistry &types = VehicleTypeRegistry::builtInTypes());
+
+    /*
+     * REQUIRE(type < types.size(), "The vehicle type is not in the registry")
+     *
+     * ENSURE(properlyInitialized(), "Vehicle constructor did not end in an initialized state")
+     */
+    Vehicle(unsigned int street, double position, unsigned int type,
+            const VehicleTypeRegistry &types = VehicleTypeRegistry::builtInTypes());
 
     virtual ~Vehicle();
 
-    virtual bool properlyInitialized() const;
+    bool properlyInitialized() const;
+
+    /*
+     * Returns a copy of this vehicle that is owned by the caller.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling clone()")
+     *
+     * ENSURE(copy->properlyInitialized(), "clone() postcondition")
+     */
+    Vehicle* clone() const;
 
     /*
      * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getStreet()")
      */
     const std::string &getStreet() const;
 
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getStreetId()")
+     */
+    unsigned int getStreetId() const;
+
+    /*
+     * The origin is 0 for vehicles from the simulation file and the street index + 1 for vehicles from a generator, the
+     * serial counts the vehicles of the same origin. A vehicle keeps its id when it turns onto another street.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setId()")
+     */
+    void setId(unsigned int origin, unsigned int serial);
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getOrigin()")
+     */
+    unsigned int getOrigin() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getSerial()")
+     */
+    unsigned int getSerial() const;
+
     /*
      * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getPosition()")
      */
     double getPosition() const;
 
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getPreviousPosition()")
+     */
+    double getPreviousPosition() const;
+
+    /*
+     * Makes the vehicle follow the shortest route to the end of the street with index `street` (Street::getIndex()) at
+     * the crossroads.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setDestination()")
+     *
+     * ENSURE(hasDestination(), "setDestination() postcondition")
+     * ENSURE(getDestination() == street, "setDestination() postcondition")
+     */
+    void setDestination(unsigned int street);
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling hasDestination()")
+     */
+    bool hasDestination() const;
+
+    /*
+     * Returns the index of the destination street.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getDestination()")
+     * REQUIRE(hasDestination(), "The vehicle has no destination")
+     */
+    unsigned int getDestination() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getLane()")
+     */
+    unsigned int getLane() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setLane()")
+     *
+     * ENSURE(getLane() == lane, "setLane() postcondition")
+     */
+    void setLane(unsigned int lane);
+
     /*
      * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getPosition()")
      */
     double getSpeed() const;
 
+    /*
+     * Writes the position, speed, type and lane of the vehicle at `index` of the arrays of `buffers` that aren't NULL.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling copyState()")
+     * REQUIRE(index < buffers.capacity, "The index is outside of the buffers")
+     */
+    void copyState(VehicleBuffers &buffers, unsigned int index) const;
+
     /*
      * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getMaxSpeed()")
      */
     double getMaxSpeed() const;
 
-    virtual double getLength() const = 0;
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getLength()")
+     */
+    double getLength() const;
 
-    virtual std::string getType() const = 0;
+    /*
+     * Returns the index of the type in the registry of its simulation, the built-in types have the values of
+     * `EVehicleType`.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getVehicleType()")
+     */
+    unsigned int getVehicleType() const;
 
-    virtual char getAcronym() const = 0;
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getParameters()")
+     */
+    const VehicleType &getParameters() const;
 
-    virtual void drive(Vehicle* vehicleInFront) = 0;
+    /*
+     * Takes the parameters of its type from `types` from now on, for a copy of a simulation with a copy of its registry.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setVehicleTypes()")
+     * REQUIRE(getVehicleType() < types.size(), "The vehicle type is not in the registry")
+     *
+     * ENSURE(&getParameters() == &types.get(getVehicleType()), "setVehicleTypes() postcondition")
+     */
+    void setVehicleTypes(const VehicleTypeRegistry &types);
 
-    virtual void brake() = 0;
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getType()")
+     */
+    const std::string &getType() const;
 
-    virtual void stop() = 0;
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getAcronym()")
+     */
+    char getAcronym() const;
 
-    virtual void setMaxSpeed() = 0;
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling drive()")
+     *
+     * ENSURE(fPosition >= startPosition || std::abs(fPosition-startPosition) < 0.001, "drive() postcondition")
+     */
+    void drive(Vehicle* vehicleInFront);
 
-    virtual bool hasPriority() const = 0;
+    /*
+     * Returns the acceleration the driving model gives the vehicle behind `vehicleInFront`, NULL for a free road,
+     * without changing the vehicle. Used to weigh lane changes.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getFollowingAcceleration()")
+     */
+    double getFollowingAcceleration(const Vehicle* vehicleInFront) const;
+
+    /*
+     * Moves the vehicle `distance` forward at a constant speed during one tick, without the driving model. Used for
+     * the mesoscopic part of a street.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling advance()")
+     * REQUIRE(distance >= 0, "A vehicle can't advance backwards")
+     *
+     * ENSURE(getSpeed() == distance / gSimulationTime, "advance() postcondition")
+     */
+    void advance(double distance);
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling brake()")
+     *
+     * ENSURE(fMaxSpeed <= fParameters->maxSpeed, "brake() postcondition");
+     * ENSURE(fMaxSpeed <= startMaxSpeed, "brake() postcondition");
+     */
+    void brake();
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling stop()")
+     *
+     * ENSURE(fAcceleration <= startAcceleration, "stop() postcondition")
+     */
+    void stop();
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setMaxSpeed()")
+     */
+    void setMaxSpeed();
 
-    virtual bool hasTurned();
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling hasPriority()")
+     */
+    bool hasPriority() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling stopsAtBusStops()")
+     */
+    bool stopsAtBusStops() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getWaitTime()")
+     */
+    double getWaitTime() const;
 
-    virtual void setTurn(bool state);
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling addWaitTime()")
+     */
+    void addWaitTime(double time);
 
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling clearWaitTime()")
+     */
+    void clearWaitTime();
 
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getTravelTime()")
+     */
+    double getTravelTime() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setTravelTime()")
+     * REQUIRE(time >= 0, "The travel time can't be negative")
+     */
+    void setTravelTime(double time);
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getSpawnTime()")
+     */
+    double getSpawnTime() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setSpawnTime()")
+     * REQUIRE(time >= 0, "The spawn time can't be negative")
+     */
+    void setSpawnTime(double time);
+
+    /*
+     * Returns the distance (in m) driven since the vehicle entered the network.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getDistance()")
+     */
+    double getDistance() const;
+
+    /*
+     * Returns the time the vehicle drove slower than `gQueueSpeed`.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getStoppedTime()")
+     */
+    double getStoppedTime() const;
+
+    /*
+     * Returns the time the vehicle was slowed down by a traffic light or bus stop.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling getBrakingTime()")
+     */
+    double getBrakingTime() const;
+
+    /*
+     * Continues the journey of `vehicle` with this vehicle, used when a vehicle turns onto another street. The id,
+     * spawn time, travel time, distance, stopped time and braking time are copied.
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling continueJourney()")
+     * REQUIRE(vehicle.properlyInitialized(), "The other vehicle wasn't initialized when calling continueJourney()")
+     *
+     * ENSURE(getTravelTime() == vehicle.getTravelTime(), "continueJourney() postcondition")
+     */
+    void continueJourney(const Vehicle &vehicle);
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling hasTurned()")
+     */
+    bool hasTurned();
+
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle wasn't initialized when calling setTurn()")
+     */
+    void setTurn(bool state);
 };
 
 
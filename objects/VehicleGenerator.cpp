@@ -5,11 +5,19 @@
 // Description  : This code is contains the `VehicleGenerator` class
 // ===========================================================
 
+#include <cmath>
+#include <algorithm>
 #include "VehicleGenerator.h"
 #include "../DesignByContract.h"
+#include "../StringInterner.h"
 
 VehicleGenerator::VehicleGenerator(const std::string &street, int frequency, const std::string &type) :
-            fStreet(street), fFrequency(frequency), fType(type), fTimeSinceLastSpawn(0) {
+            fStreet(StringInterner::streetNames().intern(street)), fFrequency(frequency), fType(type), fTimeSinceLastSpawn(0),
+            fDestination(0), fHasDestination(false), fArrivalProcess(DeterministicArrivals), fTotalWeight(0) {
+    // Unknown types have always been generated as police cars
+    if (!VehicleTypeRegistry::builtInTypes().find(type, fVehicleType)) {
+        fVehicleType = PoliceCarVehicle;
+    }
     VehicleGenerator::_initCheck = this;
 
     ENSURE(properlyInitialized(), "VehicleGenerator constructor did not end in an initialized state");
@@ -21,12 +29,23 @@ bool VehicleGenerator::properlyInitialized() const {
     return VehicleGenerator::_initCheck == this;
 }
 
+VehicleGenerator *VehicleGenerator::clone() const {
+    REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling clone()");
+
+    VehicleGenerator* copy = new VehicleGenerator(*this);
+    copy->_initCheck = copy;
+
+    ENSURE(copy->properlyInitialized(), "clone() postcondition");
+
+    return copy;
+}
+
 void VehicleGenerator::setStreet(const std::string &s) {
     REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling setStreet()");
 
-    fStreet = s;
+    fStreet = StringInterner::streetNames().intern(s);
 
-    ENSURE(fStreet == s, "setStreet() postcondition");
+    ENSURE(getStreet() == s, "setStreet() postcondition");
 }
 
 void VehicleGenerator::setFrequency(int f) {
@@ -49,6 +68,12 @@ void VehicleGenerator::setTimeSinceLastSpawn(double t) {
 const std::string &VehicleGenerator::getStreet() const {
     REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getStreet()");
 
+    return StringInterner::streetNames().getString(fStreet);
+}
+
+unsigned int VehicleGenerator::getStreetId() const {
+    REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getStreetId()");
+
     return fStreet;
 }
 
@@ -64,8 +89,105 @@ const std::string &VehicleGenerator::getType() const {
     return fType;
 }
 
+unsigned int VehicleGenerator::getVehicleType() const {
+    REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getVehicleType()");
+
+    return fVehicleType;
+}
+
+void VehicleGenerator::setVehicleType(unsigned int type) {
+    REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling setVehicleType()");
+
+    fVehicleType = type;
+
+    ENSURE(getVehicleType() == type, "setVehicleType() postcondition");
+}
+
 double VehicleGenerator::getTimeSinceLastSpawn() const {
     REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getTimeSinceLastSpawn()");
 
     return fTimeSinceLastSpawn;
 }
+
+void VehicleGenerator::setDestination(unsigned int street) {
+    REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling setDestination()");
+
+    fDestination = street;
+    fHasDestination = true;
+
+    ENSURE(hasDestination(), "setDestination() postcondition");
+    ENSURE(getDestination() == street, "setDestination() postcondition");
+}
+
+bool VehicleGenerator::hasDestination() const {
+    REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling hasDestination()");
+
+    return fHasDestination;
+}
+
+unsigned int VehicleGenerator::getDestination() const {
+    REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getDestination()");
+    REQUIRE(hasDestination(), "The generator has no destination");
+
+    return fDestination;
+}
+
+void VehicleGenerator::setArrivalProcess(EArrivalProcess process) {
+    REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling setArrivalProcess()");
+
+    fArrivalProcess = process;
+
+    ENSURE(getArrivalProcess() == process, "setArrivalProcess() postcondition");
+}
+
+EArrivalProcess VehicleGenerator::getArrivalProcess() const {
+    REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getArrivalProcess()");
+
+    return fArrivalProcess;
+}
+
+void VehicleGenerator::addHeadwayBin(double from, double to, double weight) {
+    REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling addHeadwayBin()");
+    REQUIRE(from >= 0 && to > from, "The bin must end after it starts");
+    REQUIRE(weight > 0, "The weight of a bin must be greater than 0");
+
+    HeadwayBin bin;
+    bin.from = from;
+    bin.to = to;
+    bin.weight = weight;
+    fHeadwayBins.push_back(bin);
+    fTotalWeight += weight;
+
+    ENSURE(getHeadwayBins().back().weight == weight, "addHeadwayBin() postcondition");
+}
+
+const std::vector<HeadwayBin> &VehicleGenerator::getHeadwayBins() const {
+    REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getHeadwayBins()");
+
+    return fHeadwayBins;
+}
+
+double VehicleGenerator::drawHeadway(double uniform) const {
+    REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling drawHeadway()");
+    REQUIRE(uniform >= 0 && uniform < 1, "The random number must be in [0, 1)");
+    REQUIRE(fArrivalProcess != EmpiricalArrivals || !fHeadwayBins.empty(), "An empirical generator needs a histogram");
+
+    double headway = fFrequency;
+    if (fArrivalProcess == PoissonArrivals) {
+        headway = -fFrequency * log(1 - uniform);
+    } else if (fArrivalProcess == EmpiricalArrivals) {
+        // The bin in which `uniform` falls on the cumulative weights, and the same fraction of that bin
+        double target = uniform * fTotalWeight;
+        unsigned int i = 0;
+        while (i + 1 < fHeadwayBins.size() && target >= fHeadwayBins[i].weight) {
+            target -= fHeadwayBins[i].weight;
+            i++;
+        }
+        double fraction = std::min(1.0, target / fHeadwayBins[i].weight);
+        headway = fHeadwayBins[i].from + fraction * (fHeadwayBins[i].to - fHeadwayBins[i].from);
+    }
+
+    ENSURE(headway >= 0, "drawHeadway() postcondition");
+
+    return headway;
+}
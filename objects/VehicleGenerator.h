@@ -9,14 +9,41 @@
 #define PSE_VEHICLEGENERATOR_H
 
 #include <iostream>
+#include <vector>
+#include "VehicleType.h"
+
+// How the time between two generated vehicles is chosen
+enum EArrivalProcess {
+    // Exactly the frequency
+    DeterministicArrivals,
+    // Exponentially distributed with the frequency as mean
+    PoissonArrivals,
+    // Drawn from a histogram of measured headways
+    EmpiricalArrivals
+};
+
+struct HeadwayBin {
+    // Range of the headways (in s) in the bin
+    double from;
+    double to;
+    // Relative amount of headways in the bin
+    double weight;
+};
 
 class VehicleGenerator {
     VehicleGenerator* _initCheck;
 
-    std::string fStreet;
+    unsigned int fStreet;
     int fFrequency;
     std::string fType;
+    unsigned int fVehicleType;
     double fTimeSinceLastSpawn;
+    // Index (Street::getIndex()) of the destination street of the generated vehicles, only used if fHasDestination
+    unsigned int fDestination;
+    bool fHasDestination;
+    EArrivalProcess fArrivalProcess;
+    std::vector<HeadwayBin> fHeadwayBins;
+    double fTotalWeight;
 
 public:
     /*
@@ -28,10 +55,19 @@ public:
 
     bool properlyInitialized() const;
 
+    /*
+     * Returns a copy of this generator that is owned by the caller.
+     *
+     * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling clone()")
+     *
+     * ENSURE(copy->properlyInitialized(), "clone() postcondition")
+     */
+    VehicleGenerator* clone() const;
+
     /*
      * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling setStreet()")
      *
-     * ENSURE(VehicleGenerator::fStreet == s, "setStreet() postcondition")
+     * ENSURE(getStreet() == s, "setStreet() postcondition")
      */
     void setStreet(const std::string &s);
 
@@ -55,6 +91,11 @@ public:
      */
     const std::string &getStreet() const;
 
+    /*
+     * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getStreetId()")
+     */
+    unsigned int getStreetId() const;
+
     /*
      * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getFrequency()")
      */
@@ -65,10 +106,87 @@ public:
      */
     const std::string &getType() const;
 
+    /*
+     * Returns the index of the generated type in the registry of its simulation.
+     *
+     * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getVehicleType()")
+     */
+    unsigned int getVehicleType() const;
+
+    /*
+     * Generates the type with index `type` in the registry of its simulation, for a type that isn't built in.
+     *
+     * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling setVehicleType()")
+     *
+     * ENSURE(getVehicleType() == type, "setVehicleType() postcondition")
+     */
+    void setVehicleType(unsigned int type);
+
     /*
      * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getTimeSinceLastSpawn()")
      */
     double getTimeSinceLastSpawn() const;
+
+    /*
+     * Gives every generated vehicle the street with index `street` (Street::getIndex()) as its destination.
+     *
+     * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling setDestination()")
+     *
+     * ENSURE(hasDestination(), "setDestination() postcondition")
+     * ENSURE(getDestination() == street, "setDestination() postcondition")
+     */
+    void setDestination(unsigned int street);
+
+    /*
+     * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling hasDestination()")
+     */
+    bool hasDestination() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getDestination()")
+     * REQUIRE(hasDestination(), "The generator has no destination")
+     */
+    unsigned int getDestination() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling setArrivalProcess()")
+     *
+     * ENSURE(getArrivalProcess() == process, "setArrivalProcess() postcondition")
+     */
+    void setArrivalProcess(EArrivalProcess process);
+
+    /*
+     * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getArrivalProcess()")
+     */
+    EArrivalProcess getArrivalProcess() const;
+
+    /*
+     * Adds a bin to the histogram of the headways of an empirical arrival process.
+     *
+     * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling addHeadwayBin()")
+     * REQUIRE(from >= 0 && to > from, "The bin must end after it starts")
+     * REQUIRE(weight > 0, "The weight of a bin must be greater than 0")
+     *
+     * ENSURE(getHeadwayBins().back().weight == weight, "addHeadwayBin() postcondition")
+     */
+    void addHeadwayBin(double from, double to, double weight);
+
+    /*
+     * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling getHeadwayBins()")
+     */
+    const std::vector<HeadwayBin> &getHeadwayBins() const;
+
+    /*
+     * Returns the time (in s) until the next vehicle, for `uniform`, a random number in [0, 1). A deterministic
+     * generator ignores it, the other processes turn it into a headway by inverting their distribution.
+     *
+     * REQUIRE(properlyInitialized(), "VehicleGenerator wasn't initialized when calling drawHeadway()")
+     * REQUIRE(uniform >= 0 && uniform < 1, "The random number must be in [0, 1)")
+     * REQUIRE(getArrivalProcess() != EmpiricalArrivals || !getHeadwayBins().empty(), "An empirical generator needs a histogram")
+     *
+     * ENSURE(headway >= 0, "drawHeadway() postcondition")
+     */
+    double drawHeadway(double uniform) const;
 };
 
 
@@ -0,0 +1,136 @@
+// ===========================================================
+// Name         : VehicleType.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `VehicleType` parameters and the `VehicleTypeRegistry` that holds the
+//                built-in types and the types that were defined in the file of a simulation
+// ===========================================================
+
+#include "VehicleType.h"
+#include "../DesignByContract.h"
+#include "vehicles/Car.h"
+#include "vehicles/Bus.h"
+#include "vehicles/FireEngine.h"
+#include "vehicles/Ambulance.h"
+#include "vehicles/PoliceCar.h"
+
+namespace {
+    VehicleType makeType(const char* xmlName, const char* name, const char* visualizerName, char acronym,
+                         double length, double maxSpeed, double maxAcceleration, double maxBrakeFactor,
+                         double minFollowDistance, bool priority, bool stopsAtBusStops,
+                         unsigned char r, unsigned char g, unsigned char b) {
+        VehicleType type;
+        type.xmlName = xmlName;
+        type.name = name;
+        type.visualizerName = visualizerName;
+        type.acronym = acronym;
+        type.length = length;
+        type.maxSpeed = maxSpeed;
+        type.maxAcceleration = maxAcceleration;
+        type.maxBrakeFactor = maxBrakeFactor;
+        type.minFollowDistance = minFollowDistance;
+        type.priority = priority;
+        type.stopsAtBusStops = stopsAtBusStops;
+        type.color[0] = r;
+        type.color[1] = g;
+        type.color[2] = b;
+        return type;
+    }
+}
+
+bool VehicleType::operator==(const VehicleType &other) const {
+    return xmlName == other.xmlName && name == other.name && visualizerName == other.visualizerName
+           && acronym == other.acronym && length == other.length && maxSpeed == other.maxSpeed
+           && maxAcceleration == other.maxAcceleration && maxBrakeFactor == other.maxBrakeFactor
+           && minFollowDistance == other.minFollowDistance && priority == other.priority
+           && stopsAtBusStops == other.stopsAtBusStops && color[0] == other.color[0]
+           && color[1] == other.color[1] && color[2] == other.color[2];
+}
+
+VehicleTypeRegistry::VehicleTypeRegistry() {
+    VehicleTypeRegistry::_initCheck = this;
+
+    // Same order as `EVehicleType`
+    unsigned int type;
+    add(makeType("auto", "Car", "car", 'A', carLength, carMaxSpeed, carMaxAcceleration, carMaxBrakeFactor,
+                 carMinFollowDistance, false, false, 0, 0, 0), type);
+    add(makeType("bus", "Bus", "bus", 'B', busLength, busMaxSpeed, busMaxAcceleration, busMaxBrakeFactor,
+                 busMinFollowDistance, false, true, 0, 255, 0), type);
+    add(makeType("brandweerwagen", "FireEngine", "firetruck", 'F', fireEngineLength, fireEngineMaxSpeed,
+                 fireEngineMaxAcceleration, fireEngineMaxBrakeFactor, fireEngineMinFollowDistance, true, false,
+                 255, 0, 0), type);
+    add(makeType("ziekenwagen", "Ambulance", "ambulance", 'Z', ambulanceLength, ambulanceMaxSpeed,
+                 ambulanceMaxAcceleration, ambulanceMaxBrakeFactor, ambulanceMinFollowDistance, true, false,
+                 255, 255, 255), type);
+    add(makeType("politiecombi", "PoliceCar", "police_cruiser", 'P', policeCarLength, policeCarMaxSpeed,
+                 policeCarMaxAcceleration, policeCarMaxBrakeFactor, policeCarMinFollowDistance, true, false,
+                 0, 0, 255), type);
+
+    ENSURE(size() == gVehicleTypeCount, "VehicleTypeRegistry constructor did not load the built-in types");
+    ENSURE(properlyInitialized(), "VehicleTypeRegistry constructor did not end in an initialized state");
+}
+
+VehicleTypeRegistry::~VehicleTypeRegistry() {}
+
+bool VehicleTypeRegistry::properlyInitialized() const {
+    return VehicleTypeRegistry::_initCheck == this;
+}
+
+VehicleTypeRegistry *VehicleTypeRegistry::clone() const {
+    REQUIRE(properlyInitialized(), "VehicleTypeRegistry wasn't initialized when calling clone()");
+
+    VehicleTypeRegistry* copy = new VehicleTypeRegistry(*this);
+    copy->_initCheck = copy;
+
+    ENSURE(copy->properlyInitialized(), "clone() postcondition");
+    ENSURE(copy->size() == size(), "clone() postcondition");
+
+    return copy;
+}
+
+const VehicleTypeRegistry &VehicleTypeRegistry::builtInTypes() {
+    static const VehicleTypeRegistry registry;
+    return registry;
+}
+
+bool VehicleTypeRegistry::add(const VehicleType &parameters, unsigned int &type) {
+    REQUIRE(properlyInitialized(), "VehicleTypeRegistry wasn't initialized when calling add()");
+    REQUIRE(parameters.length > 0 && parameters.maxSpeed > 0, "The vehicle type has no length or maximum speed");
+    REQUIRE(parameters.maxAcceleration > 0 && parameters.maxBrakeFactor > 0, "The vehicle type can't accelerate or brake");
+
+    std::map<std::string, unsigned int>::iterator it = fIndices.find(parameters.xmlName);
+    if (it != fIndices.end()) {
+        type = it->second;
+        return fTypes[type] == parameters;
+    }
+    type = fTypes.size();
+    fTypes.push_back(parameters);
+    fIndices.insert(std::make_pair(parameters.xmlName, type));
+
+    return true;
+}
+
+bool VehicleTypeRegistry::find(const std::string &xmlName, unsigned int &type) const {
+    REQUIRE(properlyInitialized(), "VehicleTypeRegistry wasn't initialized when calling find()");
+
+    std::map<std::string, unsigned int>::const_iterator it = fIndices.find(xmlName);
+    if (it == fIndices.end()) {
+        return false;
+    }
+    type = it->second;
+
+    return true;
+}
+
+const VehicleType &VehicleTypeRegistry::get(unsigned int type) const {
+    REQUIRE(properlyInitialized(), "VehicleTypeRegistry wasn't initialized when calling get()");
+    REQUIRE(type < size(), "The type is not in the VehicleTypeRegistry");
+
+    return fTypes[type];
+}
+
+unsigned int VehicleTypeRegistry::size() const {
+    REQUIRE(properlyInitialized(), "VehicleTypeRegistry wasn't initialized when calling size()");
+
+    return fTypes.size();
+}
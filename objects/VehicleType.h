@@ -0,0 +1,117 @@
+// ===========================================================
+// Name         : VehicleType.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `VehicleType` parameters and the `VehicleTypeRegistry` that holds the
+//                built-in types and the types that were defined in the file of a simulation
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_VEHICLETYPE_H
+#define TRAFFICSIMULATION_VEHICLETYPE_H
+
+#include <iostream>
+#include <map>
+#include <deque>
+
+// Indices of the built-in types in every registry
+enum EVehicleType {
+    CarVehicle,
+    BusVehicle,
+    FireEngineVehicle,
+    AmbulanceVehicle,
+    PoliceCarVehicle
+};
+
+const unsigned int gVehicleTypeCount = 5;
+
+struct VehicleType {
+    // Name used in the <type> of the XML files
+    std::string xmlName;
+    // Name returned by getType()
+    std::string name;
+    // Name used by the visualizer
+    std::string visualizerName;
+    char acronym;
+
+    double length;
+    double maxSpeed;
+    double maxAcceleration;
+    double maxBrakeFactor;
+    double minFollowDistance;
+    bool priority;
+    bool stopsAtBusStops;
+
+    // Color in the images, as red, green and blue
+    unsigned char color[3];
+
+    bool operator==(const VehicleType &other) const;
+};
+
+/*
+ * Every simulation has its own registry, so the types of one simulation file don't change the types or their indices
+ * in another one. Vehicles that don't belong to a simulation use builtInTypes().
+ */
+class VehicleTypeRegistry {
+    VehicleTypeRegistry* _initCheck;
+
+    std::map<std::string, unsigned int> fIndices;
+    // A deque never moves its elements, so vehicles can keep a pointer to their type
+    std::deque<VehicleType> fTypes;
+
+public:
+    /*
+     * ENSURE(size() == gVehicleTypeCount, "VehicleTypeRegistry constructor did not load the built-in types")
+     * ENSURE(properlyInitialized(), "VehicleTypeRegistry constructor did not end in an initialized state")
+     */
+    VehicleTypeRegistry();
+
+    virtual ~VehicleTypeRegistry();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Returns a copy of the registry with the same types and indices that is owned by the caller.
+     *
+     * REQUIRE(properlyInitialized(), "VehicleTypeRegistry wasn't initialized when calling clone()")
+     *
+     * ENSURE(copy->properlyInitialized(), "clone() postcondition")
+     * ENSURE(copy->size() == size(), "clone() postcondition")
+     */
+    VehicleTypeRegistry* clone() const;
+
+    /*
+     * A registry with only the built-in types, which never changes.
+     */
+    static const VehicleTypeRegistry &builtInTypes();
+
+    /*
+     * Adds a type and returns its index in `type`. Adding a type that already exists with the same parameters returns
+     * the existing index, false is returned if the name is already taken by other parameters.
+     *
+     * REQUIRE(properlyInitialized(), "VehicleTypeRegistry wasn't initialized when calling add()")
+     * REQUIRE(parameters.length > 0 && parameters.maxSpeed > 0, "The vehicle type has no length or maximum speed")
+     * REQUIRE(parameters.maxAcceleration > 0 && parameters.maxBrakeFactor > 0, "The vehicle type can't accelerate or brake")
+     */
+    bool add(const VehicleType &parameters, unsigned int &type);
+
+    /*
+     * Looks up the type that belongs to the name used in the XML files, returns false if there is no such type.
+     *
+     * REQUIRE(properlyInitialized(), "VehicleTypeRegistry wasn't initialized when calling find()")
+     */
+    bool find(const std::string &xmlName, unsigned int &type) const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "VehicleTypeRegistry wasn't initialized when calling get()")
+     * REQUIRE(type < size(), "The type is not in the VehicleTypeRegistry")
+     */
+    const VehicleType &get(unsigned int type) const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "VehicleTypeRegistry wasn't initialized when calling size()")
+     */
+    unsigned int size() const;
+};
+
+
+#endif
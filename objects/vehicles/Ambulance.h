@@ -16,62 +16,19 @@ const double ambulanceMaxAcceleration = 1.44;
 const double ambulanceMaxBrakeFactor = 4.47;
 const double ambulanceMinFollowDistance = 8.0;
 
-class Ambulance : public Vehicle{
-    Ambulance* _initCheck;
-
+class Ambulance : public Vehicle {
 public:
-    Ambulance(const std::string &street, double position);
-
-    ~Ambulance();
-
-    bool properlyInitialized() const;
-
     /*
-     * REQUIRE(properlyInitialized(), "Ambulance wasn't initialized when calling getLength()")
+     * ENSURE(properlyInitialized(), "Ambulance constructor did not end in an initialized state")
      */
-    double getLength() const;
-
-    /*
-     * REQUIRE(properlyInitialized(), "Ambulance wasn't initialized when calling getType()")
-     */
-    std::string getType() const;
-
-    /*
-     * REQUIRE(properlyInitialized(), "Ambulance wasn't initialized when calling getAcronym()")
-     */
-    char getAcronym() const;
-
-    /*
-     * REQUIRE(properlyInitialized(), "Ambulance wasn't initialized when calling getMinFollowDistance()")
-     *
-     * ENSURE(fPosition >= startPosition || std::abs(fPosition-startPosition) < 0.001, "drive() postcondition")
-     */
-    void drive(Vehicle* vehicleInFront);
-
-    /*
-     * REQUIRE(properlyInitialized(), "Ambulance wasn't initialized when calling getMinFollowDistance()")
-     *
-     * ENSURE(fMaxSpeed <= ambulanceMaxSpeed, "brake() postcondition")
-     * ENSURE(fMaxSpeed <= startMaxSpeed, "brake() postcondition")
-     */
-    void brake();
-
-    /*
-     * REQUIRE(properlyInitialized(), "Ambulance wasn't initialized when calling getMinFollowDistance()")
-     *
-     * ENSURE (fAcceleration <= startAcceleration, "stop() postcondition")
-     */
-    void stop();
+    Ambulance(const std::string &street, double position);
 
     /*
-     * REQUIRE(properlyInitialized(), "Ambulance wasn't initialized when calling getMinFollowDistance()")
+     * ENSURE(properlyInitialized(), "Ambulance constructor did not end in an initialized state")
      */
-    void setMaxSpeed();
+    Ambulance(unsigned int street, double position);
 
-    /*
-     * REQUIRE(properlyInitialized(), "Ambulance wasn't initialized when calling getMinFollowDistance()")
-     */
-    bool hasPriority() const;
+    ~Ambulance();
 };
 
 
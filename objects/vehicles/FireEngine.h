@@ -16,65 +16,19 @@ const double fireEngineMaxAcceleration = 1.33;
 const double fireEngineMaxBrakeFactor = 4.56;
 const double fireEngineMinFollowDistance = 10.0;
 
-class FireEngine : public Vehicle{
-    FireEngine* _initCheck;
-
+class FireEngine : public Vehicle {
 public:
     /*
      * ENSURE(properlyInitialized(), "FireEngine constructor did not end in an initialized state")
      */
     FireEngine(const std::string &street, double position);
 
-    ~FireEngine();
-
-    bool properlyInitialized() const;
-
-    /*
-     * REQUIRE(properlyInitialized(), "FireEngine wasn't initialized when calling getLength()")
-     */
-    double getLength() const;
-
-    /*
-     * REQUIRE(properlyInitialized(), "FireEngine wasn't initialized when calling getType()")
-     */
-    std::string getType() const;
-
-    /*
-     * REQUIRE(properlyInitialized(), "FireEngine wasn't initialized when calling getAcronym()")
-     */
-    char getAcronym() const;
-
     /*
-     * REQUIRE(properlyInitialized(), "FireEngine wasn't initialized when calling drive()")
-     *
-     * ENSURE(fPosition >= startPosition || std::abs(fPosition-startPosition) < 0.001, "drive() postcondition")
-     */
-    void drive(Vehicle* vehicleInFront);
-
-    /*
-     * REQUIRE(properlyInitialized(), "FireEngine wasn't initialized when calling brake()")
-     *
-     * ENSURE(fMaxSpeed <= fireEngineMaxSpeed, "brake() postcondition");
-     * ENSURE(fMaxSpeed <= startMaxSpeed, "brake() postcondition");
-     */
-    void brake();
-
-    /*
-     * REQUIRE(properlyInitialized(), "FireEngine wasn't initialized when calling stop()")
-     *
-     * ENSURE(fAcceleration <= startAcceleration, "stop() postcondition")
-     */
-    void stop();
-
-    /*
-     * REQUIRE(properlyInitialized(), "FireEngine wasn't initialized when calling setMaxSpeed()")
+     * ENSURE(properlyInitialized(), "FireEngine constructor did not end in an initialized state")
      */
-    void setMaxSpeed();
+    FireEngine(unsigned int street, double position);
 
-    /*
-     * REQUIRE(properlyInitialized(), "FireEngine wasn't initialized when calling hasPriority()")
-     */
-    bool hasPriority() const;
+    ~FireEngine();
 };
 
 
@@ -17,64 +17,18 @@ const double policeCarMaxBrakeFactor = 4.92;
 const double policeCarMinFollowDistance = 6.0;
 
 class PoliceCar : public Vehicle {
-    PoliceCar* _initCheck;
-
 public:
     /*
      * ENSURE(properlyInitialized(), "PoliceCar constructor did not end in an initialized state")
      */
     PoliceCar(const std::string &street, double position);
 
-    ~PoliceCar();
-
-    bool properlyInitialized() const;
-
-    /*
-     * REQUIRE(properlyInitialized(), "PoliceCar wasn't initialized when calling getLength()")
-     */
-    double getLength() const;
-
-    /*
-     * REQUIRE(properlyInitialized(), "PoliceCar wasn't initialized when calling getType()")
-     */
-    std::string getType() const;
-
-    /*
-     * REQUIRE(properlyInitialized(), "PoliceCar wasn't initialized when calling getAcronym()")
-     */
-    char getAcronym() const;
-
     /*
-     * REQUIRE(properlyInitialized(), "PoliceCar wasn't initialized when calling drive()")
-     *
-     * ENSURE(fPosition >= startPosition || std::abs(fPosition-startPosition) < 0.001, "drive() postcondition")
-     */
-    void drive(Vehicle* vehicleInFront);
-
-    /*
-     * REQUIRE(properlyInitialized(), "PoliceCar wasn't initialized when calling brake()")
-     *
-     * ENSURE(fMaxSpeed <= policeCarMaxSpeed, "brake() postcondition")
-     * ENSURE(fMaxSpeed <= startMaxSpeed, "brake() postcondition")
-     */
-    void brake();
-
-    /*
-     * REQUIRE(properlyInitialized(), "PoliceCar wasn't initialized when calling stop()")
-     *
-     * ENSURE(fAcceleration <= startAcceleration, "stop() postcondition")
-     */
-    void stop();
-
-    /*
-     * REQUIRE(properlyInitialized(), "PoliceCar wasn't initialized when calling setMaxSpeed()")
+     * ENSURE(properlyInitialized(), "PoliceCar constructor did not end in an initialized state")
      */
-    void setMaxSpeed();
+    PoliceCar(unsigned int street, double position);
 
-    /*
-     * REQUIRE(properlyInitialized(), "PoliceCar wasn't initialized when calling hasPriority()")
-     */
-    bool hasPriority() const;
+    ~PoliceCar();
 };
 
 
@@ -0,0 +1,130 @@
+// ===========================================================
+// Name         : DemandParser.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is used to parse an XML file that contains a `Demand`.
+// ===========================================================
+
+#include <sstream>
+#include "DemandParser.h"
+#include "../DesignByContract.h"
+#include "../objects/Demand.h"
+#include "../objects/VehicleType.h"
+
+DemandParser::DemandParser(const VehicleTypeRegistry &types) : fDemand(NULL), fVehicleTypes(&types) {
+    DemandParser::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "DemandParser constructor did not end in an initialized state");
+}
+
+DemandParser::~DemandParser() {}
+
+bool DemandParser::properlyInitialized() const {
+    return DemandParser::_initCheck == this;
+}
+
+bool DemandParser::parseDemand(TiXmlElement *VRAAG, std::ostream &errStream) {
+    REQUIRE(properlyInitialized(), "DemandParser wasn't initialized when calling parseDemand()");
+    REQUIRE(errStream.good(), "The errorStream wasn't good at the beginning of parseDemand()");
+
+    TiXmlElement* originElem = VRAAG->FirstChildElement("herkomst");
+    TiXmlElement* destinationElem = VRAAG->FirstChildElement("bestemming");
+
+    std::string origin;
+    std::string destination;
+    std::vector<DemandPeriod> periods;
+    std::vector<std::pair<unsigned int, double> > types;
+
+    bool wrongTypes = false;
+    bool missingElements = false;
+    if (originElem == NULL || originElem->FirstChild() == NULL) {
+        errStream << "XML PARTIAL IMPORT: Expected <herkomst> ... </herkomst>." << std::endl;
+        missingElements = true;
+    } else {
+        origin = originElem->FirstChild()->ToText()->Value();
+    }
+    if (destinationElem == NULL || destinationElem->FirstChild() == NULL) {
+        errStream << "XML PARTIAL IMPORT: Expected <bestemming> ... </bestemming>." << std::endl;
+        missingElements = true;
+    } else {
+        destination = destinationElem->FirstChild()->ToText()->Value();
+    }
+
+    for (TiXmlElement* periodElem = VRAAG->FirstChildElement("periode"); periodElem != NULL;
+            periodElem = periodElem->NextSiblingElement("periode")) {
+        const char* startString = periodElem->Attribute("van");
+        const char* endString = periodElem->Attribute("tot");
+        if (startString == NULL || endString == NULL || periodElem->FirstChild() == NULL) {
+            errStream << "XML PARTIAL IMPORT: Expected <periode van=\"...\" tot=\"...\"> ... </periode>." << std::endl;
+            missingElements = true;
+            continue;
+        }
+        DemandPeriod period;
+        std::string rateString = periodElem->FirstChild()->ToText()->Value();
+        if ((std::istringstream(startString) >> period.start).fail() || (std::istringstream(endString) >> period.end).fail()
+                || period.start < 0 || period.end <= period.start
+                || (!periods.empty() && period.start < periods.back().end)) {
+            errStream << "XML PARTIAL IMPORT: Expected the periods to be consecutive intervals of positive times." << std::endl;
+            wrongTypes = true;
+        } else if ((std::istringstream(rateString) >> period.rate).fail() || period.rate < 0) {
+            errStream << "XML PARTIAL IMPORT: Expected <periode> to be a number of vehicles per hour that isn't negative." << std::endl;
+            wrongTypes = true;
+        } else if (period.rate > 0 && period.end + 3600.0 / period.rate <= period.end) {
+            // The arrivals would be closer together than the precision of the time, so they never advance
+            errStream << "XML PARTIAL IMPORT: Expected <periode> to be a number of vehicles per hour that leaves time between the arrivals." << std::endl;
+            wrongTypes = true;
+        } else {
+            periods.push_back(period);
+        }
+    }
+    if (periods.empty() && !wrongTypes) {
+        errStream << "XML PARTIAL IMPORT: Expected <periode van=\"...\" tot=\"...\"> ... </periode>." << std::endl;
+        missingElements = true;
+    }
+
+    for (TiXmlElement* typeElem = VRAAG->FirstChildElement("type"); typeElem != NULL;
+            typeElem = typeElem->NextSiblingElement("type")) {
+        if (typeElem->FirstChild() == NULL) {
+            errStream << "XML PARTIAL IMPORT: Expected <type> ... </type>." << std::endl;
+            missingElements = true;
+            continue;
+        }
+        std::pair<unsigned int, double> type(0, 1.0);
+        const char* shareString = typeElem->Attribute("aandeel");
+        if (!fVehicleTypes->find(typeElem->FirstChild()->ToText()->Value(), type.first)) {
+            errStream << "XML PARTIAL IMPORT: Expected <type> to be auto, bus, brandweerwagen, ziekenwagen, politiecombi or a type from a <VOERTUIGTYPE>." << std::endl;
+            wrongTypes = true;
+        } else if (shareString != NULL && ((std::istringstream(shareString) >> type.second).fail() || type.second <= 0)) {
+            errStream << "XML PARTIAL IMPORT: Expected attribute \"aandeel\" to be a positive number." << std::endl;
+            wrongTypes = true;
+        } else {
+            types.push_back(type);
+        }
+    }
+
+    if (missingElements || wrongTypes) {
+        return false;
+    }
+
+    fDemand = new Demand(origin, destination);
+    for (unsigned int i = 0; i < periods.size(); i++) {
+        fDemand->addPeriod(periods[i].start, periods[i].end, periods[i].rate);
+    }
+    for (unsigned int i = 0; i < types.size(); i++) {
+        fDemand->addType(types[i].first, types[i].second);
+    }
+
+    ENSURE(fDemand != NULL, "DemandParser could not create a Demand");
+    ENSURE(fDemand->getOrigin() == origin, "parseDemand() postcondition");
+    ENSURE(!fDemand->getPeriods().empty(), "parseDemand() postcondition");
+    ENSURE(errStream.good(), "The errorStream wasn't good at the end of parseDemand()");
+
+    return true;
+}
+
+Demand* DemandParser::getDemand() const {
+    REQUIRE(properlyInitialized(), "DemandParser wasn't initialized when calling getDemand()");
+    REQUIRE(fDemand != NULL, "DemandParser had no demand when calling getDemand()");
+
+    return fDemand;
+}
@@ -0,0 +1,57 @@
+// ===========================================================
+// Name         : DemandParser.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is used to parse an XML file that contains a `Demand`.
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_DEMANDPARSER_H
+#define TRAFFICSIMULATION_DEMANDPARSER_H
+
+#include "tinyxml/tinyxml.h"
+
+class Demand;
+class VehicleTypeRegistry;
+
+class DemandParser {
+    DemandParser* _initCheck;
+
+    Demand* fDemand;
+    // The types of the simulation the demand is parsed for
+    const VehicleTypeRegistry* fVehicleTypes;
+
+public:
+    /*
+     * Looks up the types of the demand in `types`.
+     *
+     * ENSURE(properlyInitialized(), "DemandParser constructor did not end in an initialized state")
+     */
+    explicit DemandParser(const VehicleTypeRegistry &types);
+
+    virtual ~DemandParser();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Parses `<VRAAG><herkomst>...</herkomst><bestemming>...</bestemming><periode van="..." tot="...">...</periode>
+     * <type aandeel="...">...</type></VRAAG>` with one or more periods, in vehicles per hour, and zero or more types.
+     *
+     * REQUIRE(properlyInitialized(), "DemandParser wasn't initialized when calling parseDemand()")
+     * REQUIRE(errStream.good(), "The errorStream wasn't good at the beginning of parseDemand()")
+     *
+     * ENSURE(fDemand != NULL, "DemandParser could not create a Demand")
+     * ENSURE(fDemand->getOrigin() == origin, "parseDemand() postcondition")
+     * ENSURE(!fDemand->getPeriods().empty(), "parseDemand() postcondition")
+     * ENSURE(errStream.good(), "The errorStream wasn't good at the end of parseDemand()")
+     */
+    bool parseDemand(TiXmlElement* VRAAG, std::ostream &errStream);
+
+    /*
+     * REQUIRE(properlyInitialized(), "DemandParser wasn't initialized when calling getDemand()")
+     * REQUIRE(fDemand != NULL, "DemandParser had no demand when calling getDemand()")
+     */
+    Demand* getDemand() const;
+};
+
+
+#endif
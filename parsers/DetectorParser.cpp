@@ -0,0 +1,86 @@
+// ===========================================================
+// Name         : DetectorParser.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is used to parse an XML file that contains a `Detector`.
+// ===========================================================
+
+#include <sstream>
+#include "DetectorParser.h"
+#include "../DesignByContract.h"
+#include "../Variables.h"
+#include "../objects/Detector.h"
+
+DetectorParser::DetectorParser() {
+    DetectorParser::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "DetectorParser constructor did not end in an initialized state");
+}
+
+DetectorParser::~DetectorParser() {}
+
+bool DetectorParser::properlyInitialized() const {
+    return DetectorParser::_initCheck == this;
+}
+
+bool DetectorParser::parseDetector(TiXmlElement *DETECTOR, std::ostream &errStream) {
+    REQUIRE(properlyInitialized(), "DetectorParser wasn't initialized when calling parseDetector()");
+    REQUIRE(errStream.good(), "The errorStream wasn't good at the beginning of parseDetector()");
+
+    TiXmlElement* streetElem = DETECTOR->FirstChildElement("baan");
+    TiXmlElement* positionElem = DETECTOR->FirstChildElement("positie");
+    TiXmlElement* intervalElem = DETECTOR->FirstChildElement("interval");
+
+    std::string street;
+    int position;
+    double interval = gDetectorInterval;
+
+    bool wrongTypes = false;
+    bool missingElements = false;
+    if (streetElem == NULL || streetElem->FirstChild() == NULL) {
+        errStream << "XML PARTIAL IMPORT: Expected <baan> ... </baan>." << std::endl;
+        missingElements = true;
+    } else {
+        TiXmlText* streetText = streetElem->FirstChild()->ToText();
+        street = streetText->Value();
+    }
+    if (positionElem == NULL || positionElem->FirstChild() == NULL) {
+        errStream << "XML PARTIAL IMPORT: Expected <positie> .. </positie>." << std::endl;
+        missingElements = true;
+    } else {
+        std::string positionString = positionElem->FirstChild()->ToText()->Value();
+        if ((std::istringstream(positionString) >> position).fail()) {
+            errStream << "XML PARTIAL IMPORT: Expected <positie> to be an integer." << std::endl;
+            wrongTypes = true;
+        }
+    }
+    if (intervalElem != NULL && intervalElem->FirstChild() != NULL) {
+        std::string intervalString = intervalElem->FirstChild()->ToText()->Value();
+        if ((std::istringstream(intervalString) >> interval).fail() || interval <= 0) {
+            errStream << "XML PARTIAL IMPORT: Expected <interval> to be a positive number." << std::endl;
+            wrongTypes = true;
+        }
+    }
+
+    if (missingElements || wrongTypes) {
+        return false;
+    }
+
+    fDetector = new Detector(street, position, interval);
+
+    ENSURE(fDetector != NULL, "DetectorParser could not create a Detector");
+    ENSURE(fDetector->getStreet() == street, "parseDetector() postcondition");
+    ENSURE(fDetector->getPosition() == position, "parseDetector() postcondition");
+    ENSURE(fDetector->getInterval() > 0, "parseDetector() postcondition");
+
+    ENSURE(errStream.good(), "The errorStream wasn't good at the end of parseDetector()");
+
+    return true;
+}
+
+Detector* DetectorParser::getDetector() const {
+    REQUIRE(properlyInitialized(), "DetectorParser wasn't initialized when calling getDetector()");
+    REQUIRE(fDetector != NULL, "DetectorParser had no detector when calling getDetector()");
+
+    return fDetector;
+}
@@ -0,0 +1,50 @@
+// ===========================================================
+// Name         : DetectorParser.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is used to parse an XML file that contains a `Detector`.
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_DETECTORPARSER_H
+#define TRAFFICSIMULATION_DETECTORPARSER_H
+
+#include "tinyxml/tinyxml.h"
+
+class Detector;
+
+class DetectorParser {
+    DetectorParser* _initCheck;
+
+    Detector* fDetector;
+
+public:
+    /*
+     * ENSURE(properlyInitialized(), "DetectorParser constructor did not end in an initialized state")
+     */
+    DetectorParser();
+
+    virtual ~DetectorParser();
+
+    bool properlyInitialized() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "DetectorParser wasn't initialized when calling parseDetector()")
+     * REQUIRE(errStream.good(), "The errorStream wasn't good at the beginning of parseDetector()")
+     *
+     * ENSURE(fDetector != NULL, "DetectorParser could not create a Detector");
+     * ENSURE(fDetector->getStreet() == street, "parseDetector() postcondition");
+     * ENSURE(fDetector->getPosition() == position, "parseDetector() postcondition");
+     * ENSURE(fDetector->getInterval() > 0, "parseDetector() postcondition");
+     * ENSURE(errStream.good(), "The errorStream wasn't good at the end of parseDetector()");
+     */
+    bool parseDetector(TiXmlElement* DETECTOR, std::ostream &errStream);
+
+    /*
+     * REQUIRE(properlyInitialized(), "DetectorParser wasn't initialized when calling getDetector()")
+     * REQUIRE(fDetector != NULL, "DetectorParser had no detector when calling getDetector()")
+     */
+    Detector* getDetector() const;
+};
+
+
+#endif
\ No newline at end of file
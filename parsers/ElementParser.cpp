@@ -6,16 +6,21 @@
 //                or `VehicleGenerator` element
 // ===========================================================
 
+#include <cstring>
 #include "ElementParser.h"
 #include "../DesignByContract.h"
+#include "MappedFile.h"
 #include "StreetParser.h"
 #include "TrafficLightParser.h"
 #include "VehicleParser.h"
 #include "VehicleGeneratorParser.h"
 #include "BusStopParser.h"
+#include "DetectorParser.h"
+#include "DemandParser.h"
 #include "CrossroadParser.h"
+#include "VehicleTypeParser.h"
 
-ElementParser::ElementParser() {
+ElementParser::ElementParser(VehicleTypeRegistry &types) : fVehicleTypes(&types) {
     ElementParser::_initCheck = this;
 
     ENSURE(properlyInitialized(), "ElementParser constructor did not end in an initialized state");
@@ -33,7 +38,18 @@ EParserSuccess ElementParser::parseFile(const std::string &filename, std::ostrea
 
     EParserSuccess endResult = Success;
 
-    if (!doc.LoadFile(filename.c_str())) {
+    // Parse straight from the mapped file, LoadFile() is only needed when the line endings must be normalized first
+    // or the file can't be mapped (in which case it also reports the error)
+    MappedFile input;
+    bool loaded;
+    if (input.open(filename) && std::memchr(input.getData(), '\r', input.getSize()) == NULL) {
+        doc.Parse(input.getData());
+        loaded = !doc.Error();
+    } else {
+        loaded = doc.LoadFile(filename.c_str());
+    }
+    input.close();
+    if (!loaded) {
         errStream << "XML IMPORT ABORTED: " << doc.ErrorDesc() << std::endl;
         return ImportAborted;
     }
@@ -42,11 +58,24 @@ EParserSuccess ElementParser::parseFile(const std::string &filename, std::ostrea
         errStream << "XML PARTIAL IMPORT: No root element." << std::endl;
         endResult = PartialImport;
     } else {
+        // Vehicle types are registered first so the vehicles and generators can use them wherever they are defined
+        for (TiXmlElement *typeElem = root->FirstChildElement("VOERTUIGTYPE"); typeElem != NULL;
+                typeElem = typeElem->NextSiblingElement("VOERTUIGTYPE")) {
+            VehicleTypeParser vtParser(*fVehicleTypes);
+            if (!vtParser.parseVehicleType(typeElem, errStream)) {
+                endResult = PartialImport;
+            }
+        }
+
         TiXmlElement *elem = root->FirstChildElement();
         while (elem != NULL) {
             try {
                 std::string type = elem->Value();
 
+                if (type == "VOERTUIGTYPE") {
+                    elem = elem->NextSiblingElement();
+                    continue;
+                }
                 if (type == "BAAN") {
                     StreetParser sParser;
                     if (sParser.parseStreet(elem, errStream)) {
@@ -68,9 +97,10 @@ EParserSuccess ElementParser::parseFile(const std::string &filename, std::ostrea
                     continue;
                 }
                 if (type == "VOERTUIG") {
-                    VehicleParser vParser;
+                    VehicleParser vParser(*fVehicleTypes);
                     if (vParser.parseVehicle(elem, errStream)) {
                         fVehicles.push_back(vParser.getVehicle());
+                        fVehicleDestinations.push_back(vParser.getDestination());
                     } else {
                         endResult = PartialImport;
                     }
@@ -78,9 +108,10 @@ EParserSuccess ElementParser::parseFile(const std::string &filename, std::ostrea
                     continue;
                 }
                 if (type == "VOERTUIGGENERATOR") {
-                    VehicleGeneratorParser vgParser;
+                    VehicleGeneratorParser vgParser(*fVehicleTypes);
                     if (vgParser.parseVehicleGenerator(elem, errStream)) {
                         fVehicleGenerators.push_back(vgParser.getVehicleGenerator());
+                        fVehicleGeneratorDestinations.push_back(vgParser.getDestination());
                     } else {
                         endResult = PartialImport;
                     }
@@ -97,6 +128,26 @@ EParserSuccess ElementParser::parseFile(const std::string &filename, std::ostrea
                         elem = elem->NextSiblingElement();
                         continue;
                 }
+                if (type == "DETECTOR") {
+                    DetectorParser dParser;
+                    if (dParser.parseDetector(elem, errStream)) {
+                        fDetectors.push_back(dParser.getDetector());
+                    } else {
+                        endResult = PartialImport;
+                    }
+                    elem = elem->NextSiblingElement();
+                    continue;
+                }
+                if (type == "VRAAG") {
+                    DemandParser dParser(*fVehicleTypes);
+                    if (dParser.parseDemand(elem, errStream)) {
+                        fDemands.push_back(dParser.getDemand());
+                    } else {
+                        endResult = PartialImport;
+                    }
+                    elem = elem->NextSiblingElement();
+                    continue;
+                }
                 if (type == "KRUISPUNT") {
                     CrossroadParser cParser;
                     if (cParser.parseCrossroad(elem, errStream)) {
@@ -145,18 +196,42 @@ std::vector<Vehicle*> ElementParser::getVehicles() const {
     return fVehicles;
 }
 
+const std::vector<std::string> &ElementParser::getVehicleDestinations() const {
+    REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getVehicleDestinations()");
+
+    return fVehicleDestinations;
+}
+
 std::vector<VehicleGenerator*> ElementParser::getVehicleGenerators() const {
     REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getVehicleGenerators()");
 
     return fVehicleGenerators;
 }
 
+const std::vector<std::string> &ElementParser::getVehicleGeneratorDestinations() const {
+    REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getVehicleGeneratorDestinations()");
+
+    return fVehicleGeneratorDestinations;
+}
+
 std::vector<BusStop *> ElementParser::getBusStops() const {
     REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getBusStops()");
 
     return fBusStops;
 }
 
+const std::vector<Detector*> &ElementParser::getDetectors() const {
+    REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getDetectors()");
+
+    return fDetectors;
+}
+
+const std::vector<Demand*> &ElementParser::getDemands() const {
+    REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getDemands()");
+
+    return fDemands;
+}
+
 const std::vector<std::pair<std::pair<std::string, unsigned int>, std::pair<std::string, unsigned int> > > &ElementParser::getCrossroads() const {
     REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getCrossroads()");
 
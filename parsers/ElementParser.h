@@ -24,25 +24,38 @@ class TrafficLight;
 class Vehicle;
 class VehicleGenerator;
 class BusStop;
+class Detector;
+class Demand;
 class Crossroad;
+class VehicleTypeRegistry;
 
 class ElementParser {
     TiXmlElement* root;
     TiXmlDocument doc;
     ElementParser* _initCheck;
 
+    // The types of the simulation the file is parsed for, the <VOERTUIGTYPE> elements are added to it
+    VehicleTypeRegistry* fVehicleTypes;
+
     std::vector<Street*> fStreets;
     std::vector<TrafficLight*> fTrafficLights;
     std::vector<Vehicle*> fVehicles;
+    // The destination of every vehicle and generator by name, empty if it has none
+    std::vector<std::string> fVehicleDestinations;
     std::vector<VehicleGenerator*> fVehicleGenerators;
+    std::vector<std::string> fVehicleGeneratorDestinations;
     std::vector<BusStop*> fBusStops;
+    std::vector<Detector*> fDetectors;
+    std::vector<Demand*> fDemands;
     std::vector<std::pair<std::pair<std::string, unsigned int>, std::pair<std::string, unsigned int> > > fCrossroads;
 
 public:
     /*
+     * Parses for the simulation with the vehicle types `types`.
+     *
      * ENSURE(properlyInitialized(), "ElementParser constructor did not end in an initialized state")
      */
-    ElementParser();
+    explicit ElementParser(VehicleTypeRegistry &types);
 
     ~ElementParser();
 
@@ -71,16 +84,40 @@ public:
      */
     std::vector<Vehicle*> getVehicles() const;
 
+    /*
+     * The <bestemming> of every vehicle of getVehicles(), empty for a vehicle without one.
+     *
+     * REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getVehicleDestinations()")
+     */
+    const std::vector<std::string> &getVehicleDestinations() const;
+
     /*
      * REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getVehicleGenerators()")
      */
     std::vector<VehicleGenerator*> getVehicleGenerators() const;
 
+    /*
+     * The <bestemming> of every generator of getVehicleGenerators(), empty for a generator without one.
+     *
+     * REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getVehicleGeneratorDestinations()")
+     */
+    const std::vector<std::string> &getVehicleGeneratorDestinations() const;
+
     /*
      * REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getBusStops()")
      */
     std::vector<BusStop*> getBusStops() const;
 
+    /*
+     * REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getDetectors()")
+     */
+    const std::vector<Detector*> &getDetectors() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getDemands()")
+     */
+    const std::vector<Demand*> &getDemands() const;
+
     /*
      * REQUIRE(properlyInitialized(), "ElementParser wasn't initialized when calling getCrossroads()")
      */
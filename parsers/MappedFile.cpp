@@ -0,0 +1,96 @@
+// ===========================================================
+// Name         : MappedFile.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `MappedFile` class which maps an input file read-only into memory
+// ===========================================================
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "MappedFile.h"
+#include "../DesignByContract.h"
+
+MappedFile::MappedFile() : fRegion(NULL), fRegionSize(0), fSize(0) {
+    MappedFile::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "MappedFile constructor did not end in an initialized state");
+}
+
+MappedFile::~MappedFile() {
+    if (fRegion != NULL) {
+        munmap(fRegion, fRegionSize);
+    }
+}
+
+bool MappedFile::properlyInitialized() const {
+    return MappedFile::_initCheck == this;
+}
+
+bool MappedFile::open(const std::string &filename) {
+    REQUIRE(properlyInitialized(), "MappedFile wasn't initialized when calling open()");
+
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd >= 0 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        // Reserve one zero-filled page more than needed and map the file over the start of it, this way the data is
+        // always null-terminated, even when the file size is an exact multiple of the page size
+        unsigned long pageSize = sysconf(_SC_PAGESIZE);
+        unsigned long size = st.st_size;
+        unsigned long regionSize = (size / pageSize + 1) * pageSize;
+        void* region = mmap(NULL, regionSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region != MAP_FAILED && mmap(region, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            munmap(region, regionSize);
+            region = MAP_FAILED;
+        }
+        if (region != MAP_FAILED) {
+            madvise(region, size, MADV_SEQUENTIAL);
+            fRegion = region;
+            fRegionSize = regionSize;
+            fSize = size;
+        }
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    bool result = fRegion != NULL;
+
+    ENSURE(!result || isOpen(), "open() postcondition");
+
+    return result;
+}
+
+void MappedFile::close() {
+    REQUIRE(properlyInitialized(), "MappedFile wasn't initialized when calling close()");
+
+    if (fRegion != NULL) {
+        munmap(fRegion, fRegionSize);
+    }
+    fRegion = NULL;
+    fRegionSize = 0;
+    fSize = 0;
+
+    ENSURE(!isOpen(), "close() postcondition");
+}
+
+bool MappedFile::isOpen() const {
+    REQUIRE(properlyInitialized(), "MappedFile wasn't initialized when calling isOpen()");
+
+    return fRegion != NULL;
+}
+
+const char *MappedFile::getData() const {
+    REQUIRE(properlyInitialized(), "MappedFile wasn't initialized when calling getData()");
+    REQUIRE(isOpen(), "MappedFile wasn't open when calling getData()");
+
+    return static_cast<const char*>(fRegion);
+}
+
+unsigned long MappedFile::getSize() const {
+    REQUIRE(properlyInitialized(), "MappedFile wasn't initialized when calling getSize()");
+
+    return fSize;
+}
@@ -0,0 +1,69 @@
+// ===========================================================
+// Name         : MappedFile.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `MappedFile` class which maps an input file read-only into memory
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_MAPPEDFILE_H
+#define TRAFFICSIMULATION_MAPPEDFILE_H
+
+#include <iostream>
+
+class MappedFile {
+    MappedFile* _initCheck;
+
+    void* fRegion;
+    unsigned long fRegionSize;
+    unsigned long fSize;
+
+public:
+    /*
+     * ENSURE(properlyInitialized(), "MappedFile constructor did not end in an initialized state")
+     */
+    MappedFile();
+
+    /*
+     * Unmaps the file if it is still mapped.
+     */
+    virtual ~MappedFile();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Maps the whole file read-only and shared with the page cache. The mapping is followed by at least one zero
+     * byte, so getData() can be used as a null-terminated string without copying the file. Returns false and stays
+     * closed if the file can't be opened, isn't a regular file or is empty.
+     *
+     * REQUIRE(properlyInitialized(), "MappedFile wasn't initialized when calling open()")
+     *
+     * ENSURE(!result || isOpen(), "open() postcondition")
+     */
+    bool open(const std::string &filename);
+
+    /*
+     * REQUIRE(properlyInitialized(), "MappedFile wasn't initialized when calling close()")
+     *
+     * ENSURE(!isOpen(), "close() postcondition")
+     */
+    void close();
+
+    /*
+     * REQUIRE(properlyInitialized(), "MappedFile wasn't initialized when calling isOpen()")
+     */
+    bool isOpen() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "MappedFile wasn't initialized when calling getData()")
+     * REQUIRE(isOpen(), "MappedFile wasn't open when calling getData()")
+     */
+    const char* getData() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "MappedFile wasn't initialized when calling getSize()")
+     */
+    unsigned long getSize() const;
+};
+
+
+#endif
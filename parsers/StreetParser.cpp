@@ -28,9 +28,13 @@ bool StreetParser::parseStreet(TiXmlElement* BAAN, std::ostream &errStream) {
 
     TiXmlElement* nameElem = BAAN->FirstChildElement("naam");
     TiXmlElement* lengthElem = BAAN->FirstChildElement("lengte");
+    TiXmlElement* levelElem = BAAN->FirstChildElement("niveau");
+    TiXmlElement* lanesElem = BAAN->FirstChildElement("rijstroken");
 
     std::string name;
     int length;
+    EStreetLevel level = MicroscopicLevel;
+    int lanes = 1;
 
     bool wrongTypes = false;
     bool missingElements = false;
@@ -52,15 +56,37 @@ bool StreetParser::parseStreet(TiXmlElement* BAAN, std::ostream &errStream) {
         }
     }
 
+    if (levelElem != NULL && levelElem->FirstChild() != NULL) {
+        std::string levelString = levelElem->FirstChild()->ToText()->Value();
+        if (levelString == "meso") {
+            level = MesoscopicLevel;
+        } else if (levelString != "micro") {
+            errStream << "XML PARTIAL IMPORT: Expected <niveau> to be micro or meso." << std::endl;
+            wrongTypes = true;
+        }
+    }
+
+    if (lanesElem != NULL && lanesElem->FirstChild() != NULL) {
+        std::string lanesString = lanesElem->FirstChild()->ToText()->Value();
+        if ((std::istringstream(lanesString) >> lanes).fail() || lanes < 1) {
+            errStream << "XML PARTIAL IMPORT: Expected <rijstroken> to be a positive integer." << std::endl;
+            wrongTypes = true;
+        }
+    }
+
     if (missingElements || wrongTypes) {
         return false;
     }
 
     fStreet = new Street(name, length);
+    fStreet->setLevel(level);
+    fStreet->setLanes(lanes);
 
     ENSURE(fStreet != NULL, "StreetParser could not create a Street");
     ENSURE(fStreet->getName() == name, "parseStreet() postcondition");
     ENSURE(fStreet->getLength() == length, "parseStreet() postcondition");
+    ENSURE(fStreet->getLevel() == level, "parseStreet() postcondition");
+    ENSURE(fStreet->getLanes() == (unsigned int) lanes, "parseStreet() postcondition");
     ENSURE(errStream.good(), "The errorStream wasn't good at the end of parseStreet()");
 
     return true;
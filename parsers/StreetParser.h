@@ -33,6 +33,7 @@ public:
      * ENSURE(fStreet != NULL, "StreetParser could not create a Street")
      * ENSURE(fStreet->getName() == name, "parseStreet() postcondition")
      * ENSURE(fStreet->getLength() == length, "parseStreet() postcondition")
+     * ENSURE(fStreet->getLevel() == level, "parseStreet() postcondition")
      * ENSURE(errStream.good(), "The errorStream wasn't good at the end of parseStreet()")
      */
     bool parseStreet(TiXmlElement* BAAN, std::ostream &errStream);
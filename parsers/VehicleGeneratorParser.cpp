@@ -10,7 +10,7 @@
 #include "../DesignByContract.h"
 #include "../objects/VehicleGenerator.h"
 
-VehicleGeneratorParser::VehicleGeneratorParser() {
+VehicleGeneratorParser::VehicleGeneratorParser(const VehicleTypeRegistry &types) : fVehicleTypes(&types) {
     VehicleGeneratorParser::_initCheck = this;
 
     ENSURE(properlyInitialized(), "VehicleGeneratorParser constructor did not end in an initialized state");
@@ -29,10 +29,13 @@ bool VehicleGeneratorParser::parseVehicleGenerator(TiXmlElement *VOERTUIGGENERAT
     TiXmlElement* baanElem = VOERTUIGGENERATOR->FirstChildElement("baan");
     TiXmlElement* frequencyElem = VOERTUIGGENERATOR->FirstChildElement("frequentie");
     TiXmlElement* typeElem = VOERTUIGGENERATOR->FirstChildElement("type");
+    TiXmlElement* destinationElem = VOERTUIGGENERATOR->FirstChildElement("bestemming");
+    TiXmlElement* arrivalsElem = VOERTUIGGENERATOR->FirstChildElement("aankomsten");
 
     std::string street;
     int frequency;
     std::string type;
+    unsigned int vehicleType = 0;
 
     bool wrongTypes = false;
     bool missingElements = false;
@@ -63,12 +66,45 @@ bool VehicleGeneratorParser::parseVehicleGenerator(TiXmlElement *VOERTUIGGENERAT
     } else {
         TiXmlText* typeText = typeElem->FirstChild()->ToText();
         type = typeText->Value();
-        if (type != "auto" && type != "bus" && type != "brandweerwagen" && type != "ziekenwagen" && type != "politiecombi") {
-            errStream << "XML PARTIAL IMPORT: Expected <type> to be one of the following: auto, bus, brandweerwagen, ziekenwagen, politiecombi." << std::endl;
+        if (!fVehicleTypes->find(type, vehicleType)) {
+            errStream << "XML PARTIAL IMPORT: Expected <type> to be auto, bus, brandweerwagen, ziekenwagen, politiecombi or a type from a <VOERTUIGTYPE>." << std::endl;
             return false;
         }
     }
 
+    EArrivalProcess process = DeterministicArrivals;
+    if (arrivalsElem != NULL && arrivalsElem->FirstChild() != NULL) {
+        std::string processString = arrivalsElem->FirstChild()->ToText()->Value();
+        if (processString == "poisson") {
+            process = PoissonArrivals;
+        } else if (processString == "empirisch") {
+            process = EmpiricalArrivals;
+        } else if (processString != "vast") {
+            errStream << "XML PARTIAL IMPORT: Expected <aankomsten> to be vast, poisson or empirisch." << std::endl;
+            wrongTypes = true;
+        }
+    }
+    std::vector<HeadwayBin> bins;
+    for (TiXmlElement* binElem = VOERTUIGGENERATOR->FirstChildElement("volgtijd"); binElem != NULL;
+            binElem = binElem->NextSiblingElement("volgtijd")) {
+        const char* fromString = binElem->Attribute("van");
+        const char* toString = binElem->Attribute("tot");
+        HeadwayBin bin;
+        if (fromString == NULL || toString == NULL || binElem->FirstChild() == NULL
+                || (std::istringstream(fromString) >> bin.from).fail() || (std::istringstream(toString) >> bin.to).fail()
+                || (std::istringstream(binElem->FirstChild()->ToText()->Value()) >> bin.weight).fail()
+                || bin.from < 0 || bin.to <= bin.from || bin.weight <= 0) {
+            errStream << "XML PARTIAL IMPORT: Expected <volgtijd van=\"...\" tot=\"...\"> ... </volgtijd> with a positive weight." << std::endl;
+            wrongTypes = true;
+        } else {
+            bins.push_back(bin);
+        }
+    }
+    if (process == EmpiricalArrivals && bins.empty() && !wrongTypes) {
+        errStream << "XML PARTIAL IMPORT: Expected <volgtijd van=\"...\" tot=\"...\"> ... </volgtijd>." << std::endl;
+        missingElements = true;
+    }
+
     if (missingElements || wrongTypes) {
         return false;
     }
@@ -76,6 +112,14 @@ bool VehicleGeneratorParser::parseVehicleGenerator(TiXmlElement *VOERTUIGGENERAT
     fVehicleGenerator = new VehicleGenerator(street, frequency, type);
     fVehicleGenerator->setStreet(street);
     fVehicleGenerator->setFrequency(frequency);
+    fVehicleGenerator->setVehicleType(vehicleType);
+    if (destinationElem != NULL && destinationElem->FirstChild() != NULL) {
+        fDestination = destinationElem->FirstChild()->ToText()->Value();
+    }
+    fVehicleGenerator->setArrivalProcess(process);
+    for (unsigned int i = 0; i < bins.size(); i++) {
+        fVehicleGenerator->addHeadwayBin(bins[i].from, bins[i].to, bins[i].weight);
+    }
 
     ENSURE(fVehicleGenerator != NULL, "VehicleGeneratorParser could not create a VehicleGenerator");
     ENSURE(fVehicleGenerator->getStreet() == street, "parseVehicleGenerator() postcondition");
@@ -91,3 +135,9 @@ VehicleGenerator *VehicleGeneratorParser::getVehicleGenerator() const {
 
     return fVehicleGenerator;
 }
+
+const std::string &VehicleGeneratorParser::getDestination() const {
+    REQUIRE(properlyInitialized(), "VehicleGeneratorParser wasn't initialized when calling getDestination()");
+
+    return fDestination;
+}
@@ -8,19 +8,26 @@
 #ifndef PSE_VEHICLEGENERATORPARSER_H
 #define PSE_VEHICLEGENERATORPARSER_H
 
+#include <string>
 #include "tinyxml/tinyxml.h"
 
 class VehicleGenerator;
+class VehicleTypeRegistry;
 
 class VehicleGeneratorParser {
     VehicleGenerator* fVehicleGenerator;
+    // The types of the simulation the generator is parsed for
+    const VehicleTypeRegistry* fVehicleTypes;
+    std::string fDestination;
     VehicleGeneratorParser* _initCheck;
 
 public:
     /*
+     * Looks up the generated types in `types`.
+     *
      * ENSURE(properlyInitialized(), "VehicleGeneratorParser constructor did not end in an initialized state")
      */
-    VehicleGeneratorParser();
+    explicit VehicleGeneratorParser(const VehicleTypeRegistry &types);
 
     virtual ~VehicleGeneratorParser();
 
@@ -42,6 +49,14 @@ public:
      * REQUIRE(fVehicleGenerator != NULL, "VehicleGeneratorParser had no vehicle generator when calling getVehicleGenerator()")
      */
     VehicleGenerator* getVehicleGenerator() const;
+
+    /*
+     * The name of the <bestemming> of the generated vehicles, empty if there is none. The simulation gives it to the
+     * generator once it knows the streets.
+     *
+     * REQUIRE(properlyInitialized(), "VehicleGeneratorParser wasn't initialized when calling getDestination()")
+     */
+    const std::string &getDestination() const;
 };
 
 
@@ -7,15 +7,11 @@
 
 #include "VehicleParser.h"
 #include "../DesignByContract.h"
-#include "../objects/vehicles/Car.h"
-#include "../objects/vehicles/Bus.h"
-#include "../objects/vehicles/FireEngine.h"
-#include "../objects/vehicles/Ambulance.h"
-#include "../objects/vehicles/PoliceCar.h"
+#include "../objects/Vehicle.h"
 
 #include <sstream>
 
-VehicleParser::VehicleParser() {
+VehicleParser::VehicleParser(const VehicleTypeRegistry &types) : fVehicleTypes(&types) {
     VehicleParser::_initCheck = this;
 
     ENSURE(properlyInitialized(), "VehicleParser constructor did not end in an initialized state");
@@ -34,10 +30,13 @@ bool VehicleParser::parseVehicle(TiXmlElement *VOERTUIG, std::ostream &errStream
     TiXmlElement* baanElem = VOERTUIG->FirstChildElement("baan");
     TiXmlElement* positionElem = VOERTUIG->FirstChildElement("positie");
     TiXmlElement* typeElem = VOERTUIG->FirstChildElement("type");
+    TiXmlElement* laneElem = VOERTUIG->FirstChildElement("rijstrook");
+    TiXmlElement* destinationElem = VOERTUIG->FirstChildElement("bestemming");
 
     std::string street;
     int position;
     std::string type;
+    int lane = 1;
 
     bool wrongTypes = false;
     bool missingElements = false;
@@ -68,28 +67,34 @@ bool VehicleParser::parseVehicle(TiXmlElement *VOERTUIG, std::ostream &errStream
         type = typeElem->FirstChild()->ToText()->Value();
     }
 
+    if (laneElem != NULL && laneElem->FirstChild() != NULL) {
+        std::string laneString = laneElem->FirstChild()->ToText()->Value();
+        if ((std::istringstream(laneString) >> lane).fail() || lane < 1) {
+            errStream << "XML PARTIAL IMPORT: Expected <rijstrook> to be a positive integer." << std::endl;
+            wrongTypes = true;
+        }
+    }
+
     if (missingElements || wrongTypes) {
         return false;
     }
 
-    if (type == "auto") {
-        fVehicle = new Car(street, position);
-    } else if (type == "bus") {
-        fVehicle = new Bus(street, position);
-    } else if (type == "brandweerwagen") {
-        fVehicle = new FireEngine(street, position);
-    } else if (type == "ziekenwagen") {
-        fVehicle = new Ambulance(street, position);
-    } else if (type == "politiecombi") {
-        fVehicle = new PoliceCar(street, position);
-    } else {
-        errStream << "XML PARTIAL IMPORT: Expected <type> to be one of the following: auto, bus, brandweerwagen, ziekenwagen, politiecombi." << std::endl;
+    unsigned int vehicleType;
+    if (!fVehicleTypes->find(type, vehicleType)) {
+        errStream << "XML PARTIAL IMPORT: Expected <type> to be auto, bus, brandweerwagen, ziekenwagen, politiecombi or a type from a <VOERTUIGTYPE>." << std::endl;
         return false;
     }
+    fVehicle = new Vehicle(street, position, vehicleType, *fVehicleTypes);
+    // Lanes are numbered from 1 in the XML file
+    fVehicle->setLane(lane - 1);
+    if (destinationElem != NULL && destinationElem->FirstChild() != NULL) {
+        fDestination = destinationElem->FirstChild()->ToText()->Value();
+    }
 
     ENSURE(fVehicle != NULL, "VehicleParser could not create a Vehicle");
     ENSURE(fVehicle->getStreet() == street, "parseVehicle() postcondition");
     ENSURE(fVehicle->getPosition() == position, "parseVehicle() postcondition");
+    ENSURE(fVehicle->getLane() == (unsigned int) lane - 1, "parseVehicle() postcondition");
     ENSURE(errStream.good(), "The errorStream wasn't good at the end of parseVehicle()");
 
     return true;
@@ -101,3 +106,9 @@ Vehicle *VehicleParser::getVehicle() const {
 
     return fVehicle;
 }
+
+const std::string &VehicleParser::getDestination() const {
+    REQUIRE(properlyInitialized(), "VehicleParser wasn't initialized when calling getDestination()");
+
+    return fDestination;
+}
@@ -9,20 +9,27 @@
 #define PSE_VEHICLEPARSER_H
 
 #include <iostream>
+#include <string>
 #include "tinyxml/tinyxml.h"
 
 class Vehicle;
+class VehicleTypeRegistry;
 
 class VehicleParser {
     VehicleParser* _initCheck;
 
     Vehicle* fVehicle;
+    std::string fDestination;
+    // The types of the simulation the vehicle is parsed for
+    const VehicleTypeRegistry* fVehicleTypes;
 
 public:
     /*
+     * Looks up the types of the vehicles in `types`.
+     *
      * ENSURE(properlyInitialized(), "VehicleParser constructor did not end in an initialized state")
      */
-    VehicleParser();
+    explicit VehicleParser(const VehicleTypeRegistry &types);
 
     virtual ~VehicleParser();
 
@@ -44,6 +51,14 @@ public:
      * REQUIRE(fVehicle != NULL, "VehicleParser had no vehicle when calling getVehicle()")
      */
     Vehicle *getVehicle() const;
+
+    /*
+     * The name of the <bestemming> of the vehicle, empty if it has none. The simulation gives it to the vehicle once it
+     * knows the streets.
+     *
+     * REQUIRE(properlyInitialized(), "VehicleParser wasn't initialized when calling getDestination()")
+     */
+    const std::string &getDestination() const;
 };
 
 
@@ -0,0 +1,120 @@
+// ===========================================================
+// Name         : VehicleTypeParser.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is used to parse an XML file that contains a `VehicleType` and adds it to the registry.
+// ===========================================================
+
+#include <sstream>
+#include <cctype>
+#include "VehicleTypeParser.h"
+#include "../DesignByContract.h"
+#include "../objects/VehicleType.h"
+
+VehicleTypeParser::VehicleTypeParser(VehicleTypeRegistry &types) : fVehicleTypes(&types), fVehicleType(0), fParsed(false) {
+    VehicleTypeParser::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "VehicleTypeParser constructor did not end in an initialized state");
+}
+
+VehicleTypeParser::~VehicleTypeParser() {}
+
+bool VehicleTypeParser::properlyInitialized() const {
+    return VehicleTypeParser::_initCheck == this;
+}
+
+bool VehicleTypeParser::parseParameter(TiXmlElement *elem, const std::string &name, double &value, std::ostream &errStream) {
+    if (elem == NULL || elem->FirstChild() == NULL) {
+        errStream << "XML PARTIAL IMPORT: Expected <" << name << "> ... </" << name << ">." << std::endl;
+        return false;
+    }
+    std::string valueString = elem->FirstChild()->ToText()->Value();
+    if ((std::istringstream(valueString) >> value).fail() || value <= 0) {
+        errStream << "XML PARTIAL IMPORT: Expected <" << name << "> to be a positive number." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool VehicleTypeParser::parseFlag(TiXmlElement *elem, const std::string &name, bool &value, std::ostream &errStream) {
+    value = false;
+    if (elem == NULL || elem->FirstChild() == NULL) {
+        return true;
+    }
+    std::string valueString = elem->FirstChild()->ToText()->Value();
+    if (valueString == "ja") {
+        value = true;
+    } else if (valueString != "nee") {
+        errStream << "XML PARTIAL IMPORT: Expected <" << name << "> to be ja or nee." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool VehicleTypeParser::parseVehicleType(TiXmlElement *VOERTUIGTYPE, std::ostream &errStream) {
+    REQUIRE(properlyInitialized(), "VehicleTypeParser wasn't initialized when calling parseVehicleType()");
+    REQUIRE(errStream.good(), "The errorStream wasn't good at the beginning of parseVehicleType()");
+
+    TiXmlElement* nameElem = VOERTUIGTYPE->FirstChildElement("naam");
+    TiXmlElement* acronymElem = VOERTUIGTYPE->FirstChildElement("acroniem");
+
+    VehicleType parameters;
+    bool wrongTypes = false;
+    bool missingElements = false;
+
+    if (nameElem == NULL || nameElem->FirstChild() == NULL) {
+        errStream << "XML PARTIAL IMPORT: Expected <naam> ... </naam>." << std::endl;
+        missingElements = true;
+    } else {
+        parameters.xmlName = nameElem->FirstChild()->ToText()->Value();
+        parameters.name = parameters.xmlName;
+        parameters.visualizerName = parameters.xmlName;
+        parameters.acronym = (char) std::toupper(parameters.xmlName[0]);
+    }
+    if (acronymElem != NULL && acronymElem->FirstChild() != NULL) {
+        std::string acronym = acronymElem->FirstChild()->ToText()->Value();
+        if (acronym.size() != 1) {
+            errStream << "XML PARTIAL IMPORT: Expected <acroniem> to be a single character." << std::endl;
+            wrongTypes = true;
+        } else {
+            parameters.acronym = acronym[0];
+        }
+    }
+
+    if (!parseParameter(VOERTUIGTYPE->FirstChildElement("lengte"), "lengte", parameters.length, errStream)
+            | !parseParameter(VOERTUIGTYPE->FirstChildElement("maxsnelheid"), "maxsnelheid", parameters.maxSpeed, errStream)
+            | !parseParameter(VOERTUIGTYPE->FirstChildElement("maxversnelling"), "maxversnelling", parameters.maxAcceleration, errStream)
+            | !parseParameter(VOERTUIGTYPE->FirstChildElement("maxremfactor"), "maxremfactor", parameters.maxBrakeFactor, errStream)
+            | !parseParameter(VOERTUIGTYPE->FirstChildElement("minvolgafstand"), "minvolgafstand", parameters.minFollowDistance, errStream)
+            | !parseFlag(VOERTUIGTYPE->FirstChildElement("voorrang"), "voorrang", parameters.priority, errStream)
+            | !parseFlag(VOERTUIGTYPE->FirstChildElement("bushalte"), "bushalte", parameters.stopsAtBusStops, errStream)) {
+        wrongTypes = true;
+    }
+
+    if (missingElements || wrongTypes) {
+        return false;
+    }
+
+    // Types from a file are drawn in grey
+    parameters.color[0] = 128;
+    parameters.color[1] = 128;
+    parameters.color[2] = 128;
+
+    if (!fVehicleTypes->add(parameters, fVehicleType)) {
+        errStream << "XML PARTIAL IMPORT: The vehicle type " << parameters.xmlName << " already exists with other parameters." << std::endl;
+        return false;
+    }
+    fParsed = true;
+
+    ENSURE(fVehicleTypes->get(fVehicleType).xmlName == parameters.xmlName, "parseVehicleType() postcondition");
+    ENSURE(errStream.good(), "The errorStream wasn't good at the end of parseVehicleType()");
+
+    return true;
+}
+
+unsigned int VehicleTypeParser::getVehicleType() const {
+    REQUIRE(properlyInitialized(), "VehicleTypeParser wasn't initialized when calling getVehicleType()");
+    REQUIRE(fParsed, "VehicleTypeParser had no vehicle type when calling getVehicleType()");
+
+    return fVehicleType;
+}
@@ -0,0 +1,65 @@
+// ===========================================================
+// Name         : VehicleTypeParser.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is used to parse an XML file that contains a `VehicleType` and adds it to the registry.
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_VEHICLETYPEPARSER_H
+#define TRAFFICSIMULATION_VEHICLETYPEPARSER_H
+
+#include <iostream>
+#include "tinyxml/tinyxml.h"
+
+class VehicleTypeRegistry;
+
+class VehicleTypeParser {
+    VehicleTypeParser* _initCheck;
+
+    // The registry of the simulation the types are parsed for
+    VehicleTypeRegistry* fVehicleTypes;
+    unsigned int fVehicleType;
+    bool fParsed;
+
+    /*
+     * Reads a positive number from `elem`, writes an error to `errStream` and returns false if that isn't possible.
+     */
+    static bool parseParameter(TiXmlElement* elem, const std::string &name, double &value, std::ostream &errStream);
+
+    /*
+     * Reads an optional ja/nee flag from `elem`, writes an error to `errStream` and returns false if it is something else.
+     */
+    static bool parseFlag(TiXmlElement* elem, const std::string &name, bool &value, std::ostream &errStream);
+
+public:
+    /*
+     * Adds the parsed types to `types`.
+     *
+     * ENSURE(properlyInitialized(), "VehicleTypeParser constructor did not end in an initialized state")
+     */
+    explicit VehicleTypeParser(VehicleTypeRegistry &types);
+
+    virtual ~VehicleTypeParser();
+
+    bool properlyInitialized() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "VehicleTypeParser wasn't initialized when calling parseVehicleType()")
+     * REQUIRE(errStream.good(), "The errorStream wasn't good at the beginning of parseVehicleType()")
+     *
+     * ENSURE(fVehicleTypes->get(fVehicleType).xmlName == parameters.xmlName, "parseVehicleType() postcondition")
+     * ENSURE(errStream.good(), "The errorStream wasn't good at the end of parseVehicleType()")
+     */
+    bool parseVehicleType(TiXmlElement* VOERTUIGTYPE, std::ostream &errStream);
+
+    /*
+     * Returns the index of the parsed type in the registry it was added to.
+     *
+     * REQUIRE(properlyInitialized(), "VehicleTypeParser wasn't initialized when calling getVehicleType()")
+     * REQUIRE(fParsed, "VehicleTypeParser had no vehicle type when calling getVehicleType()")
+     */
+    unsigned int getVehicleType() const;
+};
+
+
+#endif
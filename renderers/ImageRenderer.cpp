@@ -0,0 +1,320 @@
+// ===========================================================
+// Name         : ImageRenderer.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `ImageRenderer` class which rasterizes a `TrafficSimulation` to a PPM or
+//                PNG image without the external engine
+// ===========================================================
+
+#include <fstream>
+#include <cmath>
+#include <algorithm>
+#include "ImageRenderer.h"
+#include "../DesignByContract.h"
+#include "../TrafficSimulation.h"
+#include "../objects/Street.h"
+#include "../objects/Vehicle.h"
+#include "../objects/TrafficLight.h"
+#include "../objects/BusStop.h"
+
+// Layout of the scene in meters, every street gets a row of its own
+const double gRowHeight = 20.0;
+const double gMargin = 10.0;
+const unsigned int gMaxQueuedFrames = 4;
+
+namespace {
+    struct Color {
+        unsigned char r;
+        unsigned char g;
+        unsigned char b;
+    };
+
+    Color makeColor(unsigned char r, unsigned char g, unsigned char b) {
+        Color c;
+        c.r = r;
+        c.g = g;
+        c.b = b;
+        return c;
+    }
+
+    void fillRect(std::vector<unsigned char> &pixels, unsigned int width, unsigned int height, double scale,
+                  double x0, double y0, double x1, double y1, const Color &color) {
+        int px0 = (int) std::floor(x0 * scale);
+        int py0 = (int) std::floor(y0 * scale);
+        int px1 = std::max(px0 + 1, (int) std::ceil(x1 * scale));
+        int py1 = std::max(py0 + 1, (int) std::ceil(y1 * scale));
+        px0 = std::max(px0, 0);
+        py0 = std::max(py0, 0);
+        px1 = std::min(px1, (int) width);
+        py1 = std::min(py1, (int) height);
+        // Nothing of the rectangle is inside the image
+        if (px0 >= px1 || py0 >= py1) {
+            return;
+        }
+        for (int y = py0; y < py1; y++) {
+            unsigned char* row = &pixels[(y * width + px0) * 3];
+            for (int x = px0; x < px1; x++) {
+                *row++ = color.r;
+                *row++ = color.g;
+                *row++ = color.b;
+            }
+        }
+    }
+
+    unsigned long crcTable[256];
+    bool crcTableComputed = false;
+
+    void makeCrcTable() {
+        for (unsigned long n = 0; n < 256; n++) {
+            unsigned long c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xedb88320UL ^ (c >> 1) : c >> 1;
+            }
+            crcTable[n] = c;
+        }
+        crcTableComputed = true;
+    }
+
+    unsigned long updateCrc(unsigned long crc, const unsigned char* buf, unsigned long len) {
+        for (unsigned long n = 0; n < len; n++) {
+            crc = crcTable[(crc ^ buf[n]) & 0xff] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+    void putUInt32(std::vector<unsigned char> &out, unsigned long value) {
+        out.push_back((value >> 24) & 0xff);
+        out.push_back((value >> 16) & 0xff);
+        out.push_back((value >> 8) & 0xff);
+        out.push_back(value & 0xff);
+    }
+
+    void writeChunk(std::ostream &out, const char* type, const std::vector<unsigned char> &data) {
+        std::vector<unsigned char> chunk;
+        chunk.reserve(data.size() + 12);
+        putUInt32(chunk, data.size());
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), data.begin(), data.end());
+        unsigned long crc = updateCrc(0xffffffffUL, &chunk[4], data.size() + 4) ^ 0xffffffffUL;
+        putUInt32(chunk, crc);
+        out.write((const char*) &chunk[0], chunk.size());
+    }
+
+    // PNG with uncompressed (stored) deflate blocks, so no zlib is needed
+    bool writePNG(std::ostream &out, unsigned int width, unsigned int height, const std::vector<unsigned char> &pixels) {
+        const unsigned char signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+        out.write((const char*) signature, 8);
+
+        std::vector<unsigned char> header;
+        putUInt32(header, width);
+        putUInt32(header, height);
+        header.push_back(8);    // bit depth
+        header.push_back(2);    // truecolor
+        header.push_back(0);
+        header.push_back(0);
+        header.push_back(0);
+        writeChunk(out, "IHDR", header);
+
+        unsigned long rowSize = width * 3 + 1;
+        unsigned long rawSize = rowSize * height;
+        std::vector<unsigned char> data;
+        data.reserve(rawSize + rawSize / 65535 * 5 + 16);
+        data.push_back(0x78);
+        data.push_back(0x01);
+
+        unsigned long a = 1;
+        unsigned long b = 0;
+        unsigned long written = 0;
+        while (written < rawSize) {
+            unsigned long blockSize = std::min(rawSize - written, 65535UL);
+            data.push_back(written + blockSize == rawSize ? 1 : 0);
+            data.push_back(blockSize & 0xff);
+            data.push_back((blockSize >> 8) & 0xff);
+            data.push_back(~blockSize & 0xff);
+            data.push_back((~blockSize >> 8) & 0xff);
+            for (unsigned long i = written; i < written + blockSize; i++) {
+                unsigned char value = (i % rowSize == 0) ? 0 : pixels[(i / rowSize) * width * 3 + i % rowSize - 1];
+                data.push_back(value);
+                a = (a + value) % 65521;
+                b = (b + a) % 65521;
+            }
+            written += blockSize;
+        }
+        putUInt32(data, (b << 16) | a);
+        writeChunk(out, "IDAT", data);
+        writeChunk(out, "IEND", std::vector<unsigned char>());
+
+        return out.good();
+    }
+}
+
+ImageRenderer::ImageRenderer(unsigned int size, EImageFormat format, bool threaded) : fSize(size), fFormat(format),
+            fThreaded(threaded), fStopping(false) {
+    REQUIRE(size > 0, "The image size must be greater than 0");
+
+    ImageRenderer::_initCheck = this;
+
+    if (fFormat == PNGImage && !crcTableComputed) {
+        makeCrcTable();
+    }
+
+    pthread_mutex_init(&fMutex, NULL);
+    pthread_cond_init(&fQueueChanged, NULL);
+    if (fThreaded && pthread_create(&fWorker, NULL, &ImageRenderer::workerLoop, this) != 0) {
+        std::cerr << "Could not start the image writer thread, images will be written synchronously." << std::endl;
+        fThreaded = false;
+    }
+
+    ENSURE(properlyInitialized(), "ImageRenderer constructor did not end in an initialized state");
+}
+
+ImageRenderer::~ImageRenderer() {
+    if (fThreaded) {
+        pthread_mutex_lock(&fMutex);
+        fStopping = true;
+        pthread_cond_broadcast(&fQueueChanged);
+        pthread_mutex_unlock(&fMutex);
+        pthread_join(fWorker, NULL);
+    }
+    pthread_cond_destroy(&fQueueChanged);
+    pthread_mutex_destroy(&fMutex);
+}
+
+bool ImageRenderer::properlyInitialized() const {
+    return ImageRenderer::_initCheck == this;
+}
+
+void ImageRenderer::render(const TrafficSimulation &sim, const std::string &fileName) {
+    REQUIRE(properlyInitialized(), "ImageRenderer wasn't initialized when calling render()");
+    REQUIRE(sim.properlyInitialized(), "The simulation wasn't initialized when calling render()");
+
+    unsigned int width;
+    unsigned int height;
+    rasterize(sim, fPixels, width, height);
+
+    if (!fThreaded) {
+        if (!writeImage(fileName, width, height, fPixels, fFormat)) {
+            std::cerr << "Could not write image " << fileName << std::endl;
+        }
+        return;
+    }
+
+    // Only the pixel buffer is handed to the worker, the rasterizing itself stays on the simulation thread
+    pthread_mutex_lock(&fMutex);
+    while (fQueue.size() >= gMaxQueuedFrames) {
+        pthread_cond_wait(&fQueueChanged, &fMutex);
+    }
+    fQueue.push_back(Frame());
+    fQueue.back().fileName = fileName;
+    fQueue.back().width = width;
+    fQueue.back().height = height;
+    fQueue.back().pixels.swap(fPixels);
+    pthread_cond_broadcast(&fQueueChanged);
+    pthread_mutex_unlock(&fMutex);
+}
+
+void ImageRenderer::flush() {
+    REQUIRE(properlyInitialized(), "ImageRenderer wasn't initialized when calling flush()");
+
+    pthread_mutex_lock(&fMutex);
+    while (!fQueue.empty()) {
+        pthread_cond_wait(&fQueueChanged, &fMutex);
+    }
+    pthread_mutex_unlock(&fMutex);
+
+    ENSURE(fQueue.empty(), "flush() postcondition");
+}
+
+std::string ImageRenderer::getExtension() const {
+    REQUIRE(properlyInitialized(), "ImageRenderer wasn't initialized when calling getExtension()");
+
+    return fFormat == PNGImage ? ".png" : ".ppm";
+}
+
+void* ImageRenderer::workerLoop(void* renderer) {
+    ImageRenderer* self = static_cast<ImageRenderer*>(renderer);
+
+    pthread_mutex_lock(&self->fMutex);
+    while (true) {
+        while (self->fQueue.empty() && !self->fStopping) {
+            pthread_cond_wait(&self->fQueueChanged, &self->fMutex);
+        }
+        if (self->fQueue.empty()) {
+            break;
+        }
+        // The frame stays at the front of the queue while it is written so flush() waits for it
+        Frame &frame = self->fQueue.front();
+        pthread_mutex_unlock(&self->fMutex);
+
+        if (!writeImage(frame.fileName, frame.width, frame.height, frame.pixels, self->fFormat)) {
+            std::cerr << "Could not write image " << frame.fileName << std::endl;
+        }
+
+        pthread_mutex_lock(&self->fMutex);
+        self->fQueue.pop_front();
+        pthread_cond_broadcast(&self->fQueueChanged);
+    }
+    pthread_mutex_unlock(&self->fMutex);
+
+    return NULL;
+}
+
+void ImageRenderer::rasterize(const TrafficSimulation &sim, std::vector<unsigned char> &pixels, unsigned int &width,
+                              unsigned int &height) const {
+    const std::vector<Street*> &streets = sim.getStreets();
+
+    int maxLength = 0;
+    for (unsigned int k = 0; k < streets.size(); k++) {
+        maxLength = std::max(maxLength, streets[k]->getLength());
+    }
+
+    double scale = fSize / (maxLength + 2 * gMargin);
+    width = fSize;
+    height = std::max(1u, (unsigned int) std::ceil((streets.size() * gRowHeight + 2 * gMargin) * scale));
+    pixels.assign(width * height * 3, 255);
+
+    const Color road = makeColor(51, 51, 51);
+    const Color green = makeColor(0, 255, 0);
+    const Color red = makeColor(255, 0, 0);
+    const Color blue = makeColor(0, 0, 255);
+
+    for (unsigned int k = 0; k < streets.size(); k++) {
+        double top = gMargin + k * gRowHeight;
+        fillRect(pixels, width, height, scale, gMargin, top + 6, gMargin + streets[k]->getLength(), top + 14, road);
+
+        const std::vector<TrafficLight*> &trafficLights = streets[k]->getTrafficLights();
+        for (unsigned int l = 0; l < trafficLights.size(); l++) {
+            double x = gMargin + trafficLights[l]->getPosition();
+            fillRect(pixels, width, height, scale, x - 1.5, top + 1, x + 1.5, top + 4,
+                     trafficLights[l]->isGreen() ? green : red);
+        }
+
+        const std::vector<BusStop*> &busStops = streets[k]->getBusStops();
+        for (unsigned int l = 0; l < busStops.size(); l++) {
+            double x = gMargin + busStops[l]->getPosition();
+            fillRect(pixels, width, height, scale, x - 1.5, top + 16, x + 1.5, top + 19, blue);
+        }
+
+        const std::vector<Vehicle*> &vehicles = streets[k]->getVehicles();
+        for (unsigned int l = 0; l < vehicles.size(); l++) {
+            const unsigned char* rgb = vehicles[l]->getParameters().color;
+            Color color = makeColor(rgb[0], rgb[1], rgb[2]);
+            double front = gMargin + vehicles[l]->getPosition();
+            fillRect(pixels, width, height, scale, front - vehicles[l]->getLength(), top + 8, front, top + 12, color);
+        }
+    }
+}
+
+bool ImageRenderer::writeImage(const std::string &fileName, unsigned int width, unsigned int height,
+                               const std::vector<unsigned char> &pixels, EImageFormat format) {
+    std::ofstream out(fileName.c_str(), std::ios::out | std::ios::binary);
+    if (!out.is_open()) {
+        return false;
+    }
+    if (format == PNGImage) {
+        return writePNG(out, width, height, pixels);
+    }
+    out << "P6\n" << width << " " << height << "\n255\n";
+    out.write((const char*) &pixels[0], pixels.size());
+    return out.good();
+}
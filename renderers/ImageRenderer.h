@@ -0,0 +1,90 @@
+// ===========================================================
+// Name         : ImageRenderer.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `ImageRenderer` class which rasterizes a `TrafficSimulation` to a PPM or
+//                PNG image without the external engine
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_IMAGERENDERER_H
+#define TRAFFICSIMULATION_IMAGERENDERER_H
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <pthread.h>
+
+class TrafficSimulation;
+
+enum EImageFormat {
+    PPMImage,
+    PNGImage
+};
+
+class ImageRenderer {
+    struct Frame {
+        std::string fileName;
+        unsigned int width;
+        unsigned int height;
+        std::vector<unsigned char> pixels;
+    };
+
+    ImageRenderer* _initCheck;
+
+    unsigned int fSize;
+    EImageFormat fFormat;
+    bool fThreaded;
+
+    // Pixel buffer that is reused between frames, with a worker thread it is swapped into the queue instead
+    std::vector<unsigned char> fPixels;
+
+    // Frames waiting to be written by the worker thread
+    std::deque<Frame> fQueue;
+    bool fStopping;
+    pthread_t fWorker;
+    pthread_mutex_t fMutex;
+    pthread_cond_t fQueueChanged;
+
+    static void* workerLoop(void* renderer);
+
+    void rasterize(const TrafficSimulation &sim, std::vector<unsigned char> &pixels, unsigned int &width, unsigned int &height) const;
+
+    static bool writeImage(const std::string &fileName, unsigned int width, unsigned int height,
+                           const std::vector<unsigned char> &pixels, EImageFormat format);
+
+public:
+    /*
+     * REQUIRE(size > 0, "The image size must be greater than 0")
+     *
+     * ENSURE(properlyInitialized(), "ImageRenderer constructor did not end in an initialized state")
+     */
+    ImageRenderer(unsigned int size, EImageFormat format, bool threaded);
+
+    /*
+     * Writes all frames that are still queued before returning.
+     */
+    virtual ~ImageRenderer();
+
+    bool properlyInitialized() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "ImageRenderer wasn't initialized when calling render()")
+     * REQUIRE(sim.properlyInitialized(), "The simulation wasn't initialized when calling render()")
+     */
+    void render(const TrafficSimulation &sim, const std::string &fileName);
+
+    /*
+     * REQUIRE(properlyInitialized(), "ImageRenderer wasn't initialized when calling flush()")
+     *
+     * ENSURE(fQueue.empty(), "flush() postcondition")
+     */
+    void flush();
+
+    /*
+     * REQUIRE(properlyInitialized(), "ImageRenderer wasn't initialized when calling getExtension()")
+     */
+    std::string getExtension() const;
+};
+
+
+#endif
@@ -0,0 +1,248 @@
+// ===========================================================
+// Name         : RoadNetwork.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `RoadNetwork` class which holds the graph of the streets and crossroads
+//                and, for every destination street, whether a vehicle should turn at every crossroad
+// ===========================================================
+
+#include <map>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include "RoadNetwork.h"
+#include "../DesignByContract.h"
+#include "../objects/Street.h"
+
+RoadNetwork::RoadNetwork(const std::vector<Street*> &streets, const std::vector<unsigned int> &destinations) :
+            fStreets(streets.size()) {
+    std::map<const Street*, unsigned int> indices;
+    unsigned int maximumIndex = 0;
+    for (unsigned int i = 0; i < fStreets; i++) {
+        indices[streets[i]] = i;
+        maximumIndex = std::max(maximumIndex, streets[i]->getIndex());
+    }
+    fStreetIndices.assign(fStreets > 0 ? maximumIndex + 1 : 0, -1);
+    for (unsigned int i = 0; i < fStreets; i++) {
+        REQUIRE(fStreetIndices[streets[i]->getIndex()] < 0, "Two streets of the network have the same index");
+        fStreetIndices[streets[i]->getIndex()] = i;
+    }
+
+    // The crossroads sorted on the crossing street, with their position on both streets
+    std::vector<int> positions;
+    std::vector<int> crossingPositions;
+    fFirstCrossroads.push_back(0);
+    for (unsigned int s = 0; s < fStreets; s++) {
+        std::vector<std::pair<unsigned int, std::pair<int, int> > > crossroads;
+        const std::map<Street*,int> &map = streets[s]->getCrossroads();
+        for (std::map<Street*,int>::const_iterator it = map.begin(); it != map.end(); it++) {
+            int crossingPosition = it->first->getCrossroads().count(streets[s]) > 0 ? it->first->getCrossroads().find(streets[s])->second : -1;
+            crossroads.push_back(std::make_pair(indices[it->first], std::make_pair(it->second, crossingPosition)));
+        }
+        std::sort(crossroads.begin(), crossroads.end());
+        for (unsigned int c = 0; c < crossroads.size(); c++) {
+            fCrossroadStreets.push_back(crossroads[c].first);
+            positions.push_back(crossroads[c].second.first);
+            crossingPositions.push_back(crossroads[c].second.second);
+        }
+        fFirstCrossroads.push_back(fCrossroadStreets.size());
+    }
+    unsigned int crossroads = fCrossroadStreets.size();
+
+    // The nodes of every street: its crossroads and its end, sorted on their position
+    std::vector<std::vector<int> > points(fStreets);
+    fFirstNodes.push_back(0);
+    for (unsigned int s = 0; s < fStreets; s++) {
+        for (unsigned int c = fFirstCrossroads[s]; c < fFirstCrossroads[s+1]; c++) {
+            if (positions[c] >= 0 && positions[c] < streets[s]->getLength()) {
+                points[s].push_back(positions[c]);
+            }
+        }
+        points[s].push_back(streets[s]->getLength());
+        std::sort(points[s].begin(), points[s].end());
+        points[s].erase(std::unique(points[s].begin(), points[s].end()), points[s].end());
+        fFirstNodes.push_back(fFirstNodes.back() + points[s].size());
+        fStarts.push_back(points[s][0]);
+    }
+    unsigned int nodes = fFirstNodes.back();
+
+    // The reversed edges as (node where they end, (node where they start, length)), grouped per node afterwards
+    std::vector<std::pair<unsigned int, std::pair<unsigned int, double> > > edges;
+    for (unsigned int s = 0; s < fStreets; s++) {
+        for (unsigned int j = 1; j < points[s].size(); j++) {
+            edges.push_back(std::make_pair(fFirstNodes[s] + j, std::make_pair(fFirstNodes[s] + j - 1, (double) points[s][j] - points[s][j-1])));
+        }
+    }
+    // A turn leads to the first node after the crossroad on the crossing street
+    fTurnNodes.assign(crossroads, -1);
+    fStraightNodes.assign(crossroads, -1);
+    fTurnLengths.assign(crossroads, 0);
+    fStraightLengths.assign(crossroads, 0);
+    for (unsigned int s = 0; s < fStreets; s++) {
+        for (unsigned int c = fFirstCrossroads[s]; c < fFirstCrossroads[s+1]; c++) {
+            unsigned int t = fCrossroadStreets[c];
+            if (positions[c] < 0 || positions[c] >= streets[s]->getLength() || crossingPositions[c] < 0
+                    || crossingPositions[c] >= streets[t]->getLength()) {
+                continue;
+            }
+            unsigned int point = std::lower_bound(points[s].begin(), points[s].end(), positions[c]) - points[s].begin();
+            unsigned int next = std::upper_bound(points[t].begin(), points[t].end(), crossingPositions[c]) - points[t].begin();
+            fTurnNodes[c] = fFirstNodes[t] + next;
+            fTurnLengths[c] = points[t][next] - crossingPositions[c];
+            fStraightNodes[c] = fFirstNodes[s] + point + 1;
+            fStraightLengths[c] = points[s][point + 1] - positions[c];
+            edges.push_back(std::make_pair((unsigned int) fTurnNodes[c], std::make_pair(fFirstNodes[s] + point, fTurnLengths[c])));
+        }
+    }
+    fFirstEdges.assign(nodes + 1, 0);
+    for (unsigned int e = 0; e < edges.size(); e++) {
+        fFirstEdges[edges[e].first + 1]++;
+    }
+    for (unsigned int n = 0; n < nodes; n++) {
+        fFirstEdges[n + 1] += fFirstEdges[n];
+    }
+    fEdges.resize(edges.size());
+    std::vector<unsigned int> next(fFirstEdges.begin(), fFirstEdges.end() - 1);
+    for (unsigned int e = 0; e < edges.size(); e++) {
+        fEdges[next[edges[e].first]++] = edges[e].second;
+    }
+
+    const double infinity = std::numeric_limits<double>::infinity();
+    fRoutes.assign(fStreets, -1);
+    unsigned int rows = 0;
+    for (unsigned int i = 0; i < destinations.size(); i++) {
+        if (destinations[i] < fStreetIndices.size() && fStreetIndices[destinations[i]] >= 0
+                && fRoutes[fStreetIndices[destinations[i]]] < 0) {
+            fRoutes[fStreetIndices[destinations[i]]] = rows++;
+        }
+    }
+    fChoices.assign(rows * crossroads, RouteStraight);
+    std::vector<double> distances;
+    for (unsigned int d = 0; d < fStreets; d++) {
+        if (fRoutes[d] < 0) {
+            continue;
+        }
+        computeDistances(d, distances);
+        for (unsigned int c = 0; c < crossroads; c++) {
+            if (fTurnNodes[c] < 0) {
+                continue;
+            }
+            double turn = fTurnLengths[c] + distances[fTurnNodes[c]];
+            double straight = fStraightLengths[c] + distances[fStraightNodes[c]];
+            if (turn == infinity && straight == infinity) {
+                fChoices[fRoutes[d] * crossroads + c] = RouteUnknown;
+            } else if (turn < straight) {
+                fChoices[fRoutes[d] * crossroads + c] = RouteTurn;
+            }
+        }
+    }
+
+    indexCrossroads(streets);
+    RoadNetwork::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "RoadNetwork constructor did not end in an initialized state");
+}
+
+RoadNetwork::~RoadNetwork() {}
+
+bool RoadNetwork::properlyInitialized() const {
+    return RoadNetwork::_initCheck == this;
+}
+
+void RoadNetwork::computeDistances(unsigned int destination, std::vector<double> &distances) const {
+    distances.assign(fFirstNodes.back(), std::numeric_limits<double>::infinity());
+    std::priority_queue<std::pair<double, unsigned int>, std::vector<std::pair<double, unsigned int> >,
+                        std::greater<std::pair<double, unsigned int> > > queue;
+    unsigned int end = fFirstNodes[destination + 1] - 1;
+    distances[end] = 0;
+    queue.push(std::make_pair(0.0, end));
+    while (!queue.empty()) {
+        std::pair<double, unsigned int> top = queue.top();
+        queue.pop();
+        if (top.first > distances[top.second]) {
+            continue;
+        }
+        for (unsigned int e = fFirstEdges[top.second]; e < fFirstEdges[top.second + 1]; e++) {
+            double distance = top.first + fEdges[e].second;
+            if (distance < distances[fEdges[e].first]) {
+                distances[fEdges[e].first] = distance;
+                queue.push(std::make_pair(distance, fEdges[e].first));
+            }
+        }
+    }
+}
+
+void RoadNetwork::indexCrossroads(const std::vector<Street*> &streets) {
+    std::map<const Street*, unsigned int> indices;
+    for (unsigned int i = 0; i < fStreets; i++) {
+        indices[streets[i]] = i;
+    }
+    fMapCrossroads.assign(fCrossroadStreets.size(), 0);
+    for (unsigned int s = 0; s < fStreets; s++) {
+        std::vector<unsigned int>::const_iterator first = fCrossroadStreets.begin() + fFirstCrossroads[s];
+        std::vector<unsigned int>::const_iterator last = fCrossroadStreets.begin() + fFirstCrossroads[s+1];
+        const std::map<Street*,int> &map = streets[s]->getCrossroads();
+        unsigned int k = fFirstCrossroads[s];
+        for (std::map<Street*,int>::const_iterator it = map.begin(); it != map.end(); it++) {
+            fMapCrossroads[k++] = std::lower_bound(first, last, indices[it->first]) - fCrossroadStreets.begin();
+        }
+    }
+}
+
+RoadNetwork *RoadNetwork::clone(const std::vector<Street*> &streets) const {
+    REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling clone()");
+    REQUIRE(streets.size() == getStreetCount(), "The copy must have the same streets");
+
+    RoadNetwork* copy = new RoadNetwork(*this);
+    copy->_initCheck = copy;
+    copy->indexCrossroads(streets);
+
+    ENSURE(copy->properlyInitialized(), "clone() postcondition");
+
+    return copy;
+}
+
+unsigned int RoadNetwork::getStreetCount() const {
+    REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling getStreetCount()");
+
+    return fStreets;
+}
+
+unsigned int RoadNetwork::getCrossroadCount() const {
+    REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling getCrossroadCount()");
+
+    return fCrossroadStreets.size();
+}
+
+bool RoadNetwork::contains(unsigned int street) const {
+    REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling contains()");
+
+    return street < fStreetIndices.size() && fStreetIndices[street] >= 0;
+}
+
+bool RoadNetwork::hasRoutes(unsigned int destination) const {
+    REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling hasRoutes()");
+
+    return contains(destination) && fRoutes[fStreetIndices[destination]] >= 0;
+}
+
+ERouteChoice RoadNetwork::getChoice(unsigned int destination, unsigned int street, unsigned int crossroad) const {
+    REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling getChoice()");
+    REQUIRE(hasRoutes(destination), "The routes to the destination weren't computed");
+    REQUIRE(street < getStreetCount(), "The street isn't part of the network");
+    REQUIRE(fFirstCrossroads[street] + crossroad < fFirstCrossroads[street + 1], "The street doesn't have that crossroad");
+
+    unsigned int index = fMapCrossroads[fFirstCrossroads[street] + crossroad];
+    return (ERouteChoice) fChoices[fRoutes[fStreetIndices[destination]] * fCrossroadStreets.size() + index];
+}
+
+double RoadNetwork::getDistance(unsigned int street, unsigned int destination) const {
+    REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling getDistance()");
+    REQUIRE(contains(destination), "The destination isn't part of the network");
+    REQUIRE(street < getStreetCount(), "The street isn't part of the network");
+
+    std::vector<double> distances;
+    computeDistances(fStreetIndices[destination], distances);
+    double distance = fStarts[street] + distances[fFirstNodes[street]];
+    return distance == std::numeric_limits<double>::infinity() ? -1 : distance;
+}
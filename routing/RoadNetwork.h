@@ -0,0 +1,148 @@
+// ===========================================================
+// Name         : RoadNetwork.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `RoadNetwork` class which holds the graph of the streets and crossroads
+//                and, for every destination street, whether a vehicle should turn at every crossroad
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_ROADNETWORK_H
+#define TRAFFICSIMULATION_ROADNETWORK_H
+
+#include <vector>
+
+class Street;
+
+enum ERouteChoice {
+    RouteStraight,
+    RouteTurn,
+    // The destination can't be reached from the crossroad
+    RouteUnknown
+};
+
+/*
+ * The nodes of the graph are the crossroads and the end of every street, the edges are the parts of the streets between
+ * them and the turns at the crossroads. A vehicle that turned drives on to the next node before it can turn again, like
+ * in TrafficSimulation::simCrossroads(). Only for the streets that are a destination the shortest distances to the end
+ * of that street are computed, once with Dijkstra's algorithm, and turned into a table with the choice at every
+ * crossroad, so the network stays linear in the size of the graph when few streets are a destination.
+ *
+ * A crossroad of a street is known by the position of the crossing street in the crossroad map of the street, which
+ * depends on the addresses of the streets. The tables themselves are indexed in an order that doesn't, so a copy of
+ * the simulation only has to renumber the crossroads, see clone().
+ */
+class RoadNetwork {
+    RoadNetwork* _initCheck;
+
+    unsigned int fStreets;
+    // The crossroads of street s are fFirstCrossroads[s] up to fFirstCrossroads[s+1]
+    std::vector<unsigned int> fFirstCrossroads;
+    // The crossing street of every crossroad, the crossroads of a street are sorted on it
+    std::vector<unsigned int> fCrossroadStreets;
+    // The table index of the k-th crossroad in the crossroad map of street s is fMapCrossroads[fFirstCrossroads[s] + k]
+    std::vector<unsigned int> fMapCrossroads;
+    // Position of every street in the network by its index (Street::getIndex()), -1 for streets outside the network
+    std::vector<int> fStreetIndices;
+
+    // The nodes of street s are fFirstNodes[s] up to fFirstNodes[s+1], the last one is its end. fStarts[s] is the
+    // distance (in m) from the start of street s to its first node
+    std::vector<unsigned int> fFirstNodes;
+    std::vector<double> fStarts;
+    // The edges are stored reversed, from the node where they end, as the routes are searched from the destination:
+    // the edges into node n are fEdges[fFirstEdges[n]] up to fEdges[fFirstEdges[n+1]], with the node they come from
+    std::vector<unsigned int> fFirstEdges;
+    std::vector<std::pair<unsigned int, double> > fEdges;
+    // The node after every crossroad when turning and when driving straight on, -1 if the crossroad can't be taken
+    std::vector<int> fTurnNodes;
+    std::vector<int> fStraightNodes;
+    std::vector<double> fTurnLengths;
+    std::vector<double> fStraightLengths;
+
+    // The row of the choices for every street of the network that is a destination, -1 for the other streets
+    std::vector<int> fRoutes;
+    // The choice at crossroad c for the destination with row r is fChoices[r * crossroads + c]
+    std::vector<unsigned char> fChoices;
+
+    // Computes the shortest distance (in m) from every node to the end of street number `destination`, infinite if
+    // it can't be reached
+    void computeDistances(unsigned int destination, std::vector<double> &distances) const;
+
+    // Numbers the crossroads in the order of the crossroad maps of `streets`
+    void indexCrossroads(const std::vector<Street*> &streets);
+
+public:
+    /*
+     * Builds the graph of `streets` and computes the routes to every street of `destinations` that is part of it. The
+     * streets and destinations are known by their index, which may skip the streets of another partition but must
+     * differ for every street.
+     *
+     * REQUIRE(fStreetIndices[streets[i]->getIndex()] < 0, "Two streets of the network have the same index")
+     *
+     * ENSURE(properlyInitialized(), "RoadNetwork constructor did not end in an initialized state")
+     */
+    RoadNetwork(const std::vector<Street*> &streets, const std::vector<unsigned int> &destinations);
+
+    virtual ~RoadNetwork();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Returns a copy of this network that is owned by the caller, for `streets`, a copy of the streets of this network
+     * in the same order. The routes are not computed again.
+     *
+     * REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling clone()")
+     * REQUIRE(streets.size() == getStreetCount(), "The copy must have the same streets")
+     *
+     * ENSURE(copy->properlyInitialized(), "clone() postcondition")
+     */
+    RoadNetwork* clone(const std::vector<Street*> &streets) const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling getStreetCount()")
+     */
+    unsigned int getStreetCount() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling getCrossroadCount()")
+     */
+    unsigned int getCrossroadCount() const;
+
+    /*
+     * Returns whether the street with index `street` (Street::getIndex()) belongs to the network.
+     *
+     * REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling contains()")
+     */
+    bool contains(unsigned int street) const;
+
+    /*
+     * Returns whether the routes to the street with index `destination` were computed.
+     *
+     * REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling hasRoutes()")
+     */
+    bool hasRoutes(unsigned int destination) const;
+
+    /*
+     * Returns the choice of a vehicle headed for the end of `destination` (the index of a street) at the crossroad
+     * that is the `crossroad`-th element of the crossroad map of street number `street`.
+     *
+     * REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling getChoice()")
+     * REQUIRE(hasRoutes(destination), "The routes to the destination weren't computed")
+     * REQUIRE(street < getStreetCount(), "The street isn't part of the network")
+     * REQUIRE(fFirstCrossroads[street] + crossroad < fFirstCrossroads[street + 1], "The street doesn't have that crossroad")
+     */
+    ERouteChoice getChoice(unsigned int destination, unsigned int street, unsigned int crossroad) const;
+
+    /*
+     * Returns the length (in m) of the shortest route from the start of street number `street` to the end of
+     * `destination` (the index of a street), -1 if there is none. It is searched again on every call, also for a
+     * destination without routes.
+     *
+     * REQUIRE(properlyInitialized(), "RoadNetwork wasn't initialized when calling getDistance()")
+     * REQUIRE(contains(destination), "The destination isn't part of the network")
+     * REQUIRE(street < getStreetCount(), "The street isn't part of the network")
+     */
+    double getDistance(unsigned int street, unsigned int destination) const;
+};
+
+
+#endif
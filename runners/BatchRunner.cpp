@@ -0,0 +1,262 @@
+// ===========================================================
+// Name         : BatchRunner.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `BatchRunner` class which runs the jobs of a manifest on a pool of
+//                threads, every scenario file is parsed only once
+// ===========================================================
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <pthread.h>
+#include "BatchRunner.h"
+#include "../DesignByContract.h"
+#include "../TrafficSimulation.h"
+#include "../objects/Street.h"
+
+BatchRunner::BatchRunner(unsigned int threads, unsigned int seed) : fThreads(threads), fSeed(seed), fParsing(false),
+            fNext(0) {
+    REQUIRE(threads > 0, "A batch needs at least one thread");
+
+    BatchRunner::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "BatchRunner constructor did not end in an initialized state");
+}
+
+BatchRunner::~BatchRunner() {}
+
+bool BatchRunner::properlyInitialized() const {
+    return BatchRunner::_initCheck == this;
+}
+
+bool BatchRunner::parseManifest(const std::string &filename, std::ostream &errStream) {
+    REQUIRE(properlyInitialized(), "BatchRunner wasn't initialized when calling parseManifest()");
+
+    std::ifstream manifest(filename.c_str());
+    if (!manifest.is_open()) {
+        errStream << "MANIFEST ERROR: Couldn't open " << filename << "." << std::endl;
+        return false;
+    }
+
+    std::string directory;
+    std::string::size_type slash = filename.find_last_of('/');
+    if (slash != std::string::npos) {
+        directory = filename.substr(0, slash + 1);
+    }
+
+    std::string line;
+    unsigned int lineNumber = 0;
+    while (std::getline(manifest, line)) {
+        lineNumber++;
+        std::istringstream fields(line);
+        std::string scenario;
+        std::string output;
+        int repetitions;
+        if (!(fields >> scenario) || scenario[0] == '#') {
+            continue;
+        }
+        std::string rest;
+        if ((fields >> repetitions).fail() || repetitions < 1 || !(fields >> output) || fields >> rest) {
+            errStream << "MANIFEST ERROR: Line " << lineNumber << " is not of the form "
+                      << "\"<scenario> <repetitions> <output>\", it is skipped." << std::endl;
+            continue;
+        }
+        if (scenario[0] != '/') {
+            scenario = directory + scenario;
+        }
+        if (output[0] != '/') {
+            output = directory + output;
+        }
+        addJob(scenario, repetitions, output);
+    }
+    return true;
+}
+
+void BatchRunner::addJob(const std::string &scenario, unsigned int repetitions, const std::string &output) {
+    REQUIRE(properlyInitialized(), "BatchRunner wasn't initialized when calling addJob()");
+    REQUIRE(repetitions > 0, "A job needs at least one repetition");
+
+    unsigned int oldCount = getJobCount();
+
+    BatchJob job;
+    job.scenario = scenario;
+    job.repetitions = repetitions;
+    job.output = output;
+    job.status = JobPending;
+    job.importLog = "";
+    job.time = 0;
+    job.vehicles = 0;
+    job.exitedVehicles = 0;
+    fJobs.push_back(job);
+
+    ENSURE(getJobCount() == oldCount + 1, "addJob() postcondition");
+}
+
+unsigned int BatchRunner::getJobCount() const {
+    REQUIRE(properlyInitialized(), "BatchRunner wasn't initialized when calling getJobCount()");
+
+    return fJobs.size();
+}
+
+const BatchJob &BatchRunner::getJob(unsigned int job) const {
+    REQUIRE(properlyInitialized(), "BatchRunner wasn't initialized when calling getJob()");
+    REQUIRE(job < getJobCount(), "The job is not in the batch");
+
+    return fJobs[job];
+}
+
+void *BatchRunner::workerLoop(void *runner) {
+    BatchRunner* self = static_cast<BatchRunner*>(runner);
+    unsigned int count = self->fParsing ? self->fCache.size() : self->fJobs.size();
+    while (true) {
+        unsigned int next = __sync_fetch_and_add(&self->fNext, 1);
+        if (next >= count) {
+            break;
+        }
+        if (self->fParsing) {
+            std::ostringstream errors;
+            self->fCacheSuccess[next] = self->fCache[next]->parseInputFile(self->fCacheFiles[next], errors);
+            self->fCacheLogs[next] = errors.str();
+        } else {
+            self->runJob(self->fJobs[next]);
+        }
+    }
+    return NULL;
+}
+
+void BatchRunner::runWorkers() {
+    fNext = 0;
+    unsigned int count = fParsing ? fCache.size() : fJobs.size();
+    unsigned int threadCount = std::max(1u, std::min(fThreads, count));
+    std::vector<pthread_t> workers(threadCount - 1);
+    unsigned int started = 0;
+    for (; started < workers.size(); started++) {
+        if (pthread_create(&workers[started], NULL, &BatchRunner::workerLoop, this) != 0) {
+            break;
+        }
+    }
+    // The calling thread works as well, so the batch still finishes if no thread could be started
+    workerLoop(this);
+    for (unsigned int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+}
+
+void BatchRunner::runJob(BatchJob &job) {
+    unsigned int scenario = fCacheIndex.find(job.scenario)->second;
+    job.importLog = fCacheLogs[scenario];
+    if (fCacheSuccess[scenario] == ImportAborted) {
+        job.status = JobImportAborted;
+        return;
+    }
+
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    sim.copySimulation(*fCache[scenario]);
+    sim.setSeed(fSeed);
+    for (unsigned int i = 0; i < job.repetitions; i++) {
+        sim.simulate();
+    }
+
+    job.time = sim.getTime();
+    job.vehicles = 0;
+    job.exitedVehicles = 0;
+    const std::vector<Street*> &streets = sim.getStreets();
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        job.vehicles += streets[i]->getVehicles().size();
+        job.exitedVehicles += streets[i]->getFinishedVehicles();
+    }
+
+    std::ofstream output(job.output.c_str());
+    if (!output.is_open()) {
+        job.status = JobOutputFailed;
+    } else {
+        sim.writeOn(output);
+        if (!output.good()) {
+            job.status = JobOutputFailed;
+        } else {
+            job.status = fCacheSuccess[scenario] == PartialImport ? JobPartialImport : JobSucceeded;
+        }
+    }
+    sim.clearSimulation();
+}
+
+void BatchRunner::run() {
+    REQUIRE(properlyInitialized(), "BatchRunner wasn't initialized when calling run()");
+
+    // The cache is only resized here, the workers only fill in its entries
+    for (unsigned int i = 0; i < fJobs.size(); i++) {
+        fJobs[i].status = JobPending;
+        if (fCacheIndex.find(fJobs[i].scenario) == fCacheIndex.end()) {
+            unsigned int index = fCache.size();
+            fCacheIndex[fJobs[i].scenario] = index;
+            fCacheFiles.push_back(fJobs[i].scenario);
+            TrafficSimulation* scenario = new TrafficSimulation();
+            scenario->setLogStream(NULL);
+            fCache.push_back(scenario);
+        }
+    }
+    fCacheSuccess.assign(fCache.size(), ImportAborted);
+    fCacheLogs.assign(fCache.size(), "");
+
+    fParsing = true;
+    runWorkers();
+    fParsing = false;
+    runWorkers();
+
+    for (unsigned int i = 0; i < fCache.size(); i++) {
+        fCache[i]->clearSimulation();
+        delete fCache[i];
+    }
+    fCache.clear();
+    fCacheIndex.clear();
+    fCacheFiles.clear();
+    fCacheSuccess.clear();
+    fCacheLogs.clear();
+
+    ENSURE(fCache.empty(), "run() postcondition");
+}
+
+void BatchRunner::writeOn(std::ostream &onstream) const {
+    REQUIRE(properlyInitialized(), "BatchRunner wasn't initialized when calling writeOn()");
+    REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeOn()");
+
+    unsigned int succeeded = 0;
+    for (unsigned int i = 0; i < fJobs.size(); i++) {
+        const BatchJob &job = fJobs[i];
+        onstream << "Job " << i + 1 << ": " << job.scenario << " -> " << job.output << std::endl;
+        switch (job.status) {
+            case JobPending:
+                onstream << "-> niet uitgevoerd" << std::endl;
+                break;
+            case JobImportAborted:
+                onstream << "-> fout: de simulatie kon niet ingelezen worden" << std::endl;
+                break;
+            case JobOutputFailed:
+                onstream << "-> fout: het resultaat kon niet geschreven worden" << std::endl;
+                break;
+            case JobPartialImport:
+            case JobSucceeded:
+                if (job.status == JobPartialImport) {
+                    onstream << "-> waarschuwing: de simulatie werd slechts gedeeltelijk ingelezen" << std::endl;
+                } else {
+                    succeeded++;
+                }
+                onstream << "-> tijd: " << job.time << std::endl
+                         << "-> voertuigen: " << job.vehicles << std::endl
+                         << "-> voertuigen die het netwerk verlieten: " << job.exitedVehicles << std::endl;
+                break;
+        }
+        // Every error the parser reported for the scenario
+        std::istringstream log(job.importLog);
+        std::string line;
+        while (std::getline(log, line)) {
+            onstream << "   " << line << std::endl;
+        }
+        onstream << std::endl;
+    }
+    onstream << "Geslaagd: " << succeeded << "/" << fJobs.size() << std::endl;
+
+    ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeOn()");
+}
@@ -0,0 +1,131 @@
+// ===========================================================
+// Name         : BatchRunner.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `BatchRunner` class which runs the jobs of a manifest on a pool of
+//                threads, every scenario file is parsed only once
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_BATCHRUNNER_H
+#define TRAFFICSIMULATION_BATCHRUNNER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include "../parsers/ElementParser.h"
+
+class TrafficSimulation;
+
+enum EBatchJobStatus {
+    JobPending,
+    JobSucceeded,
+    // Simulated, but the scenario was only partially imported
+    JobPartialImport,
+    JobImportAborted,
+    JobOutputFailed
+};
+
+struct BatchJob {
+    std::string scenario;
+    unsigned int repetitions;
+    std::string output;
+
+    EBatchJobStatus status;
+    // The errors of parsing the scenario
+    std::string importLog;
+    double time;
+    unsigned int vehicles;
+    unsigned int exitedVehicles;
+};
+
+class BatchRunner {
+    BatchRunner* _initCheck;
+
+    unsigned int fThreads;
+    unsigned int fSeed;
+    std::vector<BatchJob> fJobs;
+
+    // During run() the workers first parse every scenario once, then they run the jobs on copies of the parsed
+    // scenarios
+    bool fParsing;
+    // Index of the next scenario or job a worker will pick up
+    unsigned int fNext;
+    std::map<std::string, unsigned int> fCacheIndex;
+    std::vector<std::string> fCacheFiles;
+    std::vector<TrafficSimulation*> fCache;
+    std::vector<EParserSuccess> fCacheSuccess;
+    std::vector<std::string> fCacheLogs;
+
+    static void* workerLoop(void* runner);
+
+    void runWorkers();
+
+    void runJob(BatchJob &job);
+
+public:
+    /*
+     * Every job is seeded with `seed`, so a batch gives the same results regardless of the amount of threads.
+     *
+     * REQUIRE(threads > 0, "A batch needs at least one thread")
+     *
+     * ENSURE(properlyInitialized(), "BatchRunner constructor did not end in an initialized state")
+     */
+    BatchRunner(unsigned int threads, unsigned int seed);
+
+    virtual ~BatchRunner();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Reads the jobs of a manifest. Every line contains a scenario, the amount of repetitions and the output file,
+     * separated by whitespace. Empty lines and lines starting with '#' are skipped. Relative paths are relative to
+     * the directory of the manifest. Returns false if the manifest can't be opened, lines that aren't a valid job
+     * are reported on `errStream` and skipped.
+     *
+     * REQUIRE(properlyInitialized(), "BatchRunner wasn't initialized when calling parseManifest()")
+     */
+    bool parseManifest(const std::string &filename, std::ostream &errStream = std::cerr);
+
+    /*
+     * REQUIRE(properlyInitialized(), "BatchRunner wasn't initialized when calling addJob()")
+     * REQUIRE(repetitions > 0, "A job needs at least one repetition")
+     *
+     * ENSURE(getJobCount() == old getJobCount() + 1, "addJob() postcondition")
+     */
+    void addJob(const std::string &scenario, unsigned int repetitions, const std::string &output);
+
+    /*
+     * REQUIRE(properlyInitialized(), "BatchRunner wasn't initialized when calling getJobCount()")
+     */
+    unsigned int getJobCount() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "BatchRunner wasn't initialized when calling getJob()")
+     * REQUIRE(job < getJobCount(), "The job is not in the batch")
+     */
+    const BatchJob &getJob(unsigned int job) const;
+
+    /*
+     * Simulates every job and writes its final state to its output file.
+     *
+     * REQUIRE(properlyInitialized(), "BatchRunner wasn't initialized when calling run()")
+     *
+     * ENSURE(fCache.empty(), "run() postcondition")
+     */
+    void run();
+
+    /*
+     * Writes the result of every job, with the import errors of its scenario, and the amount of jobs that fully
+     * succeeded.
+     *
+     * REQUIRE(properlyInitialized(), "BatchRunner wasn't initialized when calling writeOn()")
+     * REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeOn()")
+     *
+     * ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeOn()")
+     */
+    void writeOn(std::ostream &onstream = std::cout) const;
+};
+
+
+#endif
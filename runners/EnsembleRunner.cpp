@@ -0,0 +1,220 @@
+// ===========================================================
+// Name         : EnsembleRunner.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `EnsembleRunner` class which runs independent replicas of a loaded
+//                `TrafficSimulation` on a pool of threads and aggregates their statistics
+// ===========================================================
+
+#include <cmath>
+#include <algorithm>
+#include <pthread.h>
+#include "EnsembleRunner.h"
+#include "../DesignByContract.h"
+#include "../Variables.h"
+#include "../TrafficSimulation.h"
+#include "../objects/Street.h"
+
+namespace {
+    // 97.5% quantiles of the Student t-distribution for 1 to 30 degrees of freedom
+    const double gStudentT[30] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                  2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                  2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    const double gNormalQuantile = 1.960;
+}
+
+EnsembleRunner::EnsembleRunner(const TrafficSimulation &scenario, unsigned int replicas, unsigned int threads, unsigned int seed) :
+            fScenario(&scenario), fReplicas(replicas), fThreads(threads), fSeed(seed), fTicks(0), fNextReplica(0) {
+    REQUIRE(scenario.properlyInitialized(), "The scenario wasn't initialized when constructing an EnsembleRunner");
+    REQUIRE(replicas > 0, "An ensemble needs at least one replica");
+    REQUIRE(threads > 0, "An ensemble needs at least one thread");
+
+    EnsembleRunner::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "EnsembleRunner constructor did not end in an initialized state");
+}
+
+EnsembleRunner::~EnsembleRunner() {}
+
+bool EnsembleRunner::properlyInitialized() const {
+    return EnsembleRunner::_initCheck == this;
+}
+
+void *EnsembleRunner::workerLoop(void *runner) {
+    EnsembleRunner* self = static_cast<EnsembleRunner*>(runner);
+    while (true) {
+        unsigned int replica = __sync_fetch_and_add(&self->fNextReplica, 1);
+        if (replica >= self->fReplicas) {
+            break;
+        }
+        self->runReplica(replica);
+    }
+    return NULL;
+}
+
+void EnsembleRunner::runReplica(unsigned int replica) {
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    sim.copySimulation(*fScenario);
+    sim.setSeed(fSeed + replica);
+
+    const std::vector<Street*> &streets = sim.getStreets();
+    ReplicaResult &result = fResults[replica];
+    result.throughput.assign(streets.size(), 0);
+    result.queueLength.assign(streets.size(), 0);
+
+    // The scenario may already have been simulated, only what happens in this replica counts
+    std::vector<unsigned int> startExited(streets.size());
+    unsigned int startFinished = 0;
+    double startTravelTime = 0;
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        startExited[i] = streets[i]->getExitedVehicles();
+        startFinished += streets[i]->getFinishedVehicles();
+        startTravelTime += streets[i]->getFinishedTravelTime();
+    }
+
+    for (unsigned int tick = 0; tick < fTicks; tick++) {
+        sim.simulate();
+        for (unsigned int i = 0; i < streets.size(); i++) {
+            result.queueLength[i] += streets[i]->getQueueLength();
+        }
+    }
+
+    double hours = fTicks * gSimulationTime / 3600;
+    unsigned int finished = 0;
+    double travelTime = 0;
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        result.throughput[i] = hours > 0 ? (streets[i]->getExitedVehicles() - startExited[i]) / hours : 0;
+        if (fTicks > 0) {
+            result.queueLength[i] /= fTicks;
+        }
+        finished += streets[i]->getFinishedVehicles();
+        travelTime += streets[i]->getFinishedTravelTime();
+    }
+    result.finishedVehicles = finished - startFinished;
+    result.travelTime = result.finishedVehicles > 0 ? (travelTime - startTravelTime) / result.finishedVehicles : 0;
+}
+
+void EnsembleRunner::run(unsigned int ticks) {
+    REQUIRE(properlyInitialized(), "EnsembleRunner wasn't initialized when calling run()");
+
+    fTicks = ticks;
+    fNextReplica = 0;
+    fResults.assign(fReplicas, ReplicaResult());
+
+    unsigned int threadCount = std::min(fThreads, fReplicas);
+    std::vector<pthread_t> workers(threadCount - 1);
+    unsigned int started = 0;
+    for (; started < workers.size(); started++) {
+        if (pthread_create(&workers[started], NULL, &EnsembleRunner::workerLoop, this) != 0) {
+            break;
+        }
+    }
+    // The calling thread works as well, so the ensemble still finishes if no thread could be started
+    workerLoop(this);
+    for (unsigned int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    ENSURE(fResults.size() == fReplicas, "run() postcondition");
+}
+
+EnsembleStatistic EnsembleRunner::aggregate(const std::vector<double> &samples) {
+    EnsembleStatistic statistic;
+    statistic.mean = 0;
+    statistic.halfWidth = 0;
+    statistic.samples = samples.size();
+    if (samples.empty()) {
+        return statistic;
+    }
+
+    for (unsigned int i = 0; i < samples.size(); i++) {
+        statistic.mean += samples[i];
+    }
+    statistic.mean /= samples.size();
+
+    if (samples.size() > 1) {
+        double variance = 0;
+        for (unsigned int i = 0; i < samples.size(); i++) {
+            variance += (samples[i] - statistic.mean) * (samples[i] - statistic.mean);
+        }
+        variance /= samples.size() - 1;
+        unsigned int degrees = samples.size() - 1;
+        double quantile = degrees <= 30 ? gStudentT[degrees - 1] : gNormalQuantile;
+        statistic.halfWidth = quantile * std::sqrt(variance / samples.size());
+    }
+    return statistic;
+}
+
+unsigned int EnsembleRunner::getStreetCount() const {
+    REQUIRE(properlyInitialized(), "EnsembleRunner wasn't initialized when calling getStreetCount()");
+
+    return fScenario->getStreets().size();
+}
+
+EnsembleStatistic EnsembleRunner::getThroughput(unsigned int street) const {
+    REQUIRE(properlyInitialized(), "EnsembleRunner wasn't initialized when calling getThroughput()");
+    REQUIRE(street < getStreetCount(), "The street is not in the scenario");
+    REQUIRE(!fResults.empty(), "The ensemble wasn't run before calling getThroughput()");
+
+    std::vector<double> samples;
+    for (unsigned int i = 0; i < fResults.size(); i++) {
+        samples.push_back(fResults[i].throughput[street]);
+    }
+    return aggregate(samples);
+}
+
+EnsembleStatistic EnsembleRunner::getQueueLength(unsigned int street) const {
+    REQUIRE(properlyInitialized(), "EnsembleRunner wasn't initialized when calling getQueueLength()");
+    REQUIRE(street < getStreetCount(), "The street is not in the scenario");
+    REQUIRE(!fResults.empty(), "The ensemble wasn't run before calling getQueueLength()");
+
+    std::vector<double> samples;
+    for (unsigned int i = 0; i < fResults.size(); i++) {
+        samples.push_back(fResults[i].queueLength[street]);
+    }
+    return aggregate(samples);
+}
+
+EnsembleStatistic EnsembleRunner::getTravelTime() const {
+    REQUIRE(properlyInitialized(), "EnsembleRunner wasn't initialized when calling getTravelTime()");
+    REQUIRE(!fResults.empty(), "The ensemble wasn't run before calling getTravelTime()");
+
+    std::vector<double> samples;
+    for (unsigned int i = 0; i < fResults.size(); i++) {
+        if (fResults[i].finishedVehicles > 0) {
+            samples.push_back(fResults[i].travelTime);
+        }
+    }
+    return aggregate(samples);
+}
+
+void EnsembleRunner::writeOn(std::ostream &onstream) const {
+    REQUIRE(properlyInitialized(), "EnsembleRunner wasn't initialized when calling writeOn()");
+    REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeOn()");
+    REQUIRE(!fResults.empty(), "The ensemble wasn't run before calling writeOn()");
+
+    onstream << "Replicas: " << fReplicas << std::endl
+             << "Tijd: " << fTicks * gSimulationTime << std::endl << std::endl;
+
+    const std::vector<Street*> &streets = fScenario->getStreets();
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        EnsembleStatistic throughput = getThroughput(i);
+        EnsembleStatistic queueLength = getQueueLength(i);
+        onstream << "Baan " << streets[i]->getName() << std::endl
+                 << "-> doorstroming (voertuigen/uur): " << throughput.mean << " +- " << throughput.halfWidth << std::endl
+                 << "-> wachtrij (voertuigen): " << queueLength.mean << " +- " << queueLength.halfWidth << std::endl
+                 << std::endl;
+    }
+
+    EnsembleStatistic travelTime = getTravelTime();
+    onstream << "Reistijd (s): ";
+    if (travelTime.samples == 0) {
+        onstream << "geen voertuigen hebben het netwerk verlaten" << std::endl;
+    } else {
+        onstream << travelTime.mean << " +- " << travelTime.halfWidth
+                 << " (" << travelTime.samples << " replicas)" << std::endl;
+    }
+
+    ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeOn()");
+}
@@ -0,0 +1,116 @@
+// ===========================================================
+// Name         : EnsembleRunner.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `EnsembleRunner` class which runs independent replicas of a loaded
+//                `TrafficSimulation` on a pool of threads and aggregates their statistics
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_ENSEMBLERUNNER_H
+#define TRAFFICSIMULATION_ENSEMBLERUNNER_H
+
+#include <iostream>
+#include <vector>
+
+class TrafficSimulation;
+
+// Mean over the replicas with the half width of its 95% confidence interval
+struct EnsembleStatistic {
+    double mean;
+    double halfWidth;
+    unsigned int samples;
+};
+
+class EnsembleRunner {
+    struct ReplicaResult {
+        // Vehicles per hour that left every street
+        std::vector<double> throughput;
+        // Average amount of queued vehicles on every street
+        std::vector<double> queueLength;
+        // Average travel time of the vehicles that left the network, only valid if `finishedVehicles` > 0
+        double travelTime;
+        unsigned int finishedVehicles;
+    };
+
+    EnsembleRunner* _initCheck;
+
+    const TrafficSimulation* fScenario;
+    unsigned int fReplicas;
+    unsigned int fThreads;
+    unsigned int fSeed;
+
+    unsigned int fTicks;
+    // Index of the next replica a worker will pick up
+    unsigned int fNextReplica;
+    std::vector<ReplicaResult> fResults;
+
+    static void* workerLoop(void* runner);
+
+    void runReplica(unsigned int replica);
+
+    static EnsembleStatistic aggregate(const std::vector<double> &samples);
+
+public:
+    /*
+     * Replica i is seeded with `seed` + i, so an ensemble is reproducible regardless of the amount of threads.
+     *
+     * REQUIRE(scenario.properlyInitialized(), "The scenario wasn't initialized when constructing an EnsembleRunner")
+     * REQUIRE(replicas > 0, "An ensemble needs at least one replica")
+     * REQUIRE(threads > 0, "An ensemble needs at least one thread")
+     *
+     * ENSURE(properlyInitialized(), "EnsembleRunner constructor did not end in an initialized state")
+     */
+    EnsembleRunner(const TrafficSimulation &scenario, unsigned int replicas, unsigned int threads, unsigned int seed);
+
+    virtual ~EnsembleRunner();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Simulates every replica for the given amount of ticks, the scenario itself is not changed.
+     *
+     * REQUIRE(properlyInitialized(), "EnsembleRunner wasn't initialized when calling run()")
+     *
+     * ENSURE(fResults.size() == fReplicas, "run() postcondition")
+     */
+    void run(unsigned int ticks);
+
+    /*
+     * REQUIRE(properlyInitialized(), "EnsembleRunner wasn't initialized when calling getStreetCount()")
+     */
+    unsigned int getStreetCount() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "EnsembleRunner wasn't initialized when calling getThroughput()")
+     * REQUIRE(street < getStreetCount(), "The street is not in the scenario")
+     * REQUIRE(!fResults.empty(), "The ensemble wasn't run before calling getThroughput()")
+     */
+    EnsembleStatistic getThroughput(unsigned int street) const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "EnsembleRunner wasn't initialized when calling getQueueLength()")
+     * REQUIRE(street < getStreetCount(), "The street is not in the scenario")
+     * REQUIRE(!fResults.empty(), "The ensemble wasn't run before calling getQueueLength()")
+     */
+    EnsembleStatistic getQueueLength(unsigned int street) const;
+
+    /*
+     * Only the replicas in which a vehicle left the network are counted.
+     *
+     * REQUIRE(properlyInitialized(), "EnsembleRunner wasn't initialized when calling getTravelTime()")
+     * REQUIRE(!fResults.empty(), "The ensemble wasn't run before calling getTravelTime()")
+     */
+    EnsembleStatistic getTravelTime() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "EnsembleRunner wasn't initialized when calling writeOn()")
+     * REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeOn()")
+     * REQUIRE(!fResults.empty(), "The ensemble wasn't run before calling writeOn()")
+     *
+     * ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeOn()")
+     */
+    void writeOn(std::ostream &onstream = std::cout) const;
+};
+
+
+#endif
@@ -0,0 +1,405 @@
+// ===========================================================
+// Name         : PartitionedRunner.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `PartitionedRunner` class which splits a loaded `TrafficSimulation` into
+//                partitions that are simulated by separate worker processes and gathers their state every tick
+// ===========================================================
+
+#include <map>
+#include <algorithm>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "PartitionedRunner.h"
+#include "../DesignByContract.h"
+#include "../TrafficSimulation.h"
+#include "../objects/Street.h"
+#include "../objects/Vehicle.h"
+
+namespace {
+    // Start of a mailbox, followed by arrays of `capacity` f64 positions, f64 speeds, u32 streets, u32 types and u32
+    // lanes
+    struct PartitionMailbox {
+        double time;
+        unsigned int tick;
+        // Vehicles of the partition, only the first `capacity` of them are in the mailbox
+        unsigned int vehicles;
+    };
+
+    size_t align(size_t offset) {
+        return (offset + 63) & ~(size_t) 63;
+    }
+
+    VehicleBuffers mailboxBuffers(char* mailbox, unsigned int capacity) {
+        char* arrays = mailbox + sizeof(PartitionMailbox);
+        VehicleBuffers buffers = {(double*) arrays, (double*) (arrays + 8 * (size_t) capacity),
+                                  (unsigned int*) (arrays + 16 * (size_t) capacity), (unsigned int*) (arrays + 20 * (size_t) capacity),
+                                  (unsigned int*) (arrays + 24 * (size_t) capacity), capacity};
+        return buffers;
+    }
+
+    // Sends or receives the single byte that hands a tick over between a worker and the coordinator, false if the other
+    // side is gone
+    bool sendByte(int socket) {
+        char byte = 1;
+        ssize_t sent;
+        do {
+            sent = send(socket, &byte, 1, MSG_NOSIGNAL);
+        } while (sent < 0 && errno == EINTR);
+        return sent == 1;
+    }
+
+    bool receiveByte(int socket) {
+        char byte;
+        ssize_t received;
+        do {
+            received = recv(socket, &byte, 1, 0);
+        } while (received < 0 && errno == EINTR);
+        return received == 1;
+    }
+
+    unsigned int findRoot(std::vector<unsigned int> &parents, unsigned int street) {
+        while (parents[street] != street) {
+            parents[street] = parents[parents[street]];
+            street = parents[street];
+        }
+        return street;
+    }
+
+    void join(std::vector<unsigned int> &parents, unsigned int street1, unsigned int street2) {
+        unsigned int root1 = findRoot(parents, street1);
+        unsigned int root2 = findRoot(parents, street2);
+        // The lowest street stays the root, so the components come in the order of their first street
+        parents[std::max(root1, root2)] = std::min(root1, root2);
+    }
+
+    // Heaviest component first, the one with the lowest first street if they are equally heavy
+    bool heavierFirst(const std::pair<unsigned int, unsigned int> &component1, const std::pair<unsigned int, unsigned int> &component2) {
+        if (component1.first != component2.first) {
+            return component1.first > component2.first;
+        }
+        return component1.second < component2.second;
+    }
+}
+
+PartitionedRunner::PartitionedRunner(TrafficSimulation &simulation, unsigned int workers, unsigned int capacity) :
+            fSimulation(&simulation), fCapacity(capacity), fShared(NULL), fSharedSize(0), fTime(simulation.getTime()),
+            fTick(simulation.getTick()), fVehicleCount(0) {
+    REQUIRE(simulation.properlyInitialized(), "The simulation wasn't initialized when constructing a PartitionedRunner");
+    REQUIRE(workers > 0, "A PartitionedRunner needs at least one worker");
+    REQUIRE(capacity > 0, "A mailbox needs room for at least one vehicle");
+
+    PartitionedRunner::_initCheck = this;
+
+    const std::vector<Street*> &streets = simulation.getStreets();
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        fStreetNames.push_back(streets[i]->getName());
+    }
+    partition(workers);
+
+    // Until the first run the state is the one of the simulation itself
+    VehicleBuffers count = {NULL, NULL, NULL, NULL, NULL, 0};
+    fVehicleCount = simulation.queryVehicles(NULL, 0, count);
+    fPositions.resize(fVehicleCount);
+    fSpeeds.resize(fVehicleCount);
+    fStreets.resize(fVehicleCount);
+    fTypes.resize(fVehicleCount);
+    fLanes.resize(fVehicleCount);
+    if (fVehicleCount > 0) {
+        VehicleBuffers buffers = {&fPositions[0], &fSpeeds[0], &fStreets[0], &fTypes[0], &fLanes[0], fVehicleCount};
+        simulation.queryVehicles(NULL, 0, buffers);
+    }
+
+    ENSURE(properlyInitialized(), "PartitionedRunner constructor did not end in an initialized state");
+    ENSURE(getPartitions().size() <= workers, "PartitionedRunner constructor postcondition");
+}
+
+PartitionedRunner::~PartitionedRunner() {}
+
+bool PartitionedRunner::properlyInitialized() const {
+    return PartitionedRunner::_initCheck == this;
+}
+
+void PartitionedRunner::partition(unsigned int workers) {
+    const std::vector<Street*> &streets = fSimulation->getStreets();
+    std::map<const Street*, unsigned int> indices;
+    std::vector<unsigned int> parents(streets.size());
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        indices[streets[i]] = i;
+        parents[i] = i;
+    }
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        const std::map<Street*,int> &crossroads = streets[i]->getCrossroads();
+        for (std::map<Street*,int>::const_iterator it = crossroads.begin(); it != crossroads.end(); it++) {
+            join(parents, i, indices[it->first]);
+            // simCrossroads() stops at a crossroad at the end of a street, the streets after it depend on this one
+            if (it->second == streets[i]->getLength()) {
+                for (unsigned int j = i + 1; j < streets.size(); j++) {
+                    join(parents, i, j);
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<unsigned int> > components;
+    std::vector<int> componentOf(streets.size(), -1);
+    std::vector<std::pair<unsigned int, unsigned int> > loads;
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        unsigned int root = findRoot(parents, i);
+        if (componentOf[root] < 0) {
+            componentOf[root] = components.size();
+            components.push_back(std::vector<unsigned int>());
+            loads.push_back(std::make_pair(0u, (unsigned int) loads.size()));
+        }
+        components[componentOf[root]].push_back(i);
+        loads[componentOf[root]].first += 1 + streets[i]->getVehicles().size() + streets[i]->getEntryQueue().size();
+    }
+
+    // The heaviest components go first, each to the worker with the least work so far
+    std::sort(loads.begin(), loads.end(), heavierFirst);
+    unsigned int partitions = std::max(1u, std::min(workers, (unsigned int) components.size()));
+    fPartitions.assign(partitions, std::vector<unsigned int>());
+    std::vector<unsigned int> work(partitions, 0);
+    for (unsigned int i = 0; i < loads.size(); i++) {
+        unsigned int worker = std::min_element(work.begin(), work.end()) - work.begin();
+        const std::vector<unsigned int> &component = components[loads[i].second];
+        fPartitions[worker].insert(fPartitions[worker].end(), component.begin(), component.end());
+        work[worker] += loads[i].first;
+    }
+    for (unsigned int i = 0; i < partitions; i++) {
+        std::sort(fPartitions[i].begin(), fPartitions[i].end());
+    }
+}
+
+size_t PartitionedRunner::getMailboxSize() const {
+    return align(sizeof(PartitionMailbox) + 28 * (size_t) fCapacity);
+}
+
+char *PartitionedRunner::getMailbox(unsigned int worker) const {
+    return fShared + worker * getMailboxSize();
+}
+
+void PartitionedRunner::runWorker(unsigned int worker, unsigned int ticks, int socket) {
+    // This is a copy of the coordinator, the simulation of the coordinator stays whole
+    TrafficSimulation &sim = *fSimulation;
+    sim.setLogStream(NULL);
+    sim.keepStreets(fPartitions[worker]);
+
+    const std::vector<unsigned int> &streets = fPartitions[worker];
+    char* mailbox = getMailbox(worker);
+    PartitionMailbox* header = (PartitionMailbox*) mailbox;
+    VehicleBuffers buffers = mailboxBuffers(mailbox, fCapacity);
+    for (unsigned int tick = 0; tick < ticks; tick++) {
+        sim.simulate();
+        header->time = sim.getTime();
+        header->tick = sim.getTick();
+        header->vehicles = sim.queryVehicles(NULL, 0, buffers);
+        unsigned int written = std::min(header->vehicles, fCapacity);
+        for (unsigned int i = 0; i < written; i++) {
+            buffers.streets[i] = streets[buffers.streets[i]];
+        }
+        // Published, then wait until the coordinator gathered every mailbox
+        if (!sendByte(socket) || !receiveByte(socket)) {
+            return;
+        }
+    }
+}
+
+void PartitionedRunner::gather() {
+    unsigned int streetCount = fStreetNames.size();
+    // The vehicles of every street come from a single mailbox, in their order, so counting them per street gives the
+    // place of every vehicle
+    std::vector<unsigned int> next(streetCount + 1, 0);
+    fVehicleCount = 0;
+    for (unsigned int w = 0; w < fPartitions.size(); w++) {
+        PartitionMailbox* header = (PartitionMailbox*) getMailbox(w);
+        VehicleBuffers buffers = mailboxBuffers(getMailbox(w), fCapacity);
+        fVehicleCount += header->vehicles;
+        for (unsigned int i = 0; i < header->vehicles; i++) {
+            next[buffers.streets[i] + 1]++;
+        }
+    }
+    for (unsigned int i = 0; i < streetCount; i++) {
+        next[i + 1] += next[i];
+    }
+
+    fPositions.resize(fVehicleCount);
+    fSpeeds.resize(fVehicleCount);
+    fStreets.resize(fVehicleCount);
+    fTypes.resize(fVehicleCount);
+    fLanes.resize(fVehicleCount);
+    for (unsigned int w = 0; w < fPartitions.size(); w++) {
+        PartitionMailbox* header = (PartitionMailbox*) getMailbox(w);
+        VehicleBuffers buffers = mailboxBuffers(getMailbox(w), fCapacity);
+        for (unsigned int i = 0; i < header->vehicles; i++) {
+            unsigned int index = next[buffers.streets[i]]++;
+            fPositions[index] = buffers.positions[i];
+            fSpeeds[index] = buffers.speeds[i];
+            fStreets[index] = buffers.streets[i];
+            fTypes[index] = buffers.types[i];
+            fLanes[index] = buffers.lanes[i];
+        }
+    }
+    PartitionMailbox* first = (PartitionMailbox*) getMailbox(0);
+    fTime = first->time;
+    fTick = first->tick;
+}
+
+const std::vector<std::vector<unsigned int> > &PartitionedRunner::getPartitions() const {
+    REQUIRE(properlyInitialized(), "PartitionedRunner wasn't initialized when calling getPartitions()");
+
+    return fPartitions;
+}
+
+bool PartitionedRunner::run(unsigned int ticks, std::ostream &errStream) {
+    REQUIRE(properlyInitialized(), "PartitionedRunner wasn't initialized when calling run()");
+    REQUIRE(errStream.good(), "The errorStream wasn't good when calling run()");
+
+    unsigned int workers = fPartitions.size();
+    fSharedSize = workers * getMailboxSize();
+    void* memory = mmap(NULL, fSharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        errStream << "The memory for the mailboxes could not be shared with the workers." << std::endl;
+        return false;
+    }
+    fShared = (char*) memory;
+
+    // Otherwise the workers would write what is still buffered once more
+    std::cout.flush();
+    std::cerr.flush();
+    errStream.flush();
+    fWorkers.clear();
+    fSockets.clear();
+    for (unsigned int w = 0; w < workers; w++) {
+        int sockets[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+            break;
+        }
+        pid_t worker = fork();
+        if (worker == 0) {
+            // Only the coordinator may hold the other ends, so a worker notices when the coordinator is gone
+            for (unsigned int i = 0; i < fSockets.size(); i++) {
+                close(fSockets[i]);
+            }
+            close(sockets[0]);
+            runWorker(w, ticks, sockets[1]);
+            _exit(0);
+        }
+        close(sockets[1]);
+        if (worker < 0) {
+            close(sockets[0]);
+            break;
+        }
+        fWorkers.push_back(worker);
+        fSockets.push_back(sockets[0]);
+    }
+
+    bool success = fWorkers.size() == workers;
+    if (!success) {
+        errStream << "Only " << fWorkers.size() << " of the " << workers << " workers could be started." << std::endl;
+    }
+    for (unsigned int tick = 0; success && tick < ticks; tick++) {
+        // A worker that stops closes its socket, which wakes the coordinator instead of leaving it waiting
+        for (unsigned int w = 0; success && w < workers; w++) {
+            if (!receiveByte(fSockets[w])) {
+                errStream << "Worker " << w << " stopped during tick " << tick + 1 << "." << std::endl;
+                success = false;
+            }
+        }
+        for (unsigned int w = 0; success && w < workers; w++) {
+            unsigned int vehicles = ((PartitionMailbox*) getMailbox(w))->vehicles;
+            if (vehicles > fCapacity) {
+                errStream << "The mailbox of worker " << w << " has room for " << fCapacity << " vehicles, its partition had "
+                          << vehicles << " vehicles after tick " << tick + 1 << "." << std::endl;
+                success = false;
+            }
+        }
+        if (!success) {
+            break;
+        }
+        gather();
+        for (unsigned int w = 0; success && w < workers; w++) {
+            if (!sendByte(fSockets[w])) {
+                errStream << "Worker " << w << " stopped after tick " << tick + 1 << "." << std::endl;
+                success = false;
+            }
+        }
+    }
+    if (!success) {
+        // The other workers would wait for the coordinator forever
+        for (unsigned int w = 0; w < fWorkers.size(); w++) {
+            kill(fWorkers[w], SIGKILL);
+        }
+    }
+    for (unsigned int w = 0; w < fWorkers.size(); w++) {
+        close(fSockets[w]);
+        int status = 0;
+        waitpid(fWorkers[w], &status, 0);
+        if (success && !(WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+            errStream << "Worker " << w << " did not end normally." << std::endl;
+            success = false;
+        }
+    }
+    fWorkers.clear();
+    fSockets.clear();
+
+    munmap(fShared, fSharedSize);
+    fShared = NULL;
+    fSharedSize = 0;
+    return success;
+}
+
+double PartitionedRunner::getTime() const {
+    REQUIRE(properlyInitialized(), "PartitionedRunner wasn't initialized when calling getTime()");
+
+    return fTime;
+}
+
+unsigned int PartitionedRunner::getTick() const {
+    REQUIRE(properlyInitialized(), "PartitionedRunner wasn't initialized when calling getTick()");
+
+    return fTick;
+}
+
+unsigned int PartitionedRunner::queryVehicles(VehicleBuffers &buffers) const {
+    REQUIRE(properlyInitialized(), "PartitionedRunner wasn't initialized when calling queryVehicles()");
+
+    unsigned int written = std::min((unsigned int) fPositions.size(), buffers.capacity);
+    for (unsigned int i = 0; i < written; i++) {
+        if (buffers.positions != NULL) {
+            buffers.positions[i] = fPositions[i];
+        }
+        if (buffers.speeds != NULL) {
+            buffers.speeds[i] = fSpeeds[i];
+        }
+        if (buffers.streets != NULL) {
+            buffers.streets[i] = fStreets[i];
+        }
+        if (buffers.types != NULL) {
+            buffers.types[i] = fTypes[i];
+        }
+        if (buffers.lanes != NULL) {
+            buffers.lanes[i] = fLanes[i];
+        }
+    }
+    return fVehicleCount;
+}
+
+void PartitionedRunner::writeOn(std::ostream &onstream) const {
+    REQUIRE(properlyInitialized(), "PartitionedRunner wasn't initialized when calling writeOn()");
+    REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeOn()");
+
+    onstream << "Tijd: " << fTime << std::endl;
+    for (unsigned int i = 0; i < fPositions.size(); i++) {
+        onstream << "Voertuig " << i + 1 << std::endl;
+        onstream << "-> baan: " << fStreetNames[fStreets[i]] << std::endl;
+        onstream << "-> positie: " << fPositions[i] << std::endl;
+        onstream << "-> snelheid: " << fSpeeds[i] << std::endl << std::endl;
+    }
+
+    ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeOn()");
+}
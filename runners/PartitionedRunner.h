@@ -0,0 +1,136 @@
+// ===========================================================
+// Name         : PartitionedRunner.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `PartitionedRunner` class which splits a loaded `TrafficSimulation` into
+//                partitions that are simulated by separate worker processes and gathers their state every tick
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_PARTITIONEDRUNNER_H
+#define TRAFFICSIMULATION_PARTITIONEDRUNNER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include <sys/types.h>
+
+class TrafficSimulation;
+struct VehicleBuffers;
+
+/*
+ * Vehicles only move to another street at a crossroad, and every tick checks the crossroads of all streets before each
+ * street drives, so a partition boundary through a crossroad would change when vehicles turn. The partitions are
+ * therefore the parts of the network that are connected by crossroads, spread over the workers by their amount of
+ * streets and vehicles. Every worker process keeps only its streets (TrafficSimulation::keepStreets()), which gives
+ * exactly the result of the whole simulation. A street with a crossroad at its end stops the crossroad checks of the
+ * streets after it, so those streets are kept in its partition.
+ *
+ * At the end of every tick each worker writes its vehicles into its mailbox in memory it shares with the
+ * coordinator, tells the coordinator over its own socket and waits until the coordinator has gathered all mailboxes.
+ * A worker that stops closes its socket, so the coordinator never waits for a worker that is gone.
+ */
+class PartitionedRunner {
+    PartitionedRunner* _initCheck;
+
+    TrafficSimulation* fSimulation;
+    std::vector<std::vector<unsigned int> > fPartitions;
+    unsigned int fCapacity;
+    std::vector<std::string> fStreetNames;
+
+    // Shared with the workers while run() runs: a mailbox per worker
+    char* fShared;
+    size_t fSharedSize;
+    std::vector<pid_t> fWorkers;
+    // The end of the socket of every worker that the coordinator holds
+    std::vector<int> fSockets;
+
+    // State of the whole network after the last tick, street by street and on every street from front to back
+    double fTime;
+    unsigned int fTick;
+    unsigned int fVehicleCount;
+    std::vector<double> fPositions;
+    std::vector<double> fSpeeds;
+    std::vector<unsigned int> fStreets;
+    std::vector<unsigned int> fTypes;
+    std::vector<unsigned int> fLanes;
+
+    void partition(unsigned int workers);
+
+    size_t getMailboxSize() const;
+
+    char* getMailbox(unsigned int worker) const;
+
+    void runWorker(unsigned int worker, unsigned int ticks, int socket);
+
+    void gather();
+
+public:
+    /*
+     * Splits `simulation` over at most `workers` partitions, fewer if the network has fewer connected parts. Every
+     * mailbox has room for `capacity` vehicles, a run fails once a partition has more. The simulation itself isn't
+     * changed by run().
+     *
+     * REQUIRE(simulation.properlyInitialized(), "The simulation wasn't initialized when constructing a PartitionedRunner")
+     * REQUIRE(workers > 0, "A PartitionedRunner needs at least one worker")
+     * REQUIRE(capacity > 0, "A mailbox needs room for at least one vehicle")
+     *
+     * ENSURE(properlyInitialized(), "PartitionedRunner constructor did not end in an initialized state")
+     * ENSURE(getPartitions().size() <= workers, "PartitionedRunner constructor postcondition")
+     */
+    PartitionedRunner(TrafficSimulation &simulation, unsigned int workers, unsigned int capacity);
+
+    virtual ~PartitionedRunner();
+
+    bool properlyInitialized() const;
+
+    /*
+     * The streets of every worker, as ascending indices in TrafficSimulation::getStreets().
+     *
+     * REQUIRE(properlyInitialized(), "PartitionedRunner wasn't initialized when calling getPartitions()")
+     */
+    const std::vector<std::vector<unsigned int> > &getPartitions() const;
+
+    /*
+     * Simulates `ticks` steps, every partition in its own process, and gathers the state of the whole network after
+     * every step. Every run starts from the simulation as it was given, which the workers don't change. Returns false
+     * and writes why on `errStream` if the shared memory or a worker couldn't be created, a worker stopped or a
+     * partition had more vehicles than its mailbox has room for; the other workers are stopped then and the state is
+     * the one after the last tick that was gathered completely.
+     *
+     * REQUIRE(properlyInitialized(), "PartitionedRunner wasn't initialized when calling run()")
+     * REQUIRE(errStream.good(), "The errorStream wasn't good when calling run()")
+     */
+    bool run(unsigned int ticks, std::ostream &errStream = std::cerr);
+
+    /*
+     * REQUIRE(properlyInitialized(), "PartitionedRunner wasn't initialized when calling getTime()")
+     */
+    double getTime() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "PartitionedRunner wasn't initialized when calling getTick()")
+     */
+    unsigned int getTick() const;
+
+    /*
+     * Writes the gathered vehicles like TrafficSimulation::queryVehicles() does for all streets and returns their
+     * amount.
+     *
+     * REQUIRE(properlyInitialized(), "PartitionedRunner wasn't initialized when calling queryVehicles()")
+     */
+    unsigned int queryVehicles(VehicleBuffers &buffers) const;
+
+    /*
+     * Writes the gathered vehicles like TrafficSimulation::writeOn().
+     *
+     * REQUIRE(properlyInitialized(), "PartitionedRunner wasn't initialized when calling writeOn()")
+     * REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeOn()")
+     *
+     * ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeOn()")
+     */
+    void writeOn(std::ostream &onstream = std::cout) const;
+};
+
+
+#endif
@@ -0,0 +1,394 @@
+// ===========================================================
+// Name         : SimulationServer.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `SimulationServer` class which keeps a simulation loaded and executes the
+//                commands of clients on a Unix domain or localhost TCP socket
+// ===========================================================
+
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "SimulationServer.h"
+#include "../DesignByContract.h"
+#include "../Variables.h"
+#include "../TrafficSimulation.h"
+#include "../objects/Street.h"
+#include "../objects/Vehicle.h"
+#include "../objects/VehicleType.h"
+#include "../objects/TrafficLight.h"
+
+namespace {
+    // Larger requests are refused, no command needs more than a few bytes
+    const uint32_t gMaxRequestSize = 1 << 16;
+
+    void appendUnsigned(std::string &buffer, uint32_t value) {
+        for (unsigned int i = 0; i < 4; i++) {
+            buffer += (char) ((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    void appendDouble(std::string &buffer, double value) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        for (unsigned int i = 0; i < 8; i++) {
+            buffer += (char) ((bits >> (8 * i)) & 0xFF);
+        }
+    }
+
+    uint32_t readUnsigned(const std::string &buffer, unsigned int offset) {
+        uint32_t value = 0;
+        for (unsigned int i = 0; i < 4; i++) {
+            value |= (uint32_t) (unsigned char) buffer[offset + i] << (8 * i);
+        }
+        return value;
+    }
+
+    double readDouble(const std::string &buffer, unsigned int offset) {
+        uint64_t bits = 0;
+        for (unsigned int i = 0; i < 8; i++) {
+            bits |= (uint64_t) (unsigned char) buffer[offset + i] << (8 * i);
+        }
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // Reads exactly `size` bytes, false if the connection was closed or failed first
+    bool readFully(int connection, char* data, size_t size) {
+        while (size > 0) {
+            ssize_t received = recv(connection, data, size, 0);
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received <= 0) {
+                return false;
+            }
+            data += received;
+            size -= received;
+        }
+        return true;
+    }
+
+    bool writeFully(int connection, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t sent = send(connection, data, size, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            if (sent <= 0) {
+                return false;
+            }
+            data += sent;
+            size -= sent;
+        }
+        return true;
+    }
+}
+
+SimulationServer::SimulationServer(TrafficSimulation &simulation) : fSimulation(&simulation), fSnapshot(NULL),
+            fListenSocket(-1), fStopped(false) {
+    REQUIRE(simulation.properlyInitialized(), "The simulation wasn't initialized when constructing a SimulationServer");
+
+    SimulationServer::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "SimulationServer constructor did not end in an initialized state");
+}
+
+SimulationServer::~SimulationServer() {
+    if (fListenSocket >= 0) {
+        close(fListenSocket);
+    }
+    if (!fSocketPath.empty()) {
+        unlink(fSocketPath.c_str());
+    }
+    delete fSnapshot;
+}
+
+bool SimulationServer::properlyInitialized() const {
+    return SimulationServer::_initCheck == this;
+}
+
+bool SimulationServer::listenUnix(const std::string &path) {
+    REQUIRE(properlyInitialized(), "SimulationServer wasn't initialized when calling listenUnix()");
+    REQUIRE(!isListening(), "The server is already listening");
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path.c_str());
+
+    int listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        return false;
+    }
+    unlink(path.c_str());
+    if (bind(listenSocket, (sockaddr*) &address, sizeof(address)) != 0 || listen(listenSocket, 8) != 0) {
+        close(listenSocket);
+        return false;
+    }
+    fListenSocket = listenSocket;
+    fSocketPath = path;
+    return true;
+}
+
+bool SimulationServer::listenTcp(unsigned short port) {
+    REQUIRE(properlyInitialized(), "SimulationServer wasn't initialized when calling listenTcp()");
+    REQUIRE(!isListening(), "The server is already listening");
+
+    int listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listenSocket, (sockaddr*) &address, sizeof(address)) != 0 || listen(listenSocket, 8) != 0) {
+        close(listenSocket);
+        return false;
+    }
+    fListenSocket = listenSocket;
+    return true;
+}
+
+bool SimulationServer::isListening() const {
+    REQUIRE(properlyInitialized(), "SimulationServer wasn't initialized when calling isListening()");
+
+    return fListenSocket >= 0;
+}
+
+void SimulationServer::run() {
+    REQUIRE(properlyInitialized(), "SimulationServer wasn't initialized when calling run()");
+    REQUIRE(isListening(), "The server isn't listening");
+
+    while (!fStopped) {
+        int connection = accept(fListenSocket, NULL, NULL);
+        if (connection < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        // Replies are small and a client waits for every one of them, so they may not wait for more data
+        int noDelay = 1;
+        setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        serve(connection);
+        close(connection);
+    }
+    fStopped = true;
+
+    ENSURE(isStopped(), "run() postcondition");
+}
+
+void SimulationServer::serve(int connection) {
+    REQUIRE(properlyInitialized(), "SimulationServer wasn't initialized when calling serve()");
+
+    char header[5];
+    while (readFully(connection, header, sizeof(header))) {
+        unsigned char command = (unsigned char) header[0];
+        std::string length(header + 1, 4);
+        uint32_t size = readUnsigned(length, 0);
+        if (size > gMaxRequestSize) {
+            return;
+        }
+        fRequest.resize(size);
+        if (size > 0 && !readFully(connection, &fRequest[0], size)) {
+            return;
+        }
+
+        fReply.assign(5, '\0');
+        EServerStatus status = execute(command);
+        fReply[0] = (char) status;
+        uint32_t replySize = fReply.size() - 5;
+        for (unsigned int i = 0; i < 4; i++) {
+            fReply[1 + i] = (char) ((replySize >> (8 * i)) & 0xFF);
+        }
+        if (!writeFully(connection, fReply.data(), fReply.size())) {
+            return;
+        }
+        if (status == StatusOk && (command == CommandClose || command == CommandShutdown)) {
+            return;
+        }
+    }
+}
+
+bool SimulationServer::isStopped() const {
+    REQUIRE(properlyInitialized(), "SimulationServer wasn't initialized when calling isStopped()");
+
+    return fStopped;
+}
+
+unsigned int SimulationServer::queryVehicles() {
+    const unsigned int* streets = fQueryStreets.empty() ? NULL : &fQueryStreets[0];
+    VehicleBuffers buffers = {NULL, NULL, NULL, NULL, NULL, 0};
+    unsigned int vehicles = fSimulation->queryVehicles(streets, fQueryStreets.size(), buffers);
+    if (vehicles > 0) {
+        fPositions.resize(vehicles);
+        fSpeeds.resize(vehicles);
+        fStreetIndices.resize(vehicles);
+        fTypes.resize(vehicles);
+        fLanes.resize(vehicles);
+        VehicleBuffers filled = {&fPositions[0], &fSpeeds[0], &fStreetIndices[0], &fTypes[0], &fLanes[0], vehicles};
+        fSimulation->queryVehicles(streets, fQueryStreets.size(), filled);
+    }
+    return vehicles;
+}
+
+EServerStatus SimulationServer::execute(unsigned char command) {
+    const std::vector<Street*> &streets = fSimulation->getStreets();
+    switch (command) {
+        case CommandStep: {
+            if (fRequest.size() != 4) {
+                return StatusBadRequest;
+            }
+            uint32_t ticks = readUnsigned(fRequest, 0);
+            for (uint32_t i = 0; i < ticks; i++) {
+                fSimulation->simulate();
+            }
+            appendDouble(fReply, fSimulation->getTime());
+            return StatusOk;
+        }
+        case CommandRunUntil: {
+            if (fRequest.size() != 8) {
+                return StatusBadRequest;
+            }
+            double time = readDouble(fRequest, 0);
+            // Never further than a single CommandStep goes, a time that isn't finite would never be reached
+            if (!(time - fSimulation->getTime() <= 4294967295.0 * gSimulationTime)) {
+                return StatusBadRequest;
+            }
+            while (fSimulation->getTime() < time) {
+                fSimulation->simulate();
+            }
+            appendDouble(fReply, fSimulation->getTime());
+            return StatusOk;
+        }
+        case CommandTime: {
+            appendDouble(fReply, fSimulation->getTime());
+            appendUnsigned(fReply, fSimulation->getTick());
+            return StatusOk;
+        }
+        case CommandStreets: {
+            appendUnsigned(fReply, streets.size());
+            for (unsigned int i = 0; i < streets.size(); i++) {
+                const std::string &name = streets[i]->getName();
+                appendUnsigned(fReply, name.size());
+                fReply += name;
+                appendUnsigned(fReply, streets[i]->getLength());
+                appendUnsigned(fReply, streets[i]->getLanes());
+                appendUnsigned(fReply, streets[i]->getVehicles().size());
+                appendUnsigned(fReply, streets[i]->getTrafficLights().size());
+                appendUnsigned(fReply, streets[i]->getEntryQueue().size());
+            }
+            return StatusOk;
+        }
+        case CommandVehicles: {
+            if (fRequest.size() != 4 || readUnsigned(fRequest, 0) >= streets.size()) {
+                return StatusBadRequest;
+            }
+            fQueryStreets.assign(1, readUnsigned(fRequest, 0));
+            unsigned int vehicles = queryVehicles();
+            appendUnsigned(fReply, vehicles);
+            for (unsigned int i = 0; i < vehicles; i++) {
+                appendDouble(fReply, fPositions[i]);
+                appendDouble(fReply, fSpeeds[i]);
+                appendUnsigned(fReply, fTypes[i]);
+                appendUnsigned(fReply, fLanes[i]);
+            }
+            return StatusOk;
+        }
+        case CommandQueryVehicles: {
+            if (fRequest.size() < 4 || fRequest.size() != 4 + 4 * (size_t) readUnsigned(fRequest, 0)) {
+                return StatusBadRequest;
+            }
+            fQueryStreets.resize(readUnsigned(fRequest, 0));
+            for (unsigned int i = 0; i < fQueryStreets.size(); i++) {
+                fQueryStreets[i] = readUnsigned(fRequest, 4 + 4 * i);
+                if (fQueryStreets[i] >= streets.size()) {
+                    return StatusBadRequest;
+                }
+            }
+            unsigned int vehicles = queryVehicles();
+            appendUnsigned(fReply, vehicles);
+            for (unsigned int i = 0; i < vehicles; i++) {
+                appendDouble(fReply, fPositions[i]);
+            }
+            for (unsigned int i = 0; i < vehicles; i++) {
+                appendDouble(fReply, fSpeeds[i]);
+            }
+            const std::vector<unsigned int>* columns[] = {&fStreetIndices, &fTypes, &fLanes};
+            for (unsigned int j = 0; j < 3; j++) {
+                for (unsigned int i = 0; i < vehicles; i++) {
+                    appendUnsigned(fReply, (*columns[j])[i]);
+                }
+            }
+            return StatusOk;
+        }
+        case CommandInject: {
+            if (fRequest.size() != 20 || readUnsigned(fRequest, 0) >= streets.size()) {
+                return StatusBadRequest;
+            }
+            Street* street = streets[readUnsigned(fRequest, 0)];
+            double position = readDouble(fRequest, 4);
+            uint32_t type = readUnsigned(fRequest, 12);
+            uint32_t lane = readUnsigned(fRequest, 16);
+            if (!(position >= 0 && position <= street->getLength()) || type >= fSimulation->getVehicleTypes().size()
+                    || lane >= street->getLanes()) {
+                return StatusBadRequest;
+            }
+            Vehicle* vehicle = new Vehicle(street->getId(), position, type, fSimulation->getVehicleTypes());
+            vehicle->setLane(lane);
+            street->injectVehicle(vehicle, fSimulation->getTime());
+            appendUnsigned(fReply, street->getVehicles().size());
+            return StatusOk;
+        }
+        case CommandSetCycle: {
+            if (fRequest.size() != 12 || readUnsigned(fRequest, 0) >= streets.size()) {
+                return StatusBadRequest;
+            }
+            const std::vector<TrafficLight*> &lights = streets[readUnsigned(fRequest, 0)]->getTrafficLights();
+            uint32_t light = readUnsigned(fRequest, 4);
+            uint32_t cycle = readUnsigned(fRequest, 8);
+            if (light >= lights.size() || cycle == 0 || cycle > (uint32_t) 0x7FFFFFFF) {
+                return StatusBadRequest;
+            }
+            lights[light]->setCycle(cycle);
+            return StatusOk;
+        }
+        case CommandSnapshot: {
+            delete fSnapshot;
+            fSnapshot = new TrafficSimulation();
+            fSnapshot->copySimulation(*fSimulation);
+            return StatusOk;
+        }
+        case CommandRestore: {
+            if (fSnapshot == NULL) {
+                return StatusBadRequest;
+            }
+            fSimulation->clearSimulation();
+            fSimulation->copySimulation(*fSnapshot);
+            appendDouble(fReply, fSimulation->getTime());
+            return StatusOk;
+        }
+        case CommandClose:
+            return StatusOk;
+        case CommandShutdown:
+            fStopped = true;
+            return StatusOk;
+        default:
+            return StatusUnknownCommand;
+    }
+}
@@ -0,0 +1,155 @@
+// ===========================================================
+// Name         : SimulationServer.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `SimulationServer` class which keeps a simulation loaded and executes the
+//                commands of clients on a Unix domain or localhost TCP socket
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_SIMULATIONSERVER_H
+#define TRAFFICSIMULATION_SIMULATIONSERVER_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+class TrafficSimulation;
+
+/*
+ * Every request is a command byte, the length of its payload as a 32-bit unsigned integer and the payload; every reply
+ * is a status byte, the length of its payload and the payload. All numbers are little-endian, doubles are 64-bit IEEE
+ * 754 and a string is its length followed by its bytes. Streets, traffic lights and types are numbered in the order of
+ * TrafficSimulation::getStreets(), Street::getTrafficLights() and TrafficSimulation::getVehicleTypes().
+ */
+enum EServerCommand {
+    // u32 ticks -> f64 time
+    CommandStep = 1,
+    // f64 time -> f64 time, steps while the time is smaller than the given time; a time that isn't finite or further
+    // away than 2^32 - 1 ticks is a bad request
+    CommandRunUntil = 2,
+    // -> f64 time, u32 tick
+    CommandTime = 3,
+    // -> u32 streets, then per street: string name, u32 length, u32 lanes, u32 vehicles, u32 traffic lights,
+    //    u32 waiting in the entry queue
+    CommandStreets = 4,
+    // u32 street -> u32 vehicles, then per vehicle from front to back: f64 position, f64 speed, u32 type, u32 lane
+    CommandVehicles = 5,
+    // u32 street, f64 position, u32 type, u32 lane -> u32 vehicles on the street
+    CommandInject = 6,
+    // u32 street, u32 traffic light, u32 cycle (in s) ->
+    CommandSetCycle = 7,
+    // -> , keeps a copy of the current state
+    CommandSnapshot = 8,
+    // -> f64 time, goes back to the copy of the last snapshot
+    CommandRestore = 9,
+    // -> , ends the connection
+    CommandClose = 10,
+    // -> , ends the connection and stops the server
+    CommandShutdown = 11,
+    // u32 count, count x u32 street -> u32 vehicles, then f64 positions, f64 speeds, u32 streets, u32 types and u32 lanes
+    //    as arrays of that length, of all streets if the count is 0; see TrafficSimulation::queryVehicles()
+    CommandQueryVehicles = 12
+};
+
+enum EServerStatus {
+    StatusOk = 0,
+    StatusUnknownCommand = 1,
+    // The payload has the wrong size or refers to something that doesn't exist
+    StatusBadRequest = 2
+};
+
+class SimulationServer {
+    SimulationServer* _initCheck;
+
+    // Not owned
+    TrafficSimulation* fSimulation;
+    // Owned, NULL until the first snapshot
+    TrafficSimulation* fSnapshot;
+    int fListenSocket;
+    std::string fSocketPath;
+    bool fStopped;
+
+    // Buffers reused between requests
+    std::string fRequest;
+    std::string fReply;
+    std::vector<unsigned int> fQueryStreets;
+    std::vector<double> fPositions;
+    std::vector<double> fSpeeds;
+    std::vector<unsigned int> fStreetIndices;
+    std::vector<unsigned int> fTypes;
+    std::vector<unsigned int> fLanes;
+
+    // Fills the vehicle buffers with the vehicles of the streets in fQueryStreets, all streets if it is empty, and
+    // returns their amount
+    unsigned int queryVehicles();
+
+    // Executes the command in fRequest and writes the payload of the reply in fReply
+    EServerStatus execute(unsigned char command);
+
+public:
+    /*
+     * Serves `simulation`, which stays owned by the caller.
+     *
+     * REQUIRE(simulation.properlyInitialized(), "The simulation wasn't initialized when constructing a SimulationServer")
+     *
+     * ENSURE(properlyInitialized(), "SimulationServer constructor did not end in an initialized state")
+     */
+    explicit SimulationServer(TrafficSimulation &simulation);
+
+    /*
+     * Closes the listening socket and removes the Unix domain socket file.
+     */
+    virtual ~SimulationServer();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Listens on a Unix domain socket at `path`, replacing an existing socket file. Returns whether it succeeded.
+     *
+     * REQUIRE(properlyInitialized(), "SimulationServer wasn't initialized when calling listenUnix()")
+     * REQUIRE(!isListening(), "The server is already listening")
+     */
+    bool listenUnix(const std::string &path);
+
+    /*
+     * Listens on `port` of 127.0.0.1. Returns whether it succeeded.
+     *
+     * REQUIRE(properlyInitialized(), "SimulationServer wasn't initialized when calling listenTcp()")
+     * REQUIRE(!isListening(), "The server is already listening")
+     */
+    bool listenTcp(unsigned short port);
+
+    /*
+     * REQUIRE(properlyInitialized(), "SimulationServer wasn't initialized when calling isListening()")
+     */
+    bool isListening() const;
+
+    /*
+     * Accepts one client after the other and serves it until it closes the connection, until a client shuts the
+     * server down.
+     *
+     * REQUIRE(properlyInitialized(), "SimulationServer wasn't initialized when calling run()")
+     * REQUIRE(isListening(), "The server isn't listening")
+     *
+     * ENSURE(isStopped(), "run() postcondition")
+     */
+    void run();
+
+    /*
+     * Executes the requests that arrive on the connected socket `connection` until the client closes it or sends
+     * CommandClose or CommandShutdown. The connection stays open.
+     *
+     * REQUIRE(properlyInitialized(), "SimulationServer wasn't initialized when calling serve()")
+     */
+    void serve(int connection);
+
+    /*
+     * Returns whether a client sent CommandShutdown.
+     *
+     * REQUIRE(properlyInitialized(), "SimulationServer wasn't initialized when calling isStopped()")
+     */
+    bool isStopped() const;
+};
+
+
+#endif
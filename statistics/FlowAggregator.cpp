@@ -0,0 +1,177 @@
+// ===========================================================
+// Name         : FlowAggregator.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `FlowAggregator` class which divides every street in segments and
+//                measures their density, flow and speed per time window
+// ===========================================================
+
+#include <cmath>
+#include <algorithm>
+#include <stdint.h>
+#include "FlowAggregator.h"
+#include "../DesignByContract.h"
+#include "../Variables.h"
+#include "../TrafficSimulation.h"
+#include "../objects/Street.h"
+#include "../objects/Vehicle.h"
+
+namespace {
+    void writeUnsigned(std::ostream &onstream, uint32_t value) {
+        unsigned char bytes[4];
+        for (unsigned int i = 0; i < 4; i++) {
+            bytes[i] = (value >> (8 * i)) & 0xFF;
+        }
+        onstream.write(reinterpret_cast<const char*>(bytes), 4);
+    }
+
+    void writeFloat(std::ostream &onstream, double value) {
+        float single = (float) value;
+        uint32_t bits;
+        std::copy(reinterpret_cast<const unsigned char*>(&single), reinterpret_cast<const unsigned char*>(&single) + 4,
+                  reinterpret_cast<unsigned char*>(&bits));
+        writeUnsigned(onstream, bits);
+    }
+}
+
+FlowAggregator::FlowAggregator(double segmentLength, double window) : fSegmentLength(segmentLength), fTicks(0),
+            fWindowStart(0), fTime(0) {
+    REQUIRE(segmentLength > 0, "The segment length must be greater than 0");
+    REQUIRE(window > 0, "The time window must be greater than 0");
+
+    fWindowTicks = std::max(1, (int) floor(window / gSimulationTime + 0.5));
+    FlowAggregator::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "FlowAggregator constructor did not end in an initialized state");
+}
+
+FlowAggregator::~FlowAggregator() {}
+
+bool FlowAggregator::properlyInitialized() const {
+    return FlowAggregator::_initCheck == this;
+}
+
+void FlowAggregator::sample(const TrafficSimulation &sim) {
+    REQUIRE(properlyInitialized(), "FlowAggregator wasn't initialized when calling sample()");
+    REQUIRE(sim.properlyInitialized(), "The simulation wasn't initialized when calling sample()");
+    REQUIRE(fStreetNames.empty() || sim.getStreets().size() == fStreetNames.size(), "The streets of the simulation changed");
+
+    const std::vector<Street*> &streets = sim.getStreets();
+    if (fStreetNames.empty()) {
+        for (unsigned int i = 0; i < streets.size(); i++) {
+            unsigned int segments = std::max(1, (int) ceil(streets[i]->getLength() / fSegmentLength));
+            fStreetNames.push_back(streets[i]->getName());
+            fStreetLengths.push_back(streets[i]->getLength());
+            fTimeSpent.push_back(std::vector<double>(segments, 0));
+            fDistanceDriven.push_back(std::vector<double>(segments, 0));
+        }
+    }
+    if (fTicks == 0) {
+        fWindowStart = sim.getTime() - gSimulationTime;
+    }
+
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        const std::vector<Vehicle*> &vehicles = streets[i]->getVehicles();
+        std::vector<double> &timeSpent = fTimeSpent[i];
+        std::vector<double> &distanceDriven = fDistanceDriven[i];
+        for (unsigned int j = 0; j < vehicles.size(); j++) {
+            unsigned int segment = std::max(0, (int) (vehicles[j]->getPosition() / fSegmentLength));
+            segment = std::min(segment, (unsigned int) timeSpent.size() - 1);
+            timeSpent[segment] += gSimulationTime;
+            distanceDriven[segment] += vehicles[j]->getSpeed() * gSimulationTime;
+        }
+    }
+    fTime = sim.getTime();
+    fTicks++;
+
+    if (fTicks == fWindowTicks) {
+        closeWindow();
+    }
+}
+
+void FlowAggregator::closeWindow() {
+    for (unsigned int i = 0; i < fTimeSpent.size(); i++) {
+        for (unsigned int j = 0; j < fTimeSpent[i].size(); j++) {
+            FlowRecord record;
+            record.street = i;
+            record.segmentStart = j * fSegmentLength;
+            record.segmentEnd = std::min((double) fStreetLengths[i], (j + 1) * fSegmentLength);
+            record.windowStart = fWindowStart;
+            record.windowEnd = fTime;
+
+            // Edie's definitions over the space-time area of the segment during the window
+            double area = (record.segmentEnd - record.segmentStart) * (record.windowEnd - record.windowStart);
+            record.density = area > 0 ? fTimeSpent[i][j] / area * 1000 : 0;
+            record.flow = area > 0 ? fDistanceDriven[i][j] / area * 3600 : 0;
+            record.speed = fTimeSpent[i][j] > 0 ? fDistanceDriven[i][j] / fTimeSpent[i][j] * 3.6 : 0;
+            fRecords.push_back(record);
+
+            fTimeSpent[i][j] = 0;
+            fDistanceDriven[i][j] = 0;
+        }
+    }
+    fTicks = 0;
+}
+
+void FlowAggregator::finish() {
+    REQUIRE(properlyInitialized(), "FlowAggregator wasn't initialized when calling finish()");
+
+    if (fTicks > 0) {
+        closeWindow();
+    }
+}
+
+const std::vector<FlowRecord> &FlowAggregator::getRecords() const {
+    REQUIRE(properlyInitialized(), "FlowAggregator wasn't initialized when calling getRecords()");
+
+    return fRecords;
+}
+
+const std::string &FlowAggregator::getStreetName(unsigned int street) const {
+    REQUIRE(properlyInitialized(), "FlowAggregator wasn't initialized when calling getStreetName()");
+    REQUIRE(street < fStreetNames.size(), "The street was never sampled");
+
+    return fStreetNames[street];
+}
+
+void FlowAggregator::writeCsv(std::ostream &onstream) const {
+    REQUIRE(properlyInitialized(), "FlowAggregator wasn't initialized when calling writeCsv()");
+    REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeCsv()");
+
+    onstream << "street,segment_start,segment_end,window_start,window_end,density_veh_km,flow_veh_h,speed_km_h" << std::endl;
+    for (unsigned int i = 0; i < fRecords.size(); i++) {
+        const FlowRecord &record = fRecords[i];
+        onstream << fStreetNames[record.street] << "," << record.segmentStart << "," << record.segmentEnd << ","
+                 << record.windowStart << "," << record.windowEnd << "," << record.density << "," << record.flow
+                 << "," << record.speed << "\n";
+    }
+
+    ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeCsv()");
+}
+
+void FlowAggregator::writeBinary(std::ostream &onstream) const {
+    REQUIRE(properlyInitialized(), "FlowAggregator wasn't initialized when calling writeBinary()");
+    REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeBinary()");
+
+    onstream.write("TSFL", 4);
+    writeUnsigned(onstream, 1);
+    writeUnsigned(onstream, fStreetNames.size());
+    for (unsigned int i = 0; i < fStreetNames.size(); i++) {
+        writeUnsigned(onstream, fStreetNames[i].size());
+        onstream.write(fStreetNames[i].data(), fStreetNames[i].size());
+    }
+    writeUnsigned(onstream, fRecords.size());
+    for (unsigned int i = 0; i < fRecords.size(); i++) {
+        const FlowRecord &record = fRecords[i];
+        writeUnsigned(onstream, record.street);
+        writeFloat(onstream, record.segmentStart);
+        writeFloat(onstream, record.segmentEnd);
+        writeFloat(onstream, record.windowStart);
+        writeFloat(onstream, record.windowEnd);
+        writeFloat(onstream, record.density);
+        writeFloat(onstream, record.flow);
+        writeFloat(onstream, record.speed);
+    }
+
+    ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeBinary()");
+}
@@ -0,0 +1,117 @@
+// ===========================================================
+// Name         : FlowAggregator.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `FlowAggregator` class which divides every street in segments and
+//                measures their density, flow and speed per time window
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_FLOWAGGREGATOR_H
+#define TRAFFICSIMULATION_FLOWAGGREGATOR_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+class TrafficSimulation;
+
+// Measurement of one segment during one time window, with the density in vehicles/km, the flow in vehicles/h and the
+// space mean speed in km/h
+struct FlowRecord {
+    unsigned int street;
+    double segmentStart;
+    double segmentEnd;
+    double windowStart;
+    double windowEnd;
+    double density;
+    double flow;
+    double speed;
+};
+
+class FlowAggregator {
+    FlowAggregator* _initCheck;
+
+    double fSegmentLength;
+    unsigned int fWindowTicks;
+
+    std::vector<std::string> fStreetNames;
+    std::vector<int> fStreetLengths;
+    // Time spent (in s) and distance driven (in m) by the vehicles on every segment of every street in this window
+    std::vector<std::vector<double> > fTimeSpent;
+    std::vector<std::vector<double> > fDistanceDriven;
+    unsigned int fTicks;
+    double fWindowStart;
+    double fTime;
+
+    std::vector<FlowRecord> fRecords;
+
+    void closeWindow();
+
+public:
+    /*
+     * A window is rounded to a whole amount of ticks.
+     *
+     * REQUIRE(segmentLength > 0, "The segment length must be greater than 0")
+     * REQUIRE(window > 0, "The time window must be greater than 0")
+     *
+     * ENSURE(properlyInitialized(), "FlowAggregator constructor did not end in an initialized state")
+     */
+    FlowAggregator(double segmentLength, double window);
+
+    virtual ~FlowAggregator();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Measures the state of the simulation after a call to simulate(), every call counts for one tick. The streets
+     * of the simulation may not change between calls.
+     *
+     * REQUIRE(properlyInitialized(), "FlowAggregator wasn't initialized when calling sample()")
+     * REQUIRE(sim.properlyInitialized(), "The simulation wasn't initialized when calling sample()")
+     * REQUIRE(fStreetNames.empty() || sim.getStreets().size() == fStreetNames.size(), "The streets of the simulation changed")
+     */
+    void sample(const TrafficSimulation &sim);
+
+    /*
+     * Closes the current window, even if it isn't complete.
+     *
+     * REQUIRE(properlyInitialized(), "FlowAggregator wasn't initialized when calling finish()")
+     */
+    void finish();
+
+    /*
+     * REQUIRE(properlyInitialized(), "FlowAggregator wasn't initialized when calling getRecords()")
+     */
+    const std::vector<FlowRecord> &getRecords() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "FlowAggregator wasn't initialized when calling getStreetName()")
+     * REQUIRE(street < fStreetNames.size(), "The street was never sampled")
+     */
+    const std::string &getStreetName(unsigned int street) const;
+
+    /*
+     * Writes one line per record, preceded by a header.
+     *
+     * REQUIRE(properlyInitialized(), "FlowAggregator wasn't initialized when calling writeCsv()")
+     * REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeCsv()")
+     *
+     * ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeCsv()")
+     */
+    void writeCsv(std::ostream &onstream) const;
+
+    /*
+     * Writes the records as a little-endian table: the magic "TSFL", the version, the amount of streets followed by
+     * their names (length and characters), the amount of records followed by the records. A record is the street
+     * index as uint32 and the other fields of `FlowRecord` as float32.
+     *
+     * REQUIRE(properlyInitialized(), "FlowAggregator wasn't initialized when calling writeBinary()")
+     * REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeBinary()")
+     *
+     * ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeBinary()")
+     */
+    void writeBinary(std::ostream &onstream) const;
+};
+
+
+#endif
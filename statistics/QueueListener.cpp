@@ -0,0 +1,46 @@
+// ===========================================================
+// Name         : QueueListener.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `QueueListener` interface which is told when the queue before a traffic
+//                light spills back onto a crossroad
+// ===========================================================
+
+#include "QueueListener.h"
+#include "../DesignByContract.h"
+#include "../objects/Street.h"
+#include "../objects/TrafficLight.h"
+
+QueueListener::~QueueListener() {}
+
+QueueAlertWriter::QueueAlertWriter(std::ostream &onstream) : fStream(&onstream), fAlerts(0) {
+    QueueAlertWriter::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "QueueAlertWriter constructor did not end in an initialized state");
+}
+
+QueueAlertWriter::~QueueAlertWriter() {}
+
+bool QueueAlertWriter::properlyInitialized() const {
+    return QueueAlertWriter::_initCheck == this;
+}
+
+void QueueAlertWriter::spillback(const Street &street, const TrafficLight &trafficLight, int crossroad, double time) {
+    REQUIRE(properlyInitialized(), "QueueAlertWriter wasn't initialized when calling spillback()");
+    REQUIRE(fStream->good(), "The outputStream wasn't good when calling spillback()");
+
+    unsigned int oldAlerts = fAlerts;
+
+    *fStream << "Tijd " << time << ": de wachtrij van " << trafficLight.getQueueLength()
+             << " voertuigen voor het verkeerslicht op " << trafficLight.getPosition() << " m van " << street.getName()
+             << " reikt tot het kruispunt op " << crossroad << " m" << std::endl;
+    fAlerts++;
+
+    ENSURE(getAlerts() == oldAlerts + 1, "spillback() postcondition");
+}
+
+unsigned int QueueAlertWriter::getAlerts() const {
+    REQUIRE(properlyInitialized(), "QueueAlertWriter wasn't initialized when calling getAlerts()");
+
+    return fAlerts;
+}
@@ -0,0 +1,60 @@
+// ===========================================================
+// Name         : QueueListener.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `QueueListener` interface which is told when the queue before a traffic
+//                light spills back onto a crossroad
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_QUEUELISTENER_H
+#define TRAFFICSIMULATION_QUEUELISTENER_H
+
+#include <iostream>
+
+class Street;
+class TrafficLight;
+
+class QueueListener {
+public:
+    virtual ~QueueListener();
+
+    // Called once when the queue before `trafficLight` on `street` reaches the crossroad at `crossroad` (in m) upstream
+    // of it, and again only after the queue has cleared the crossroad
+    virtual void spillback(const Street &street, const TrafficLight &trafficLight, int crossroad, double time) = 0;
+};
+
+// Writes a line for every spillback
+class QueueAlertWriter : public QueueListener {
+    QueueAlertWriter* _initCheck;
+
+    std::ostream* fStream;
+    unsigned int fAlerts;
+
+public:
+    /*
+     * The stream is not owned by the writer.
+     *
+     * ENSURE(properlyInitialized(), "QueueAlertWriter constructor did not end in an initialized state")
+     */
+    explicit QueueAlertWriter(std::ostream &onstream = std::cout);
+
+    virtual ~QueueAlertWriter();
+
+    bool properlyInitialized() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "QueueAlertWriter wasn't initialized when calling spillback()")
+     * REQUIRE(fStream->good(), "The outputStream wasn't good when calling spillback()")
+     *
+     * ENSURE(getAlerts() == old getAlerts() + 1, "spillback() postcondition")
+     */
+    virtual void spillback(const Street &street, const TrafficLight &trafficLight, int crossroad, double time);
+
+    /*
+     * REQUIRE(properlyInitialized(), "QueueAlertWriter wasn't initialized when calling getAlerts()")
+     */
+    unsigned int getAlerts() const;
+};
+
+
+#endif
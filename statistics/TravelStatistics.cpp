@@ -0,0 +1,163 @@
+// ===========================================================
+// Name         : TravelStatistics.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `TravelStatistics` class which aggregates the journeys of the vehicles
+//                that leave the network without keeping them in memory
+// ===========================================================
+
+#include <cmath>
+#include <algorithm>
+#include "TravelStatistics.h"
+#include "../DesignByContract.h"
+#include "../objects/Vehicle.h"
+#include "../objects/VehicleType.h"
+
+RunningStatistic::RunningStatistic() : fCount(0), fMean(0), fSquaredDeviations(0), fMinimum(0), fMaximum(0) {}
+
+void RunningStatistic::add(double value) {
+    fCount++;
+    double deviation = value - fMean;
+    fMean += deviation / fCount;
+    fSquaredDeviations += deviation * (value - fMean);
+    fMinimum = fCount == 1 ? value : std::min(fMinimum, value);
+    fMaximum = fCount == 1 ? value : std::max(fMaximum, value);
+}
+
+unsigned int RunningStatistic::getCount() const {
+    return fCount;
+}
+
+double RunningStatistic::getMean() const {
+    return fMean;
+}
+
+double RunningStatistic::getVariance() const {
+    return fCount > 1 ? fSquaredDeviations / (fCount - 1) : 0;
+}
+
+double RunningStatistic::getMinimum() const {
+    return fMinimum;
+}
+
+double RunningStatistic::getMaximum() const {
+    return fMaximum;
+}
+
+Histogram::Histogram(double binWidth, unsigned int bins) : fBinWidth(binWidth), fBins(bins, 0) {}
+
+void Histogram::add(double value) {
+    unsigned int bin = value > 0 ? (unsigned int) std::min(value / fBinWidth, (double) fBins.size() - 1) : 0;
+    fBins[bin]++;
+}
+
+double Histogram::getBinWidth() const {
+    return fBinWidth;
+}
+
+const std::vector<unsigned int> &Histogram::getBins() const {
+    return fBins;
+}
+
+TravelStatistics::TravelStatistics(double binWidth, unsigned int bins) : fStatistics(gTravelStatisticCount),
+            fTravelTimes(binWidth, bins), fDelays(binWidth, bins), fFirstSpawn(0), fLastExit(0) {
+    REQUIRE(binWidth > 0, "The bin width must be greater than 0");
+    REQUIRE(bins > 0, "A histogram needs at least one bin");
+
+    TravelStatistics::_initCheck = this;
+
+    ENSURE(properlyInitialized(), "TravelStatistics constructor did not end in an initialized state");
+}
+
+TravelStatistics::~TravelStatistics() {}
+
+bool TravelStatistics::properlyInitialized() const {
+    return TravelStatistics::_initCheck == this;
+}
+
+void TravelStatistics::record(const Vehicle &vehicle) {
+    REQUIRE(properlyInitialized(), "TravelStatistics wasn't initialized when calling record()");
+    REQUIRE(vehicle.properlyInitialized(), "The vehicle wasn't initialized when calling record()");
+
+    unsigned int oldCount = fStatistics[TravelTimeStatistic].getCount();
+
+    double travelTime = vehicle.getTravelTime();
+    double delay = std::max(0.0, travelTime - vehicle.getDistance() / vehicle.getParameters().maxSpeed);
+    fStatistics[TravelTimeStatistic].add(travelTime);
+    fStatistics[DelayStatistic].add(delay);
+    fStatistics[DistanceStatistic].add(vehicle.getDistance());
+    fStatistics[StoppedTimeStatistic].add(vehicle.getStoppedTime());
+    fStatistics[BrakingTimeStatistic].add(vehicle.getBrakingTime());
+    fTravelTimes.add(travelTime);
+    fDelays.add(delay);
+
+    double exitTime = vehicle.getSpawnTime() + travelTime;
+    fFirstSpawn = oldCount == 0 ? vehicle.getSpawnTime() : std::min(fFirstSpawn, vehicle.getSpawnTime());
+    fLastExit = oldCount == 0 ? exitTime : std::max(fLastExit, exitTime);
+
+    ENSURE(getStatistic(TravelTimeStatistic).getCount() == oldCount + 1, "record() postcondition");
+}
+
+const RunningStatistic &TravelStatistics::getStatistic(ETravelStatistic statistic) const {
+    REQUIRE(properlyInitialized(), "TravelStatistics wasn't initialized when calling getStatistic()");
+
+    return fStatistics[statistic];
+}
+
+const Histogram &TravelStatistics::getTravelTimes() const {
+    REQUIRE(properlyInitialized(), "TravelStatistics wasn't initialized when calling getTravelTimes()");
+
+    return fTravelTimes;
+}
+
+const Histogram &TravelStatistics::getDelays() const {
+    REQUIRE(properlyInitialized(), "TravelStatistics wasn't initialized when calling getDelays()");
+
+    return fDelays;
+}
+
+void TravelStatistics::writeOn(std::ostream &onstream) const {
+    REQUIRE(properlyInitialized(), "TravelStatistics wasn't initialized when calling writeOn()");
+    REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeOn()");
+
+    const char* names[gTravelStatisticCount] = {"Reistijd (s)", "Vertraging (s)", "Afstand (m)", "Stilstand (s)",
+                                                "Remmen voor lichten en bushaltes (s)"};
+    unsigned int count = fStatistics[TravelTimeStatistic].getCount();
+    onstream << "Voertuigen die het netwerk verlieten: " << count << std::endl;
+    if (count == 0) {
+        ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeOn()");
+        return;
+    }
+    onstream << "Eerste vertrek: " << fFirstSpawn << std::endl
+             << "Laatste aankomst: " << fLastExit << std::endl << std::endl;
+
+    for (unsigned int i = 0; i < gTravelStatisticCount; i++) {
+        const RunningStatistic &statistic = fStatistics[i];
+        onstream << names[i] << std::endl
+                 << "-> gemiddelde: " << statistic.getMean() << std::endl
+                 << "-> standaardafwijking: " << sqrt(statistic.getVariance()) << std::endl
+                 << "-> minimum: " << statistic.getMinimum() << std::endl
+                 << "-> maximum: " << statistic.getMaximum() << std::endl << std::endl;
+    }
+
+    const Histogram* histograms[2] = {&fTravelTimes, &fDelays};
+    for (unsigned int h = 0; h < 2; h++) {
+        onstream << names[h] << " per " << histograms[h]->getBinWidth() << " s" << std::endl;
+        const std::vector<unsigned int> &bins = histograms[h]->getBins();
+        for (unsigned int i = 0; i < bins.size(); i++) {
+            if (bins[i] == 0) {
+                continue;
+            }
+            onstream << "-> " << i * histograms[h]->getBinWidth();
+            if (i + 1 == bins.size()) {
+                onstream << "+";
+            } else {
+                onstream << "-" << (i + 1) * histograms[h]->getBinWidth();
+            }
+            onstream << ": " << bins[i] << std::endl;
+        }
+        onstream << std::endl;
+    }
+
+    ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeOn()");
+}
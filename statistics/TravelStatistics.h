@@ -0,0 +1,127 @@
+// ===========================================================
+// Name         : TravelStatistics.h
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code is contains the `TravelStatistics` class which aggregates the journeys of the vehicles
+//                that leave the network without keeping them in memory
+// ===========================================================
+
+#ifndef TRAFFICSIMULATION_TRAVELSTATISTICS_H
+#define TRAFFICSIMULATION_TRAVELSTATISTICS_H
+
+#include <iostream>
+#include <vector>
+
+class Vehicle;
+
+// Mean, variance, minimum and maximum of a stream of values, updated with Welford's algorithm
+class RunningStatistic {
+    unsigned int fCount;
+    double fMean;
+    double fSquaredDeviations;
+    double fMinimum;
+    double fMaximum;
+
+public:
+    RunningStatistic();
+
+    void add(double value);
+
+    unsigned int getCount() const;
+
+    // The following functions return 0 if no value was added
+    double getMean() const;
+
+    double getVariance() const;
+
+    double getMinimum() const;
+
+    double getMaximum() const;
+};
+
+// Counts the values per bin of `binWidth`, starting at 0, the last bin also counts all larger values
+class Histogram {
+    double fBinWidth;
+    std::vector<unsigned int> fBins;
+
+public:
+    Histogram(double binWidth, unsigned int bins);
+
+    void add(double value);
+
+    double getBinWidth() const;
+
+    const std::vector<unsigned int> &getBins() const;
+};
+
+enum ETravelStatistic {
+    TravelTimeStatistic,
+    DelayStatistic,
+    DistanceStatistic,
+    StoppedTimeStatistic,
+    BrakingTimeStatistic
+};
+
+const unsigned int gTravelStatisticCount = 5;
+
+class TravelStatistics {
+    TravelStatistics* _initCheck;
+
+    std::vector<RunningStatistic> fStatistics;
+    Histogram fTravelTimes;
+    Histogram fDelays;
+    double fFirstSpawn;
+    double fLastExit;
+
+public:
+    /*
+     * The travel times and delays are also counted in a histogram with `bins` bins of `binWidth` seconds.
+     *
+     * REQUIRE(binWidth > 0, "The bin width must be greater than 0")
+     * REQUIRE(bins > 0, "A histogram needs at least one bin")
+     *
+     * ENSURE(properlyInitialized(), "TravelStatistics constructor did not end in an initialized state")
+     */
+    TravelStatistics(double binWidth, unsigned int bins);
+
+    virtual ~TravelStatistics();
+
+    bool properlyInitialized() const;
+
+    /*
+     * Records the journey of a vehicle that leaves the network. The delay is the travel time minus the time the
+     * vehicle needs to drive the same distance at its maximum speed.
+     *
+     * REQUIRE(properlyInitialized(), "TravelStatistics wasn't initialized when calling record()")
+     * REQUIRE(vehicle.properlyInitialized(), "The vehicle wasn't initialized when calling record()")
+     *
+     * ENSURE(getStatistic(TravelTimeStatistic).getCount() == old getStatistic(TravelTimeStatistic).getCount() + 1, "record() postcondition")
+     */
+    void record(const Vehicle &vehicle);
+
+    /*
+     * REQUIRE(properlyInitialized(), "TravelStatistics wasn't initialized when calling getStatistic()")
+     */
+    const RunningStatistic &getStatistic(ETravelStatistic statistic) const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "TravelStatistics wasn't initialized when calling getTravelTimes()")
+     */
+    const Histogram &getTravelTimes() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "TravelStatistics wasn't initialized when calling getDelays()")
+     */
+    const Histogram &getDelays() const;
+
+    /*
+     * REQUIRE(properlyInitialized(), "TravelStatistics wasn't initialized when calling writeOn()")
+     * REQUIRE(onstream.good(), "The outputStream wasn't good when calling writeOn()")
+     *
+     * ENSURE(onstream.good(), "The outputStream wasn't good at the end of writeOn()")
+     */
+    void writeOn(std::ostream &onstream = std::cout) const;
+};
+
+
+#endif
@@ -0,0 +1,182 @@
+// ===========================================================
+// Name         : BatchRunnerTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `BatchRunner` class of the TrafficSimulation.
+// ===========================================================
+
+#include <fstream>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
+#include "../runners/BatchRunner.h"
+
+class BatchRunnerTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {}
+
+    virtual void TearDown() {}
+
+    static std::string readFile(const std::string &filename) {
+        std::ifstream file(filename.c_str());
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+};
+
+TEST_F(BatchRunnerTest, Constructor) {
+    BatchRunner runner(2, 0);
+    EXPECT_TRUE(runner.properlyInitialized());
+    EXPECT_EQ(0u, runner.getJobCount());
+}
+
+TEST_F(BatchRunnerTest, ParseManifest) {
+    std::ofstream manifest;
+    manifest.open("testOutput/batchManifest.txt");
+    manifest << "# scenario repetitions output" << std::endl
+             << "../testInput/legalSimulation12.xml 100 batchOut1.txt" << std::endl
+             << std::endl
+             << "/absolute/scenario.xml 5 /absolute/out.txt" << std::endl
+             << "../testInput/legalSimulation12.xml 0 batchOut2.txt" << std::endl
+             << "../testInput/legalSimulation12.xml twenty batchOut2.txt" << std::endl
+             << "../testInput/legalSimulation12.xml 20" << std::endl
+             << "../testInput/legalSimulation12.xml 20 batchOut2.txt extra" << std::endl;
+    manifest.close();
+
+    BatchRunner runner(2, 0);
+    std::ostringstream errors;
+    EXPECT_TRUE(runner.parseManifest("testOutput/batchManifest.txt", errors));
+    ASSERT_EQ(2u, runner.getJobCount());
+    EXPECT_EQ("testOutput/../testInput/legalSimulation12.xml", runner.getJob(0).scenario);
+    EXPECT_EQ(100u, runner.getJob(0).repetitions);
+    EXPECT_EQ("testOutput/batchOut1.txt", runner.getJob(0).output);
+    EXPECT_EQ("/absolute/scenario.xml", runner.getJob(1).scenario);
+    EXPECT_EQ("/absolute/out.txt", runner.getJob(1).output);
+    EXPECT_EQ(JobPending, runner.getJob(1).status);
+
+    std::string message = errors.str();
+    EXPECT_NE(std::string::npos, message.find("Line 5"));
+    EXPECT_NE(std::string::npos, message.find("Line 6"));
+    EXPECT_NE(std::string::npos, message.find("Line 7"));
+    EXPECT_NE(std::string::npos, message.find("Line 8"));
+
+    EXPECT_FALSE(runner.parseManifest("testOutput/nonExistingManifest.txt", errors));
+}
+
+TEST_F(BatchRunnerTest, HappyDay) {
+    BatchRunner runner(3, 5);
+    runner.addJob("testInput/legalSimulation12.xml", 300, "testOutput/batchOut1.txt");
+    runner.addJob("testInput/legalSimulation1.xml", 50, "testOutput/batchOut2.txt");
+    runner.addJob("testInput/legalSimulation12.xml", 300, "testOutput/batchOut3.txt");
+    runner.addJob("testInput/consistencyError1.xml", 10, "testOutput/batchOut4.txt");
+    runner.addJob("testInput/legalSimulation1.xml", 10, "nonExistingDirectory/batchOut5.txt");
+    runner.run();
+
+    EXPECT_EQ(JobSucceeded, runner.getJob(0).status);
+    EXPECT_EQ(JobSucceeded, runner.getJob(1).status);
+    EXPECT_EQ(JobSucceeded, runner.getJob(2).status);
+    EXPECT_EQ(JobImportAborted, runner.getJob(3).status);
+    EXPECT_EQ(JobOutputFailed, runner.getJob(4).status);
+    EXPECT_NEAR(300 * 0.0166, runner.getJob(0).time, 1e-9);
+
+    // Jobs on the same scenario with the same seed give the same result
+    EXPECT_EQ(readFile("testOutput/batchOut1.txt"), readFile("testOutput/batchOut3.txt"));
+
+    // A job gives the same result as a normal run
+    TrafficSimulation sim;
+    std::ofstream errStream;
+    errStream.open("testOutput/BatchRunnerErrors.txt");
+    sim.parseInputFile("testInput/legalSimulation1.xml", errStream);
+    errStream.close();
+    sim.setLogStream(NULL);
+    sim.setSeed(5);
+    for (unsigned int i = 0; i < 50; i++) {
+        sim.simulate();
+    }
+    std::ostringstream expected;
+    sim.writeOn(expected);
+    EXPECT_EQ(expected.str(), readFile("testOutput/batchOut2.txt"));
+    sim.clearSimulation();
+
+    std::ofstream summary;
+    summary.open("testOutput/batchSummary.txt");
+    runner.writeOn(summary);
+    summary.close();
+    EXPECT_NE(std::string::npos, readFile("testOutput/batchSummary.txt").find("Geslaagd: 3/5"));
+    EXPECT_FALSE(runner.getJob(3).importLog.empty());
+}
+
+TEST_F(BatchRunnerTest, ImportErrors) {
+    std::ofstream input;
+    input.open("testOutput/batchPartial.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Batchbaan</naam><lengte>300</lengte></BAAN>" << std::endl
+          << "    <VOERTUIG><baan>Batchbaan</baan><positie>10</positie><type>auto</type></VOERTUIG>" << std::endl
+          << "    <DETECTOR><baan>Batchbaan</baan><interval>5</interval></DETECTOR>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+
+    BatchRunner runner(2, 0);
+    runner.addJob("testOutput/batchPartial.xml", 20, "testOutput/batchPartialOut.txt");
+    runner.addJob("testInput/legalSimulation1.xml", 20, "testOutput/batchPartialOut2.txt");
+    runner.run();
+
+    // A partially imported scenario is simulated, but it isn't a success
+    EXPECT_EQ(JobPartialImport, runner.getJob(0).status);
+    EXPECT_NE(std::string::npos, runner.getJob(0).importLog.find("Expected <positie> .. </positie>"));
+    EXPECT_FALSE(readFile("testOutput/batchPartialOut.txt").empty());
+    EXPECT_EQ(JobSucceeded, runner.getJob(1).status);
+
+    std::ostringstream summary;
+    runner.writeOn(summary);
+    EXPECT_NE(std::string::npos, summary.str().find("gedeeltelijk ingelezen"));
+    EXPECT_NE(std::string::npos, summary.str().find("Expected <positie> .. </positie>"));
+    EXPECT_NE(std::string::npos, summary.str().find("Geslaagd: 1/2"));
+}
+
+TEST_F(BatchRunnerTest, SameForEveryAmountOfThreads) {
+    const char* scenarios[] = {"legalSimulation12.xml", "legalSimulation11.xml", "legalSimulation13.xml",
+                               "legalSimulation2.xml", "legalSimulation1.xml", "legalSimulation12.xml"};
+    const unsigned int threads[] = {4, 1};
+    for (unsigned int t = 0; t < 2; t++) {
+        std::ofstream manifest;
+        manifest.open("testOutput/batchThreadsManifest.txt");
+        for (unsigned int i = 0; i < 6; i++) {
+            manifest << "../testInput/" << scenarios[i] << " " << 200 + 50 * i << " batchThreads" << threads[t] << "_" << i
+                     << ".txt" << std::endl;
+        }
+        manifest.close();
+
+        BatchRunner runner(threads[t], 7);
+        ASSERT_TRUE(runner.parseManifest("testOutput/batchThreadsManifest.txt"));
+        ASSERT_EQ(6u, runner.getJobCount());
+        runner.run();
+        for (unsigned int i = 0; i < runner.getJobCount(); i++) {
+            EXPECT_EQ(JobSucceeded, runner.getJob(i).status);
+        }
+    }
+
+    // The scenarios are parsed in another order by more threads, which mustn't change their results
+    for (unsigned int i = 0; i < 6; i++) {
+        std::ostringstream single;
+        std::ostringstream multiple;
+        single << "testOutput/batchThreads1_" << i << ".txt";
+        multiple << "testOutput/batchThreads4_" << i << ".txt";
+        EXPECT_FALSE(readFile(single.str()).empty());
+        EXPECT_EQ(readFile(single.str()), readFile(multiple.str()));
+    }
+}
+
+TEST_F(BatchRunnerTest, ContractViolations) {
+    EXPECT_DEATH(BatchRunner(0, 0), "Assertion.*failed");
+
+    BatchRunner runner(1, 0);
+    EXPECT_DEATH(runner.addJob("testInput/legalSimulation1.xml", 0, "testOutput/batchOut.txt"), "Assertion.*failed");
+    EXPECT_DEATH(runner.getJob(0), "Assertion.*failed");
+
+    BatchRunner illegalCopy = runner;
+    EXPECT_DEATH(illegalCopy.run(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.getJobCount(), "Assertion.*failed");
+}
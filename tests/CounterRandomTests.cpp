@@ -0,0 +1,138 @@
+// ===========================================================
+// Name         : CounterRandomTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `CounterRandom` class of the TrafficSimulation.
+// ===========================================================
+
+#include <fstream>
+#include "gtest/gtest.h"
+#include "../CounterRandom.h"
+#include "../TrafficSimulation.h"
+#include "../StringInterner.h"
+#include "../objects/Street.h"
+#include "../objects/Vehicle.h"
+
+namespace {
+    // Two crossing streets with a generator, the streets are named `first` and `second`
+    void writeCrossing(const std::string &filename, const std::string &first, const std::string &second) {
+        std::ofstream input;
+        input.open(filename.c_str());
+        input << "<?xml version=\"1.0\" ?>" << std::endl
+              << "<SIMULATIE>" << std::endl
+              << "    <BAAN><naam>" << first << "</naam><lengte>600</lengte></BAAN>" << std::endl
+              << "    <BAAN><naam>" << second << "</naam><lengte>500</lengte></BAAN>" << std::endl
+              << "    <KRUISPUNT><baan positie=\"200\">" << first << "</baan><baan positie=\"100\">" << second << "</baan></KRUISPUNT>" << std::endl
+              << "    <VOERTUIG><baan>" << first << "</baan><positie>20</positie><type>auto</type></VOERTUIG>" << std::endl
+              << "    <VOERTUIGGENERATOR><baan>" << first << "</baan><frequentie>7</frequentie><type>auto</type></VOERTUIGGENERATOR>" << std::endl
+              << "    <VOERTUIGGENERATOR><baan>" << second << "</baan><frequentie>11</frequentie><type>auto</type></VOERTUIGGENERATOR>" << std::endl
+              << "</SIMULATIE>" << std::endl;
+        input.close();
+    }
+}
+
+class CounterRandomTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {}
+
+    virtual void TearDown() {}
+};
+
+TEST_F(CounterRandomTest, Constructor) {
+    CounterRandom random(42);
+    EXPECT_TRUE(random.properlyInitialized());
+    EXPECT_EQ(42u, random.getSeed());
+}
+
+TEST_F(CounterRandomTest, KnownAnswer) {
+    // First word of the Philox4x32-10 known answer test for a zero key and counter
+    CounterRandom random(0);
+    EXPECT_EQ(0x6627e8d5u, random.draw(0, 0, 0, 0));
+}
+
+TEST_F(CounterRandomTest, HappyDay) {
+    CounterRandom random(7);
+    uint32_t first = random.draw(1, 2, 3, 4);
+    EXPECT_EQ(first, random.draw(1, 2, 3, 4));
+    EXPECT_NE(first, random.draw(1, 2, 4, 4));
+
+    random.setSeed(8);
+    EXPECT_EQ(8u, random.getSeed());
+    EXPECT_NE(first, random.draw(1, 2, 3, 4));
+}
+
+TEST_F(CounterRandomTest, SameSeedSameSimulation) {
+    TrafficSimulation sim1;
+    TrafficSimulation sim2;
+    std::ofstream errStream;
+    errStream.open("testOutput/CounterRandomErrors.txt");
+    sim1.parseInputFile("testInput/legalSimulation12.xml", errStream);
+    sim2.parseInputFile("testInput/legalSimulation12.xml", errStream);
+    errStream.close();
+    sim1.setLogStream(NULL);
+    sim2.setLogStream(NULL);
+    sim1.setSeed(1234);
+    sim2.setSeed(1234);
+    EXPECT_EQ(1234u, sim1.getSeed());
+
+    for (unsigned int i = 0; i < 2000; i++) {
+        sim1.simulate();
+        sim2.simulate();
+    }
+    ASSERT_EQ(sim1.getStreets().size(), sim2.getStreets().size());
+    for (unsigned int i = 0; i < sim1.getStreets().size(); i++) {
+        Street* street1 = sim1.getStreets()[i];
+        Street* street2 = sim2.getStreets()[i];
+        ASSERT_EQ(street1->getVehicles().size(), street2->getVehicles().size());
+        EXPECT_EQ(street1->getExitedVehicles(), street2->getExitedVehicles());
+        for (unsigned int j = 0; j < street1->getVehicles().size(); j++) {
+            EXPECT_EQ(street1->getVehicles()[j]->getPosition(), street2->getVehicles()[j]->getPosition());
+            EXPECT_EQ(street1->getVehicles()[j]->getOrigin(), street2->getVehicles()[j]->getOrigin());
+            EXPECT_EQ(street1->getVehicles()[j]->getSerial(), street2->getVehicles()[j]->getSerial());
+        }
+    }
+    sim1.clearSimulation();
+    sim2.clearSimulation();
+}
+
+TEST_F(CounterRandomTest, NamesDontChangeSimulation) {
+    // The names of the second simulation are interned in the opposite order, so they get other ids than the first
+    StringInterner::streetNames().intern("Tweede Hernoemde Baan");
+    StringInterner::streetNames().intern("Eerste Hernoemde Baan");
+    writeCrossing("testOutput/namedCrossing.xml", "Eerste Benoemde Baan", "Tweede Benoemde Baan");
+    writeCrossing("testOutput/renamedCrossing.xml", "Eerste Hernoemde Baan", "Tweede Hernoemde Baan");
+    TrafficSimulation sim1;
+    TrafficSimulation sim2;
+    sim1.setLogStream(NULL);
+    sim2.setLogStream(NULL);
+    ASSERT_EQ(Success, sim1.parseInputFile("testOutput/namedCrossing.xml"));
+    ASSERT_EQ(Success, sim2.parseInputFile("testOutput/renamedCrossing.xml"));
+    ASSERT_LT(sim2.getStreets()[1]->getId(), sim2.getStreets()[0]->getId());
+    sim1.setSeed(99);
+    sim2.setSeed(99);
+
+    for (unsigned int i = 0; i < 1500; i++) {
+        sim1.simulate();
+        sim2.simulate();
+    }
+    EXPECT_FALSE(sim1.getStreets()[1]->getVehicles().empty());
+    for (unsigned int i = 0; i < 2; i++) {
+        Street* street1 = sim1.getStreets()[i];
+        Street* street2 = sim2.getStreets()[i];
+        ASSERT_EQ(street1->getVehicles().size(), street2->getVehicles().size());
+        EXPECT_EQ(street1->getExitedVehicles(), street2->getExitedVehicles());
+        for (unsigned int j = 0; j < street1->getVehicles().size(); j++) {
+            EXPECT_EQ(street1->getVehicles()[j]->getPosition(), street2->getVehicles()[j]->getPosition());
+            EXPECT_EQ(street1->getVehicles()[j]->getOrigin(), street2->getVehicles()[j]->getOrigin());
+            EXPECT_EQ(street1->getVehicles()[j]->getSerial(), street2->getVehicles()[j]->getSerial());
+        }
+    }
+}
+
+TEST_F(CounterRandomTest, ContractViolations) {
+    CounterRandom random(3);
+    CounterRandom illegalCopy = random;
+    EXPECT_DEATH(illegalCopy.draw(0, 0, 0, 0), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.setSeed(1), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.getSeed(), "Assertion.*failed");
+}
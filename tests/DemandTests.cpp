@@ -0,0 +1,224 @@
+// ===========================================================
+// Name         : DemandTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `Demand` and `SpawnScheduler` classes of the TrafficSimulation.
+// ===========================================================
+
+#include <fstream>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
+#include "../SpawnScheduler.h"
+#include "../objects/Demand.h"
+#include "../objects/Street.h"
+#include "../objects/Vehicle.h"
+#include "../objects/VehicleType.h"
+#include "../StringInterner.h"
+
+TEST(DemandTest, Arrivals) {
+    Demand demand("Vraagbaan A", "Vraagbaan B");
+    EXPECT_TRUE(demand.properlyInitialized());
+    EXPECT_EQ("Vraagbaan A", demand.getOrigin());
+    EXPECT_EQ("Vraagbaan B", demand.getDestination());
+    EXPECT_EQ(-1, demand.getNextArrival());
+
+    // One vehicle every 10 s, nothing for a minute and then one every 5 s
+    demand.addPeriod(0, 60, 360);
+    demand.addPeriod(60, 120, 0);
+    demand.addPeriod(120, 180, 720);
+    EXPECT_EQ(360, demand.getRate(30));
+    EXPECT_EQ(0, demand.getRate(90));
+    EXPECT_EQ(720, demand.getRate(150));
+    EXPECT_EQ(0, demand.getRate(200));
+
+    for (unsigned int i = 1; i <= 6; i++) {
+        EXPECT_NEAR(10.0 * i, demand.getNextArrival(), 1e-9);
+        EXPECT_EQ(CarVehicle, demand.arrive());
+    }
+    EXPECT_NEAR(125, demand.getNextArrival(), 1e-9);
+    while (demand.getNextArrival() >= 0) {
+        demand.arrive();
+    }
+    EXPECT_EQ(6u + 12u, demand.getArrivals());
+
+    // A rate that doesn't fill a whole vehicle in a period carries over to the next period
+    Demand slow("Vraagbaan A", "Vraagbaan B");
+    slow.addPeriod(0, 1800, 1);
+    slow.addPeriod(1800, 3600, 3);
+    EXPECT_NEAR(1800 + 600, slow.getNextArrival(), 1e-9);
+}
+
+TEST(DemandTest, TypeMix) {
+    Demand demand("Vraagbaan A", "Vraagbaan B");
+    demand.addPeriod(0, 3600, 3600);
+    demand.addType(CarVehicle, 3);
+    demand.addType(BusVehicle, 1);
+    EXPECT_EQ(2u, demand.getTypes().size());
+
+    unsigned int types[] = {CarVehicle, CarVehicle, BusVehicle, CarVehicle};
+    for (unsigned int i = 0; i < 40; i++) {
+        EXPECT_EQ(types[i % 4], demand.arrive());
+    }
+
+    Demand* copy = demand.clone();
+    EXPECT_TRUE(copy->properlyInitialized());
+    EXPECT_EQ(demand.getNextArrival(), copy->getNextArrival());
+    EXPECT_EQ(demand.arrive(), copy->arrive());
+    delete copy;
+}
+
+TEST(DemandTest, Scheduler) {
+    SpawnScheduler scheduler;
+    EXPECT_TRUE(scheduler.properlyInitialized());
+    EXPECT_FALSE(scheduler.isDue(100));
+
+    scheduler.schedule(5, 2);
+    scheduler.schedule(1, 7);
+    scheduler.schedule(5, 1);
+    EXPECT_EQ(3u, scheduler.size());
+    EXPECT_EQ(1, scheduler.getNextTime());
+    EXPECT_FALSE(scheduler.isDue(1));
+    EXPECT_TRUE(scheduler.isDue(1.5));
+    EXPECT_EQ(7u, scheduler.pop());
+    EXPECT_FALSE(scheduler.isDue(5));
+    // Sources that are due at the same time come in the order of their numbers
+    EXPECT_EQ(1u, scheduler.pop());
+    EXPECT_EQ(2u, scheduler.pop());
+    EXPECT_EQ(0u, scheduler.size());
+
+    scheduler.schedule(3, 0);
+    scheduler.clear();
+    EXPECT_EQ(0u, scheduler.size());
+}
+
+TEST(DemandTest, Simulation) {
+    std::ofstream input;
+    input.open("testOutput/demandSimulation.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Vraagbaan A</naam><lengte>2000</lengte></BAAN>" << std::endl
+          << "    <BAAN><naam>Vraagbaan B</naam><lengte>2000</lengte></BAAN>" << std::endl
+          << "    <VOERTUIGGENERATOR><baan>Vraagbaan B</baan><frequentie>20</frequentie><type>auto</type></VOERTUIGGENERATOR>" << std::endl
+          << "    <VRAAG><herkomst>Vraagbaan A</herkomst><bestemming>Vraagbaan B</bestemming>" << std::endl
+          << "        <periode van=\"0\" tot=\"30\">360</periode><periode van=\"30\" tot=\"3600\">0</periode>" << std::endl
+          << "        <type aandeel=\"2\">auto</type><type aandeel=\"1\">bus</type></VRAAG>" << std::endl
+          << "    <KRUISPUNT><baan positie=\"1000\">Vraagbaan A</baan><baan positie=\"10\">Vraagbaan B</baan></KRUISPUNT>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    EXPECT_EQ(Success, sim.parseInputFile("testOutput/demandSimulation.xml"));
+    ASSERT_EQ(1u, sim.getDemands().size());
+    EXPECT_EQ("Vraagbaan A", sim.getDemands()[0]->getOrigin());
+
+    // 10 s: the first vehicle of the demand and the generator has spawned once, the vehicle of the generator turned
+    // onto Vraagbaan A at the crossroad
+    while (sim.getTime() < 10.5) {
+        sim.simulate();
+    }
+    const std::vector<Street*> &streets = sim.getStreets();
+    ASSERT_EQ(2u, streets[0]->getVehicles().size());
+    EXPECT_EQ(streets[1]->getIndex() + 1, streets[0]->getVehicles()[0]->getOrigin());
+    Vehicle* vehicle = streets[0]->getVehicles()[1];
+    EXPECT_TRUE(vehicle->hasDestination());
+    EXPECT_EQ(streets[1]->getIndex(), vehicle->getDestination());
+    EXPECT_EQ(CarVehicle, vehicle->getVehicleType());
+    EXPECT_TRUE(streets[1]->getVehicles().empty());
+
+    TrafficSimulation copy;
+    copy.setLogStream(NULL);
+    copy.copySimulation(sim);
+    while (sim.getTime() < 60) {
+        sim.simulate();
+        copy.simulate();
+    }
+    TrafficSimulation* simulations[] = {&sim, &copy};
+    for (unsigned int i = 0; i < 2; i++) {
+        EXPECT_EQ(3u, simulations[i]->getDemands()[0]->getArrivals());
+        EXPECT_EQ(-1, simulations[i]->getDemands()[0]->getNextArrival());
+        const std::vector<Street*> &copyStreets = simulations[i]->getStreets();
+        unsigned int buses = 0;
+        for (unsigned int j = 0; j < copyStreets.size(); j++) {
+            for (unsigned int k = 0; k < copyStreets[j]->getVehicles().size(); k++) {
+                buses += copyStreets[j]->getVehicles()[k]->getVehicleType() == BusVehicle;
+            }
+        }
+        EXPECT_EQ(1u, buses);
+        // The generator spawned at the first tick, 20 and 40 s
+        EXPECT_EQ(3u + 3u, copyStreets[0]->getVehicles().size() + copyStreets[1]->getVehicles().size());
+    }
+
+    // The vehicles of the demand turn onto their destination at the crossroad
+    while (sim.getTime() < 120) {
+        sim.simulate();
+    }
+    unsigned int arrived = 0;
+    for (unsigned int k = 0; k < streets[1]->getVehicles().size(); k++) {
+        arrived += streets[1]->getVehicles()[k]->getOrigin() == streets[0]->getIndex() + 1;
+    }
+    EXPECT_EQ(3u, arrived);
+    sim.clearSimulation();
+    EXPECT_TRUE(sim.getDemands().empty());
+}
+
+TEST(DemandTest, Parser) {
+    std::ofstream input;
+    input.open("testOutput/demandSimulation.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Vraagbaan A</naam><lengte>500</lengte></BAAN>" << std::endl
+          << "    <VRAAG><herkomst>Vraagbaan A</herkomst><bestemming>Vraagbaan A</bestemming></VRAAG>" << std::endl
+          << "    <VRAAG><herkomst>Vraagbaan A</herkomst><bestemming>Vraagbaan A</bestemming>" << std::endl
+          << "        <periode van=\"60\" tot=\"30\">100</periode></VRAAG>" << std::endl
+          << "    <VRAAG><herkomst>Vraagbaan A</herkomst><bestemming>Vraagbaan A</bestemming>" << std::endl
+          << "        <periode van=\"0\" tot=\"30\">100</periode><type>fiets</type></VRAAG>" << std::endl
+          << "    <VRAAG><herkomst>Vraagbaan A</herkomst><bestemming>Vraagbaan A</bestemming>" << std::endl
+          << "        <periode van=\"0\" tot=\"30\">100</periode><type aandeel=\"0\">auto</type></VRAAG>" << std::endl
+          << "    <VRAAG><herkomst>Vraagbaan A</herkomst><bestemming>Vraagbaan A</bestemming>" << std::endl
+          << "        <periode van=\"0\" tot=\"30\">1e300</periode></VRAAG>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+
+    TrafficSimulation sim;
+    std::ostringstream errors;
+    EXPECT_EQ(PartialImport, sim.parseInputFile("testOutput/demandSimulation.xml", errors));
+    EXPECT_TRUE(sim.getDemands().empty());
+    // A rate so high that the time can't tell its arrivals apart would spawn vehicles forever
+    EXPECT_NE(std::string::npos, errors.str().find("leaves time between the arrivals"));
+    sim.clearSimulation();
+
+    // The origin and destination must be streets of the simulation
+    input.open("testOutput/demandSimulation.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Vraagbaan A</naam><lengte>500</lengte></BAAN>" << std::endl
+          << "    <VRAAG><herkomst>Vraagbaan A</herkomst><bestemming>Nergens</bestemming>" << std::endl
+          << "        <periode van=\"0\" tot=\"30\">100</periode></VRAAG>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+    errors.str("");
+    EXPECT_EQ(ImportAborted, sim.parseInputFile("testOutput/demandSimulation.xml", errors));
+    sim.clearSimulation();
+}
+
+TEST(DemandTest, ContractViolations) {
+    Demand demand("Vraagbaan A", "Vraagbaan B");
+    EXPECT_DEATH(demand.arrive(), "Assertion.*failed");
+    EXPECT_DEATH(demand.addPeriod(10, 5, 100), "Assertion.*failed");
+    EXPECT_DEATH(demand.addPeriod(0, 5, -1), "Assertion.*failed");
+    EXPECT_DEATH(demand.addPeriod(0, 5, 1e300), "Assertion.*failed");
+    demand.addPeriod(0, 60, 100);
+    EXPECT_DEATH(demand.addPeriod(30, 90, 100), "Assertion.*failed");
+    EXPECT_DEATH(demand.addType(CarVehicle, 0), "Assertion.*failed");
+
+    SpawnScheduler scheduler;
+    EXPECT_DEATH(scheduler.pop(), "Assertion.*failed");
+    EXPECT_DEATH(scheduler.getNextTime(), "Assertion.*failed");
+
+    Demand illegalCopy = demand;
+    EXPECT_DEATH(illegalCopy.getNextArrival(), "Assertion.*failed");
+    SpawnScheduler illegalScheduler = scheduler;
+    EXPECT_DEATH(illegalScheduler.size(), "Assertion.*failed");
+}
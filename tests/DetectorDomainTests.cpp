@@ -0,0 +1,169 @@
+// ===========================================================
+// Name         : DetectorDomainTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `Detector` class of the TrafficSimulation.
+// ===========================================================
+
+#include <fstream>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
+#include "../Variables.h"
+#include "../objects/Street.h"
+#include "../objects/Detector.h"
+#include "../objects/vehicles/Car.h"
+
+class DetectorDomainTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        street = new Street("Testbaan", 500);
+    }
+
+    virtual void TearDown() {
+        delete street;
+    }
+
+    Street* street;
+};
+
+TEST_F(DetectorDomainTest, Constructor) {
+    Detector detector("Testbaan", 30, 60);
+    EXPECT_TRUE(detector.properlyInitialized());
+    EXPECT_EQ("Testbaan", detector.getStreet());
+    EXPECT_EQ(30, detector.getPosition());
+    EXPECT_NEAR(60, detector.getInterval(), gSimulationTime);
+    EXPECT_TRUE(detector.getCounts().empty());
+}
+
+TEST_F(DetectorDomainTest, HappyDay) {
+    // Intervals of 200 ticks
+    Detector* detector = new Detector("Testbaan", 100, 200 * gSimulationTime);
+    street->addDetector(detector);
+    ASSERT_EQ(1u, street->getDetectors().size());
+    street->addVehicle(new Car("Testbaan", 97));
+    street->addVehicle(new Car("Testbaan", 70));
+    street->addVehicle(new Car("Testbaan", 40));
+    street->addVehicle(new Car("Testbaan", 10));
+
+    for (unsigned int i = 0; i < 500; i++) {
+        street->driveVehicles();
+    }
+    const std::vector<unsigned int> &counts = detector->getCounts();
+    ASSERT_EQ(3u, counts.size());
+
+    // Every vehicle is counted once
+    unsigned int passed = 0;
+    for (unsigned int i = 0; i < street->getVehicles().size(); i++) {
+        if (street->getVehicles()[i]->getPosition() >= 100) {
+            passed++;
+        }
+    }
+    EXPECT_EQ(passed, counts[0] + counts[1] + counts[2]);
+    EXPECT_GE(counts[0], 1u);
+    for (unsigned int i = 0; i < counts.size(); i++) {
+        EXPECT_GE(detector->getOccupancy(i), 0);
+        EXPECT_LE(detector->getOccupancy(i), 1);
+    }
+    EXPECT_GT(detector->getOccupancy(0), 0);
+
+    std::ostringstream output;
+    detector->writeOn(output);
+    std::istringstream lines(output.str());
+    std::string line;
+    std::getline(lines, line);
+    std::ostringstream expected;
+    expected << "Testbaan,100,0," << 200 * gSimulationTime << "," << counts[0] << "," << detector->getOccupancy(0);
+    EXPECT_EQ(expected.str(), line);
+
+    Street* copy = street->clone();
+    ASSERT_EQ(1u, copy->getDetectors().size());
+    EXPECT_EQ(counts, copy->getDetectors()[0]->getCounts());
+    delete copy;
+}
+
+TEST_F(DetectorDomainTest, Lanes) {
+    // On the right lane a car passed the detector earlier, on the left lane a faster car passes it behind that car
+    Detector detector("Testbaan", 100, 200 * gSimulationTime);
+    Car passed("Testbaan", 100.5);
+    Car passing("Testbaan", 99.5);
+    passing.setLane(1);
+    passed.advance(0);
+    passing.advance(2);
+    std::vector<Vehicle*> vehicles;
+    vehicles.push_back(&passing);
+    vehicles.push_back(&passed);
+
+    detector.measure(vehicles, 2);
+    ASSERT_EQ(1u, detector.getCounts().size());
+    EXPECT_EQ(1u, detector.getCounts()[0]);
+    EXPECT_NEAR(1, detector.getOccupancy(0), 1e-9);
+
+    // Measured as one lane, the car that passed earlier hides the other one
+    Detector oneLane("Testbaan", 100, 200 * gSimulationTime);
+    oneLane.measure(vehicles);
+    EXPECT_EQ(0u, oneLane.getCounts()[0]);
+}
+
+TEST_F(DetectorDomainTest, Parser) {
+    std::ofstream input;
+    input.open("testOutput/detectorSimulation.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Detectorbaan</naam><lengte>300</lengte></BAAN>" << std::endl
+          << "    <VOERTUIG><baan>Detectorbaan</baan><positie>10</positie><type>auto</type></VOERTUIG>" << std::endl
+          << "    <DETECTOR><baan>Detectorbaan</baan><positie>50</positie><interval>5</interval></DETECTOR>" << std::endl
+          << "    <DETECTOR><baan>Detectorbaan</baan><positie>250</positie></DETECTOR>" << std::endl
+          << "    <DETECTOR><baan>Detectorbaan</baan><interval>5</interval></DETECTOR>" << std::endl
+          << "    <DETECTOR><baan>Detectorbaan</baan><positie>20</positie><interval>nul</interval></DETECTOR>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+
+    TrafficSimulation sim;
+    std::ostringstream errors;
+    EXPECT_EQ(PartialImport, sim.parseInputFile("testOutput/detectorSimulation.xml", errors));
+    EXPECT_NE(std::string::npos, errors.str().find("Expected <positie> .. </positie>"));
+    EXPECT_NE(std::string::npos, errors.str().find("Expected <interval> to be a positive number"));
+    ASSERT_EQ(1u, sim.getStreets().size());
+    const std::vector<Detector*> &detectors = sim.getStreets()[0]->getDetectors();
+    ASSERT_EQ(2u, detectors.size());
+    EXPECT_NEAR(5, detectors[0]->getInterval(), gSimulationTime);
+    EXPECT_NEAR(gDetectorInterval, detectors[1]->getInterval(), gSimulationTime);
+
+    sim.setLogStream(NULL);
+    for (unsigned int i = 0; i < 600; i++) {
+        sim.simulate();
+    }
+    unsigned int passed = 0;
+    for (unsigned int i = 0; i < detectors[0]->getCounts().size(); i++) {
+        passed += detectors[0]->getCounts()[i];
+    }
+    EXPECT_EQ(1u, passed);
+
+    std::ostringstream output;
+    sim.writeDetectors(output);
+    EXPECT_EQ(0u, output.str().find("street,position,interval_start"));
+    sim.clearSimulation();
+}
+
+TEST_F(DetectorDomainTest, ContractViolations) {
+    EXPECT_DEATH(Detector("Testbaan", 30, 0), "Assertion.*failed");
+
+    Detector* detector1 = new Detector("Testbaan", 500, 60);
+    Detector* detector2 = new Detector("Testbaan", -1, 60);
+    Detector* detector3 = new Detector("Anderebaan", 30, 60);
+    EXPECT_DEATH(street->addDetector(detector1), "Assertion.*failed");
+    EXPECT_DEATH(street->addDetector(detector2), "Assertion.*failed");
+    EXPECT_DEATH(street->addDetector(detector3), "Assertion.*failed");
+    delete detector1;
+    delete detector2;
+    delete detector3;
+
+    Detector detector("Testbaan", 30, 60);
+    EXPECT_DEATH(detector.getOccupancy(0), "Assertion.*failed");
+    EXPECT_DEATH(detector.measure(street->getVehicles(), 0), "Assertion.*failed");
+    Detector illegalCopy = detector;
+    EXPECT_DEATH(illegalCopy.getPosition(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.measure(street->getVehicles()), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.writeOn(std::cout), "Assertion.*failed");
+}
@@ -0,0 +1,119 @@
+// ===========================================================
+// Name         : EnsembleRunnerTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `EnsembleRunner` class of the TrafficSimulation.
+// ===========================================================
+
+#include <fstream>
+#include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
+#include "../runners/EnsembleRunner.h"
+#include "../objects/Street.h"
+
+class EnsembleRunnerTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        std::ofstream errStream;
+        errStream.open("testOutput/EnsembleRunnerErrors.txt");
+        scenario.parseInputFile("testInput/legalSimulation12.xml", errStream);
+        errStream.close();
+        scenario.setLogStream(NULL);
+    }
+
+    virtual void TearDown() {
+        scenario.clearSimulation();
+    }
+
+    TrafficSimulation scenario;
+};
+
+TEST_F(EnsembleRunnerTest, CopySimulation) {
+    for (unsigned int i = 0; i < 1000; i++) {
+        scenario.simulate();
+    }
+
+    TrafficSimulation copy;
+    copy.copySimulation(scenario);
+    ASSERT_EQ(scenario.getStreets().size(), copy.getStreets().size());
+    EXPECT_EQ(scenario.getTime(), copy.getTime());
+    for (unsigned int i = 0; i < copy.getStreets().size(); i++) {
+        Street* original = scenario.getStreets()[i];
+        Street* street = copy.getStreets()[i];
+        EXPECT_NE(original, street);
+        EXPECT_EQ(original->getName(), street->getName());
+        EXPECT_EQ(original->getCrossroads().size(), street->getCrossroads().size());
+        ASSERT_EQ(original->getVehicles().size(), street->getVehicles().size());
+        for (unsigned int j = 0; j < street->getVehicles().size(); j++) {
+            EXPECT_NE(original->getVehicles()[j], street->getVehicles()[j]);
+            EXPECT_EQ(original->getVehicles()[j]->getPosition(), street->getVehicles()[j]->getPosition());
+        }
+    }
+
+    // Both continue in the same way
+    copy.setLogStream(NULL);
+    for (unsigned int i = 0; i < 500; i++) {
+        scenario.simulate();
+        copy.simulate();
+    }
+    for (unsigned int i = 0; i < copy.getStreets().size(); i++) {
+        EXPECT_EQ(scenario.getStreets()[i]->getVehicles().size(), copy.getStreets()[i]->getVehicles().size());
+        EXPECT_EQ(scenario.getStreets()[i]->getExitedVehicles(), copy.getStreets()[i]->getExitedVehicles());
+    }
+    copy.clearSimulation();
+}
+
+TEST_F(EnsembleRunnerTest, HappyDay) {
+    EnsembleRunner runner(scenario, 8, 4, 42);
+    EXPECT_TRUE(runner.properlyInitialized());
+    runner.run(3000);
+
+    EXPECT_EQ(3u, runner.getStreetCount());
+    EXPECT_EQ(8u, runner.getThroughput(0).samples);
+    EXPECT_GT(runner.getThroughput(0).mean, 0);
+    EXPECT_GE(runner.getThroughput(0).halfWidth, 0);
+    EXPECT_GE(runner.getQueueLength(0).mean, 0);
+    EXPECT_GT(runner.getTravelTime().mean, 0);
+
+    // The scenario itself is not simulated
+    EXPECT_EQ(0, scenario.getTime());
+
+    std::ofstream output;
+    output.open("testOutput/ensemble.txt");
+    runner.writeOn(output);
+    output.close();
+}
+
+TEST_F(EnsembleRunnerTest, Reproducible) {
+    EnsembleRunner sequential(scenario, 6, 1, 7);
+    EnsembleRunner parallel(scenario, 6, 3, 7);
+    sequential.run(3000);
+    parallel.run(3000);
+
+    for (unsigned int i = 0; i < sequential.getStreetCount(); i++) {
+        EXPECT_EQ(sequential.getThroughput(i).mean, parallel.getThroughput(i).mean);
+        EXPECT_EQ(sequential.getThroughput(i).halfWidth, parallel.getThroughput(i).halfWidth);
+        EXPECT_EQ(sequential.getQueueLength(i).mean, parallel.getQueueLength(i).mean);
+    }
+    EXPECT_EQ(sequential.getTravelTime().mean, parallel.getTravelTime().mean);
+}
+
+TEST_F(EnsembleRunnerTest, ContractViolations) {
+    EXPECT_DEATH(EnsembleRunner(scenario, 0, 1, 0), "Assertion.*failed");
+    EXPECT_DEATH(EnsembleRunner(scenario, 1, 0, 0), "Assertion.*failed");
+
+    EnsembleRunner runner(scenario, 2, 1, 0);
+    EXPECT_DEATH(runner.getTravelTime(), "Assertion.*failed");
+    EXPECT_DEATH(runner.writeOn(std::cout), "Assertion.*failed");
+
+    runner.run(10);
+    EXPECT_DEATH(runner.getThroughput(runner.getStreetCount()), "Assertion.*failed");
+
+    EnsembleRunner illegalCopy = runner;
+    EXPECT_DEATH(illegalCopy.run(10), "Assertion.*failed");
+
+    TrafficSimulation copy;
+    copy.copySimulation(scenario);
+    EXPECT_DEATH(copy.copySimulation(scenario), "Assertion.*failed");
+    copy.clearSimulation();
+}
@@ -0,0 +1,114 @@
+// ===========================================================
+// Name         : FlowAggregatorTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `FlowAggregator` class of the TrafficSimulation.
+// ===========================================================
+
+#include <fstream>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
+#include "../Variables.h"
+#include "../statistics/FlowAggregator.h"
+
+class FlowAggregatorTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        std::ofstream input;
+        input.open("testOutput/flowSimulation.xml");
+        input << "<?xml version=\"1.0\" ?>" << std::endl
+              << "<SIMULATIE>" << std::endl
+              << "    <BAAN><naam>Flowbaan</naam><lengte>120</lengte></BAAN>" << std::endl
+              << "    <VOERTUIG><baan>Flowbaan</baan><positie>10</positie><type>auto</type></VOERTUIG>" << std::endl
+              << "</SIMULATIE>" << std::endl;
+        input.close();
+
+        std::ofstream errStream;
+        errStream.open("testOutput/FlowAggregatorErrors.txt");
+        sim.parseInputFile("testOutput/flowSimulation.xml", errStream);
+        errStream.close();
+        sim.setLogStream(NULL);
+    }
+
+    virtual void TearDown() {
+        sim.clearSimulation();
+    }
+
+    TrafficSimulation sim;
+};
+
+TEST_F(FlowAggregatorTest, Constructor) {
+    FlowAggregator aggregator(50, 60);
+    EXPECT_TRUE(aggregator.properlyInitialized());
+    EXPECT_TRUE(aggregator.getRecords().empty());
+}
+
+TEST_F(FlowAggregatorTest, HappyDay) {
+    ASSERT_EQ(1u, sim.getStreets().size());
+
+    // Windows of 60 ticks, the last one is incomplete
+    FlowAggregator aggregator(50, 60 * gSimulationTime);
+    for (unsigned int i = 0; i < 150; i++) {
+        sim.simulate();
+        aggregator.sample(sim);
+    }
+    EXPECT_EQ(6u, aggregator.getRecords().size());
+    aggregator.finish();
+    const std::vector<FlowRecord> &records = aggregator.getRecords();
+    ASSERT_EQ(9u, records.size());
+    EXPECT_EQ("Flowbaan", aggregator.getStreetName(0));
+    EXPECT_EQ(100, records[2].segmentStart);
+    EXPECT_EQ(120, records[2].segmentEnd);
+    EXPECT_NEAR(0, records[0].windowStart, 1e-9);
+    EXPECT_NEAR(60 * gSimulationTime, records[0].windowEnd, 1e-9);
+    EXPECT_NEAR(150 * gSimulationTime, records[8].windowEnd, 1e-9);
+
+    // The single vehicle is on the street during every window
+    for (unsigned int window = 0; window < 3; window++) {
+        double vehicles = 0;
+        for (unsigned int segment = 0; segment < 3; segment++) {
+            const FlowRecord &record = records[window * 3 + segment];
+            vehicles += record.density / 1000 * (record.segmentEnd - record.segmentStart);
+            if (record.density > 0) {
+                EXPECT_NEAR(record.flow, record.density * record.speed, 1e-6);
+            }
+        }
+        EXPECT_NEAR(1, vehicles, 1e-9);
+    }
+    // The vehicle starts at 10 m and accelerates, so it hasn't left the first segment yet
+    EXPECT_GT(records[0].density, 0);
+    EXPECT_GT(records[0].speed, 0);
+    EXPECT_EQ(0, records[1].density);
+    EXPECT_EQ(0, records[1].speed);
+
+    std::ostringstream csv;
+    aggregator.writeCsv(csv);
+    std::string line;
+    std::istringstream lines(csv.str());
+    unsigned int lineCount = 0;
+    while (std::getline(lines, line)) {
+        lineCount++;
+    }
+    EXPECT_EQ(10u, lineCount);
+    EXPECT_EQ(0u, csv.str().find("street,segment_start"));
+
+    std::ostringstream binary;
+    aggregator.writeBinary(binary);
+    EXPECT_EQ("TSFL", binary.str().substr(0, 4));
+    // Header, the name of the street and 9 records of 8 fields
+    EXPECT_EQ(4u + 4 + 4 + 4 + 8 + 4 + 9 * 8 * 4, binary.str().size());
+}
+
+TEST_F(FlowAggregatorTest, ContractViolations) {
+    EXPECT_DEATH(FlowAggregator(0, 60), "Assertion.*failed");
+    EXPECT_DEATH(FlowAggregator(50, 0), "Assertion.*failed");
+
+    FlowAggregator aggregator(50, 60);
+    EXPECT_DEATH(aggregator.getStreetName(0), "Assertion.*failed");
+
+    FlowAggregator illegalCopy = aggregator;
+    EXPECT_DEATH(illegalCopy.sample(sim), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.finish(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.writeCsv(std::cout), "Assertion.*failed");
+}
@@ -0,0 +1,103 @@
+// ===========================================================
+// Name         : ImageRendererTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `ImageRenderer` class of the TrafficSimulation.
+// ===========================================================
+
+#include <fstream>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
+#include "../renderers/ImageRenderer.h"
+#include "../Utils.h"
+
+class ImageRendererTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        std::ofstream errStream;
+        errStream.open("testOutput/ImageRendererErrors.txt");
+        sim.parseInputFile("testInput/legalSimulation1.xml", errStream);
+        errStream.close();
+    }
+
+    virtual void TearDown() {
+        sim.clearSimulation();
+    }
+
+    std::string readHeader(const std::string &fileName, unsigned int length) {
+        std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+        std::string header(length, '\0');
+        file.read(&header[0], length);
+        return header;
+    }
+
+    // Returns the red, green and blue value of pixel (x, y) of a PPM image as "r g b"
+    std::string readPixel(const std::string &fileName, unsigned int x, unsigned int y) {
+        std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+        std::string magic;
+        unsigned int width;
+        unsigned int height;
+        unsigned int maxValue;
+        file >> magic >> width >> height >> maxValue;
+        file.get();
+        file.seekg((y * width + x) * 3, std::ios::cur);
+        unsigned char rgb[3];
+        file.read((char*) rgb, 3);
+        std::ostringstream pixel;
+        pixel << (int) rgb[0] << " " << (int) rgb[1] << " " << (int) rgb[2];
+        return pixel.str();
+    }
+
+    TrafficSimulation sim;
+};
+
+TEST_F(ImageRendererTest, Constructor) {
+    ImageRenderer renderer(200, PPMImage, false);
+    EXPECT_TRUE(renderer.properlyInitialized());
+    EXPECT_EQ(".ppm", renderer.getExtension());
+
+    ImageRenderer pngRenderer(200, PNGImage, true);
+    EXPECT_TRUE(pngRenderer.properlyInitialized());
+    EXPECT_EQ(".png", pngRenderer.getExtension());
+}
+
+TEST_F(ImageRendererTest, RenderPPM) {
+    ASSERT_TRUE(DirectoryExists("testOutput"));
+
+    ImageRenderer renderer(200, PPMImage, false);
+    renderer.render(sim, "testOutput/image.ppm");
+
+    EXPECT_FALSE(FileIsEmpty("testOutput/image.ppm"));
+    EXPECT_EQ("P6\n200 16\n255\n", readHeader("testOutput/image.ppm", 14));
+
+    // The 500 m street and its margins of 10 m are 200 pixels wide, the row of the street is 20 m high and the road
+    // is drawn from 6 m to 14 m in it. At 400 m there is only road, the light at 200 m is green at the start.
+    double scale = 200 / 520.0;
+    EXPECT_EQ("51 51 51", readPixel("testOutput/image.ppm", (unsigned int) ((10 + 400) * scale), (unsigned int) ((10 + 10) * scale)));
+    EXPECT_EQ("0 255 0", readPixel("testOutput/image.ppm", (unsigned int) ((10 + 200) * scale), (unsigned int) ((10 + 2.5) * scale)));
+    EXPECT_EQ("255 255 255", readPixel("testOutput/image.ppm", 0, 0));
+    EXPECT_EQ("255 255 255", readPixel("testOutput/image.ppm", 199, 15));
+}
+
+TEST_F(ImageRendererTest, RenderPNGOnWorkerThread) {
+    ASSERT_TRUE(DirectoryExists("testOutput"));
+
+    ImageRenderer renderer(200, PNGImage, true);
+    for (unsigned int i = 0; i < 10; i++) {
+        sim.simulate();
+        renderer.render(sim, "testOutput/image.png");
+    }
+    renderer.flush();
+
+    EXPECT_FALSE(FileIsEmpty("testOutput/image.png"));
+    EXPECT_EQ("\x89PNG\r\n\x1a\n", readHeader("testOutput/image.png", 8));
+}
+
+TEST_F(ImageRendererTest, ContractViolations) {
+    EXPECT_DEATH(ImageRenderer(0, PPMImage, false), "Assertion.*failed");
+
+    ImageRenderer renderer(200, PPMImage, false);
+    ImageRenderer illegalCopy = renderer;
+    EXPECT_DEATH(illegalCopy.getExtension(), "Assertion.*failed");
+}
@@ -0,0 +1,90 @@
+// ===========================================================
+// Name         : MappedFileTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `MappedFile` class of the TrafficSimulation.
+// ===========================================================
+
+#include <fstream>
+#include <cstring>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "../parsers/MappedFile.h"
+
+class MappedFileTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {}
+
+    virtual void TearDown() {}
+
+    static void writeFile(const std::string &filename, const std::string &contents) {
+        std::ofstream file(filename.c_str(), std::ios::binary);
+        file << contents;
+    }
+
+    MappedFile input;
+};
+
+TEST_F(MappedFileTest, Constructor) {
+    EXPECT_TRUE(input.properlyInitialized());
+    EXPECT_FALSE(input.isOpen());
+    EXPECT_EQ(0u, input.getSize());
+}
+
+TEST_F(MappedFileTest, HappyDay) {
+    writeFile("testOutput/mappedFile.xml", "<SIMULATIE></SIMULATIE>");
+    ASSERT_TRUE(input.open("testOutput/mappedFile.xml"));
+    EXPECT_TRUE(input.isOpen());
+    EXPECT_EQ(23u, input.getSize());
+    EXPECT_STREQ("<SIMULATIE></SIMULATIE>", input.getData());
+
+    input.close();
+    EXPECT_FALSE(input.isOpen());
+    EXPECT_EQ(0u, input.getSize());
+    // Closing twice is allowed
+    input.close();
+    EXPECT_FALSE(input.isOpen());
+
+    // A file of exactly one page is null-terminated as well
+    unsigned long pageSize = sysconf(_SC_PAGESIZE);
+    writeFile("testOutput/mappedPage.xml", std::string(pageSize, 'x'));
+    ASSERT_TRUE(input.open("testOutput/mappedPage.xml"));
+    EXPECT_EQ(pageSize, input.getSize());
+    EXPECT_EQ(pageSize, std::strlen(input.getData()));
+
+    // Opening another file closes the first one
+    ASSERT_TRUE(input.open("testOutput/mappedFile.xml"));
+    EXPECT_EQ(23u, input.getSize());
+}
+
+TEST_F(MappedFileTest, MissingFile) {
+    EXPECT_FALSE(input.open("testOutput/nonExistingMappedFile.xml"));
+    EXPECT_FALSE(input.isOpen());
+    EXPECT_EQ(0u, input.getSize());
+
+    // A failed open() closes the file that was open
+    writeFile("testOutput/mappedFile.xml", "<SIMULATIE></SIMULATIE>");
+    ASSERT_TRUE(input.open("testOutput/mappedFile.xml"));
+    EXPECT_FALSE(input.open("testOutput/nonExistingMappedFile.xml"));
+    EXPECT_FALSE(input.isOpen());
+}
+
+TEST_F(MappedFileTest, EmptyFile) {
+    writeFile("testOutput/mappedEmpty.xml", "");
+    EXPECT_FALSE(input.open("testOutput/mappedEmpty.xml"));
+    EXPECT_FALSE(input.isOpen());
+    EXPECT_EQ(0u, input.getSize());
+
+    // Neither is a directory mapped
+    EXPECT_FALSE(input.open("testOutput"));
+    EXPECT_FALSE(input.isOpen());
+}
+
+TEST_F(MappedFileTest, ContractViolations) {
+    EXPECT_DEATH(input.getData(), "Assertion.*failed");
+
+    MappedFile illegalCopy = input;
+    EXPECT_DEATH(illegalCopy.open("testOutput/mappedFile.xml"), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.isOpen(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.close(), "Assertion.*failed");
+}
@@ -0,0 +1,287 @@
+// ===========================================================
+// Name         : PartitionedRunnerTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `PartitionedRunner` class and TrafficSimulation::keepStreets().
+// ===========================================================
+
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
+#include "../runners/PartitionedRunner.h"
+#include "../objects/Street.h"
+#include "../objects/Vehicle.h"
+#include "../statistics/QueueListener.h"
+
+namespace {
+    // Four parts: Noordbaan with Oostbaan, Zuidbaan with Westbaan and the Ringbaan and Havenbaan on their own
+    void writeInput() {
+        std::ofstream input;
+        input.open("testOutput/partitionedSimulation.xml");
+        input << "<?xml version=\"1.0\" ?>" << std::endl
+              << "<SIMULATIE>" << std::endl
+              << "    <BAAN><naam>Noordbaan</naam><lengte>600</lengte></BAAN>" << std::endl
+              << "    <BAAN><naam>Zuidbaan</naam><lengte>800</lengte></BAAN>" << std::endl
+              << "    <BAAN><naam>Oostbaan</naam><lengte>500</lengte></BAAN>" << std::endl
+              << "    <BAAN><naam>Westbaan</naam><lengte>700</lengte></BAAN>" << std::endl
+              << "    <BAAN><naam>Ringbaan</naam><lengte>900</lengte></BAAN>" << std::endl
+              << "    <BAAN><naam>Havenbaan</naam><lengte>400</lengte></BAAN>" << std::endl
+              << "    <KRUISPUNT><baan positie=\"200\">Noordbaan</baan><baan positie=\"100\">Oostbaan</baan></KRUISPUNT>" << std::endl
+              << "    <KRUISPUNT><baan positie=\"300\">Zuidbaan</baan><baan positie=\"150\">Westbaan</baan></KRUISPUNT>" << std::endl
+              << "    <VERKEERSLICHT><baan>Zuidbaan</baan><positie>600</positie><cyclus>20</cyclus></VERKEERSLICHT>" << std::endl
+              << "    <VERKEERSLICHT><baan>Ringbaan</baan><positie>500</positie><cyclus>15</cyclus></VERKEERSLICHT>" << std::endl
+              << "    <VOERTUIG><baan>Noordbaan</baan><positie>20</positie><type>auto</type></VOERTUIG>" << std::endl
+              << "    <VOERTUIG><baan>Zuidbaan</baan><positie>50</positie><type>bus</type></VOERTUIG>" << std::endl
+              << "    <VOERTUIG><baan>Ringbaan</baan><positie>10</positie><type>auto</type></VOERTUIG>" << std::endl
+              << "    <VOERTUIG><baan>Ringbaan</baan><positie>80</positie><type>auto</type></VOERTUIG>" << std::endl
+              << "    <VOERTUIGGENERATOR><baan>Noordbaan</baan><frequentie>7</frequentie><type>auto</type></VOERTUIGGENERATOR>" << std::endl
+              << "    <VOERTUIGGENERATOR><baan>Zuidbaan</baan><frequentie>9</frequentie><type>auto</type></VOERTUIGGENERATOR>" << std::endl
+              << "    <VOERTUIGGENERATOR><baan>Havenbaan</baan><frequentie>12</frequentie><type>auto</type></VOERTUIGGENERATOR>" << std::endl
+              << "</SIMULATIE>" << std::endl;
+        input.close();
+    }
+
+    // Stops the worker process that reports a spillback
+    class StoppingListener : public QueueListener {
+    public:
+        virtual void spillback(const Street &, const TrafficLight &, int, double) {
+            _exit(3);
+        }
+    };
+
+    void load(TrafficSimulation &sim) {
+        writeInput();
+        sim.setLogStream(NULL);
+        ASSERT_EQ(Success, sim.parseInputFile("testOutput/partitionedSimulation.xml"));
+        sim.setSeed(11);
+    }
+}
+
+TEST(PartitionedRunnerTest, Partitions) {
+    TrafficSimulation sim;
+    load(sim);
+
+    PartitionedRunner single(sim, 1, 64);
+    ASSERT_EQ(1u, single.getPartitions().size());
+    EXPECT_EQ(6u, single.getPartitions()[0].size());
+
+    // The two crossing parts are the heaviest and get a worker each, the others fill up the lightest worker
+    PartitionedRunner runner(sim, 2, 64);
+    ASSERT_EQ(2u, runner.getPartitions().size());
+    std::vector<unsigned int> first = runner.getPartitions()[0];
+    std::vector<unsigned int> second = runner.getPartitions()[1];
+    ASSERT_EQ(3u, first.size());
+    EXPECT_EQ(0u, first[0]);
+    EXPECT_EQ(2u, first[1]);
+    EXPECT_EQ(4u, first[2]);
+    ASSERT_EQ(3u, second.size());
+    EXPECT_EQ(1u, second[0]);
+    EXPECT_EQ(3u, second[1]);
+    EXPECT_EQ(5u, second[2]);
+
+    // Never more workers than parts
+    PartitionedRunner many(sim, 16, 64);
+    EXPECT_EQ(4u, many.getPartitions().size());
+    EXPECT_EQ(0u, sim.getTick());
+}
+
+TEST(PartitionedRunnerTest, CrossroadAtTheEnd) {
+    std::ofstream input;
+    input.open("testOutput/partitionedEnd.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Eerste</naam><lengte>300</lengte></BAAN>" << std::endl
+          << "    <BAAN><naam>Tweede</naam><lengte>300</lengte></BAAN>" << std::endl
+          << "    <BAAN><naam>Derde</naam><lengte>300</lengte></BAAN>" << std::endl
+          << "    <BAAN><naam>Vierde</naam><lengte>300</lengte></BAAN>" << std::endl
+          << "    <KRUISPUNT><baan positie=\"300\">Tweede</baan><baan positie=\"0\">Derde</baan></KRUISPUNT>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    ASSERT_EQ(Success, sim.parseInputFile("testOutput/partitionedEnd.xml"));
+
+    // The crossroad at the end of Tweede stops the crossroads of Vierde as well
+    PartitionedRunner runner(sim, 4, 64);
+    ASSERT_EQ(2u, runner.getPartitions().size());
+    EXPECT_EQ(3u, runner.getPartitions()[0].size());
+    EXPECT_EQ(1u, runner.getPartitions()[0][0]);
+    EXPECT_EQ(3u, runner.getPartitions()[0][2]);
+    ASSERT_EQ(1u, runner.getPartitions()[1].size());
+    EXPECT_EQ(0u, runner.getPartitions()[1][0]);
+}
+
+TEST(PartitionedRunnerTest, SameAsSingleProcess) {
+    TrafficSimulation sim;
+    load(sim);
+    PartitionedRunner runner(sim, 3, 64);
+    ASSERT_EQ(3u, runner.getPartitions().size());
+
+    std::ostringstream before;
+    std::ostringstream initial;
+    sim.writeOn(initial);
+    runner.writeOn(before);
+    EXPECT_EQ(initial.str(), before.str());
+
+    // Long enough for vehicles to turn onto Oostbaan and Westbaan
+    ASSERT_TRUE(runner.run(3000));
+    EXPECT_EQ(3000u, runner.getTick());
+    // The workers simulated copies
+    EXPECT_EQ(0u, sim.getTick());
+
+    for (unsigned int i = 0; i < 3000; i++) {
+        sim.simulate();
+    }
+    EXPECT_FALSE(sim.getStreets()[2]->getVehicles().empty());
+    EXPECT_EQ(sim.getTime(), runner.getTime());
+    std::ostringstream expected;
+    std::ostringstream partitioned;
+    sim.writeOn(expected);
+    runner.writeOn(partitioned);
+    EXPECT_EQ(expected.str(), partitioned.str());
+
+    double positions[64];
+    unsigned int streets[64];
+    VehicleBuffers buffers = {positions, NULL, streets, NULL, NULL, 64};
+    unsigned int vehicles = runner.queryVehicles(buffers);
+    VehicleBuffers count = {NULL, NULL, NULL, NULL, NULL, 0};
+    ASSERT_EQ(sim.queryVehicles(NULL, 0, count), vehicles);
+    ASSERT_LT(0u, vehicles);
+    const std::vector<Vehicle*> &front = sim.getStreets()[streets[0]]->getVehicles();
+    EXPECT_EQ(front[0]->getPosition(), positions[0]);
+}
+
+TEST(PartitionedRunnerTest, SmallMailboxes) {
+    TrafficSimulation sim;
+    load(sim);
+    // Room for the vehicles at the start, not for the ones the generators add
+    PartitionedRunner runner(sim, 4, 2);
+    std::ostringstream errors;
+    EXPECT_FALSE(runner.run(1000, errors));
+    EXPECT_NE(std::string::npos, errors.str().find("has room for 2 vehicles"));
+
+    // The state is the one of the last tick that fit
+    EXPECT_LT(0u, runner.getTick());
+    EXPECT_GT(1000u, runner.getTick());
+    for (unsigned int i = 0; i < runner.getTick(); i++) {
+        sim.simulate();
+    }
+    VehicleBuffers count = {NULL, NULL, NULL, NULL, NULL, 0};
+    EXPECT_EQ(sim.queryVehicles(NULL, 0, count), runner.queryVehicles(count));
+    std::ostringstream expected;
+    std::ostringstream partitioned;
+    sim.writeOn(expected);
+    runner.writeOn(partitioned);
+    EXPECT_EQ(expected.str(), partitioned.str());
+}
+
+TEST(PartitionedRunnerTest, WorkerStops) {
+    std::ofstream input;
+    input.open("testOutput/partitionedSpillback.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Testbaan</naam><lengte>500</lengte></BAAN>" << std::endl
+          << "    <BAAN><naam>Kruisbaan</naam><lengte>500</lengte></BAAN>" << std::endl
+          << "    <BAAN><naam>Losbaan</naam><lengte>500</lengte></BAAN>" << std::endl
+          << "    <KRUISPUNT><baan positie=\"250\">Testbaan</baan><baan positie=\"250\">Kruisbaan</baan></KRUISPUNT>" << std::endl
+          << "    <VERKEERSLICHT><baan>Testbaan</baan><positie>300</positie><cyclus>60</cyclus></VERKEERSLICHT>" << std::endl
+          << "    <VOERTUIG><baan>Testbaan</baan><positie>290</positie><type>auto</type></VOERTUIG>" << std::endl
+          << "    <VOERTUIG><baan>Testbaan</baan><positie>281</positie><type>auto</type></VOERTUIG>" << std::endl
+          << "    <VOERTUIG><baan>Testbaan</baan><positie>272</positie><type>auto</type></VOERTUIG>" << std::endl
+          << "    <VOERTUIG><baan>Testbaan</baan><positie>263</positie><type>auto</type></VOERTUIG>" << std::endl
+          << "    <VOERTUIG><baan>Testbaan</baan><positie>254</positie><type>auto</type></VOERTUIG>" << std::endl
+          << "    <VOERTUIG><baan>Testbaan</baan><positie>245</positie><type>auto</type></VOERTUIG>" << std::endl
+          << "    <VOERTUIG><baan>Losbaan</baan><positie>10</positie><type>auto</type></VOERTUIG>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    ASSERT_EQ(Success, sim.parseInputFile("testOutput/partitionedSpillback.xml"));
+
+    // The row of standing cars before the light spills back onto the crossroad
+    TrafficSimulation copy;
+    copy.copySimulation(sim);
+    copy.setLogStream(NULL);
+    std::ostringstream alerts;
+    QueueAlertWriter writer(alerts);
+    copy.setQueueListener(&writer);
+    for (unsigned int i = 0; i < 2000 && writer.getAlerts() == 0; i++) {
+        copy.simulate();
+    }
+    ASSERT_LT(0u, writer.getAlerts());
+
+    // The worker of Testbaan stops at the spillback, the run ends instead of waiting for it
+    StoppingListener stopping;
+    sim.setQueueListener(&stopping);
+    PartitionedRunner runner(sim, 2, 64);
+    ASSERT_EQ(2u, runner.getPartitions().size());
+    std::ostringstream errors;
+    EXPECT_FALSE(runner.run(2000, errors));
+    EXPECT_NE(std::string::npos, errors.str().find("stopped during tick"));
+    EXPECT_GT(2000u, runner.getTick());
+    sim.setQueueListener(NULL);
+
+    // The runner can run again
+    EXPECT_TRUE(runner.run(10));
+    EXPECT_EQ(10u, runner.getTick());
+}
+
+TEST(PartitionedRunnerTest, KeepStreets) {
+    TrafficSimulation whole;
+    load(whole);
+    TrafficSimulation part;
+    load(part);
+    std::vector<unsigned int> kept;
+    kept.push_back(1);
+    kept.push_back(3);
+    part.keepStreets(kept);
+    ASSERT_EQ(2u, part.getStreets().size());
+    EXPECT_EQ("Zuidbaan", part.getStreets()[0]->getName());
+    EXPECT_EQ("Westbaan", part.getStreets()[1]->getName());
+
+    for (unsigned int i = 0; i < 3000; i++) {
+        whole.simulate();
+        part.simulate();
+    }
+    for (unsigned int s = 0; s < kept.size(); s++) {
+        const std::vector<Vehicle*> &expected = whole.getStreets()[kept[s]]->getVehicles();
+        const std::vector<Vehicle*> &vehicles = part.getStreets()[s]->getVehicles();
+        ASSERT_EQ(expected.size(), vehicles.size());
+        for (unsigned int i = 0; i < vehicles.size(); i++) {
+            EXPECT_EQ(expected[i]->getPosition(), vehicles[i]->getPosition());
+            EXPECT_EQ(expected[i]->getSpeed(), vehicles[i]->getSpeed());
+        }
+    }
+
+    // A partition of a partition keeps the turns of the whole network
+    std::vector<unsigned int> again;
+    again.push_back(0);
+    again.push_back(1);
+    part.keepStreets(again);
+    EXPECT_EQ(2u, part.getStreets().size());
+}
+
+TEST(PartitionedRunnerTest, ContractViolations) {
+    TrafficSimulation sim;
+    load(sim);
+    EXPECT_DEATH(PartitionedRunner(sim, 0, 64), "Assertion.*failed");
+    EXPECT_DEATH(PartitionedRunner(sim, 2, 0), "Assertion.*failed");
+
+    std::vector<unsigned int> descending;
+    descending.push_back(3);
+    descending.push_back(1);
+    EXPECT_DEATH(sim.keepStreets(descending), "Assertion.*failed");
+    // Oostbaan crosses Noordbaan
+    std::vector<unsigned int> cut(1, 0);
+    EXPECT_DEATH(sim.keepStreets(cut), "Assertion.*failed");
+    std::vector<unsigned int> missing(1, 6);
+    EXPECT_DEATH(sim.keepStreets(missing), "Assertion.*failed");
+
+    PartitionedRunner runner(sim, 2, 64);
+    PartitionedRunner illegalCopy = runner;
+    EXPECT_DEATH(illegalCopy.getPartitions(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.run(1), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.writeOn(), "Assertion.*failed");
+}
@@ -0,0 +1,234 @@
+// ===========================================================
+// Name         : RoadNetworkTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `RoadNetwork` class of the TrafficSimulation.
+// ===========================================================
+
+#include <fstream>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
+#include "../objects/Street.h"
+#include "../routing/RoadNetwork.h"
+
+class RoadNetworkTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        // A crosses B at 100 (50 on B), B crosses C at 200 (100 on C)
+        streets.push_back(new Street("Routebaan A", 300));
+        streets.push_back(new Street("Routebaan B", 300));
+        streets.push_back(new Street("Routebaan C", 300));
+        for (unsigned int i = 0; i < streets.size(); i++) {
+            streets[i]->setIndex(i);
+        }
+        streets[0]->addCrossroad(streets[1], 100);
+        streets[1]->addCrossroad(streets[0], 50);
+        streets[1]->addCrossroad(streets[2], 200);
+        streets[2]->addCrossroad(streets[1], 100);
+        for (unsigned int i = 0; i < streets.size(); i++) {
+            destinations.push_back(i);
+        }
+    }
+
+    virtual void TearDown() {
+        for (unsigned int i = 0; i < streets.size(); i++) {
+            delete streets[i];
+        }
+    }
+
+    // The index of the crossroad with `crossing` in the crossroad map of `street`
+    unsigned int crossroad(unsigned int street, unsigned int crossing) {
+        const std::map<Street*,int> &crossroads = streets[street]->getCrossroads();
+        unsigned int k = 0;
+        for (std::map<Street*,int>::const_iterator it = crossroads.begin(); it->first != streets[crossing]; it++) {
+            k++;
+        }
+        return k;
+    }
+
+    std::vector<Street*> streets;
+    std::vector<unsigned int> destinations;
+};
+
+TEST_F(RoadNetworkTest, Routes) {
+    RoadNetwork network(streets, destinations);
+    EXPECT_TRUE(network.properlyInitialized());
+    EXPECT_EQ(3u, network.getStreetCount());
+    EXPECT_EQ(4u, network.getCrossroadCount());
+    unsigned int a = 0;
+    unsigned int b = 1;
+    unsigned int c = 2;
+    EXPECT_TRUE(network.contains(c));
+    EXPECT_FALSE(network.contains(3));
+
+    // To C: turn onto B and then onto C
+    EXPECT_EQ(RouteTurn, network.getChoice(c, 0, crossroad(0, 1)));
+    EXPECT_EQ(RouteTurn, network.getChoice(c, 1, crossroad(1, 2)));
+    EXPECT_EQ(RouteStraight, network.getChoice(c, 2, crossroad(2, 1)));
+    // To A: stay on A, B turns onto A
+    EXPECT_EQ(RouteStraight, network.getChoice(a, 0, crossroad(0, 1)));
+    EXPECT_EQ(RouteTurn, network.getChoice(a, 1, crossroad(1, 0)));
+    // A can't be reached from C
+    EXPECT_EQ(RouteUnknown, network.getChoice(a, 2, crossroad(2, 1)));
+
+    EXPECT_EQ(300, network.getDistance(0, a));
+    EXPECT_EQ(50 + 200, network.getDistance(1, a));
+    EXPECT_EQ(-1, network.getDistance(2, a));
+    EXPECT_EQ(100 + 250, network.getDistance(0, b));
+    EXPECT_EQ(100 + 150 + 200, network.getDistance(0, c));
+}
+
+TEST_F(RoadNetworkTest, PartitionIndices) {
+    // The streets of a partition keep their index in the whole network
+    streets[0]->setIndex(4);
+    streets[1]->setIndex(9);
+    streets[2]->setIndex(6);
+    RoadNetwork network(streets, std::vector<unsigned int>(1, 6));
+    EXPECT_TRUE(network.contains(9));
+    EXPECT_FALSE(network.contains(0));
+    EXPECT_FALSE(network.contains(10));
+    EXPECT_TRUE(network.hasRoutes(6));
+    EXPECT_FALSE(network.hasRoutes(9));
+    EXPECT_EQ(RouteTurn, network.getChoice(6, 0, crossroad(0, 1)));
+    EXPECT_EQ(100 + 150 + 200, network.getDistance(0, 6));
+}
+
+TEST_F(RoadNetworkTest, ReferencedDestinations) {
+    // Only the destinations that are part of the network get routes, duplicates once
+    std::vector<unsigned int> referenced;
+    referenced.push_back(2);
+    referenced.push_back(7);
+    referenced.push_back(2);
+    RoadNetwork network(streets, referenced);
+    EXPECT_TRUE(network.contains(0));
+    EXPECT_FALSE(network.hasRoutes(0));
+    EXPECT_FALSE(network.hasRoutes(1));
+    EXPECT_TRUE(network.hasRoutes(2));
+    EXPECT_FALSE(network.hasRoutes(7));
+    EXPECT_EQ(RouteTurn, network.getChoice(2, 0, crossroad(0, 1)));
+    EXPECT_EQ(RouteTurn, network.getChoice(2, 1, crossroad(1, 2)));
+    // The distances are searched on demand, also to a destination without routes
+    EXPECT_EQ(300, network.getDistance(0, 0));
+    EXPECT_EQ(-1, network.getDistance(2, 0));
+
+    RoadNetwork empty(streets, std::vector<unsigned int>());
+    EXPECT_EQ(4u, empty.getCrossroadCount());
+    EXPECT_FALSE(empty.hasRoutes(2));
+    EXPECT_EQ(100 + 250, empty.getDistance(0, 1));
+}
+
+TEST_F(RoadNetworkTest, Clone) {
+    RoadNetwork network(streets, destinations);
+    std::vector<Street*> copies;
+    for (unsigned int i = 0; i < streets.size(); i++) {
+        copies.push_back(new Street(streets[i]->getName(), streets[i]->getLength()));
+    }
+    // Added in the other order, the maps of the copies are sorted on other addresses
+    copies[2]->addCrossroad(copies[1], 100);
+    copies[1]->addCrossroad(copies[2], 200);
+    copies[1]->addCrossroad(copies[0], 50);
+    copies[0]->addCrossroad(copies[1], 100);
+
+    RoadNetwork* copy = network.clone(copies);
+    EXPECT_TRUE(copy->properlyInitialized());
+    const std::map<Street*,int> &crossroads = copies[1]->getCrossroads();
+    unsigned int k = 0;
+    for (std::map<Street*,int>::const_iterator it = crossroads.begin(); it != crossroads.end(); it++, k++) {
+        ERouteChoice expected = it->first == copies[2] ? RouteTurn : RouteStraight;
+        EXPECT_EQ(expected, copy->getChoice(2, 1, k));
+    }
+    EXPECT_TRUE(copy->hasRoutes(0));
+    delete copy;
+    for (unsigned int i = 0; i < copies.size(); i++) {
+        delete copies[i];
+    }
+}
+
+TEST_F(RoadNetworkTest, Simulation) {
+    std::ofstream input;
+    input.open("testOutput/routeSimulation.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Routebaan A</naam><lengte>300</lengte></BAAN>" << std::endl
+          << "    <BAAN><naam>Routebaan B</naam><lengte>300</lengte></BAAN>" << std::endl
+          << "    <BAAN><naam>Routebaan C</naam><lengte>300</lengte></BAAN>" << std::endl
+          << "    <VOERTUIG><baan>Routebaan A</baan><positie>20</positie><type>auto</type><bestemming>Routebaan C</bestemming></VOERTUIG>" << std::endl
+          << "    <VOERTUIG><baan>Routebaan A</baan><positie>0</positie><type>auto</type><bestemming>Routebaan A</bestemming></VOERTUIG>" << std::endl
+          << "    <KRUISPUNT><baan positie=\"100\">Routebaan A</baan><baan positie=\"50\">Routebaan B</baan></KRUISPUNT>" << std::endl
+          << "    <KRUISPUNT><baan positie=\"200\">Routebaan B</baan><baan positie=\"100\">Routebaan C</baan></KRUISPUNT>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    EXPECT_EQ(Success, sim.parseInputFile("testOutput/routeSimulation.xml"));
+    ASSERT_TRUE(sim.getNetwork() != NULL);
+    EXPECT_EQ(3u, sim.getNetwork()->getStreetCount());
+
+    TrafficSimulation copy;
+    copy.setLogStream(NULL);
+    copy.copySimulation(sim);
+    for (unsigned int i = 0; i < 5000; i++) {
+        sim.simulate();
+        copy.simulate();
+    }
+    TrafficSimulation* simulations[] = {&sim, &copy};
+    for (unsigned int i = 0; i < 2; i++) {
+        const std::vector<Street*> &streets = simulations[i]->getStreets();
+        EXPECT_EQ(1u, streets[0]->getFinishedVehicles());
+        EXPECT_EQ(0u, streets[1]->getFinishedVehicles());
+        EXPECT_EQ(1u, streets[2]->getFinishedVehicles());
+    }
+    sim.clearSimulation();
+    EXPECT_TRUE(sim.getNetwork() == NULL);
+
+    // Without destinations no network is built
+    input.open("testOutput/routeSimulation.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Routebaan A</naam><lengte>300</lengte></BAAN>" << std::endl
+          << "    <BAAN><naam>Routebaan B</naam><lengte>300</lengte></BAAN>" << std::endl
+          << "    <VOERTUIG><baan>Routebaan A</baan><positie>20</positie><type>auto</type></VOERTUIG>" << std::endl
+          << "    <KRUISPUNT><baan positie=\"100\">Routebaan A</baan><baan positie=\"50\">Routebaan B</baan></KRUISPUNT>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+    EXPECT_EQ(Success, sim.parseInputFile("testOutput/routeSimulation.xml"));
+    EXPECT_TRUE(sim.getNetwork() == NULL);
+    for (unsigned int i = 0; i < 100; i++) {
+        sim.simulate();
+    }
+    sim.clearSimulation();
+
+    // The destination must be a street of the simulation
+    input.open("testOutput/routeSimulation.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Routebaan A</naam><lengte>300</lengte></BAAN>" << std::endl
+          << "    <VOERTUIGGENERATOR><baan>Routebaan A</baan><frequentie>5</frequentie><type>auto</type><bestemming>Nergens</bestemming></VOERTUIGGENERATOR>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+    std::ostringstream errors;
+    EXPECT_EQ(ImportAborted, sim.parseInputFile("testOutput/routeSimulation.xml", errors));
+    sim.clearSimulation();
+}
+
+TEST_F(RoadNetworkTest, ContractViolations) {
+    RoadNetwork network(streets, destinations);
+    EXPECT_DEATH(network.getChoice(3, 0, 0), "Assertion.*failed");
+    EXPECT_DEATH(network.getChoice(0, 3, 0), "Assertion.*failed");
+    EXPECT_DEATH(network.getChoice(0, 0, 1), "Assertion.*failed");
+    std::vector<Street*> fewerStreets(1, streets[0]);
+    EXPECT_DEATH(network.clone(fewerStreets), "Assertion.*failed");
+
+    RoadNetwork illegalCopy = network;
+    EXPECT_DEATH(illegalCopy.getStreetCount(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.getDistance(0, 0), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.hasRoutes(0), "Assertion.*failed");
+
+    RoadNetwork withoutRoutes(streets, std::vector<unsigned int>(1, 2));
+    EXPECT_DEATH(withoutRoutes.getChoice(0, 0, 0), "Assertion.*failed");
+
+    streets[2]->setIndex(0);
+    EXPECT_DEATH(RoadNetwork duplicate(streets, destinations), "Assertion.*failed");
+}
@@ -0,0 +1,409 @@
+// ===========================================================
+// Name         : SimulationServerTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `SimulationServer` class of the TrafficSimulation.
+// ===========================================================
+
+#include <fstream>
+#include <cstring>
+#include <limits>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
+#include "../server/SimulationServer.h"
+#include "../objects/Street.h"
+#include "../objects/Vehicle.h"
+#include "../objects/VehicleType.h"
+#include "../objects/TrafficLight.h"
+#include "../statistics/TravelStatistics.h"
+#include "../statistics/QueueListener.h"
+#include "../Variables.h"
+
+namespace {
+    void appendUnsigned(std::string &buffer, uint32_t value) {
+        for (unsigned int i = 0; i < 4; i++) {
+            buffer += (char) ((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    void appendDouble(std::string &buffer, double value) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        for (unsigned int i = 0; i < 8; i++) {
+            buffer += (char) ((bits >> (8 * i)) & 0xFF);
+        }
+    }
+
+    uint32_t readUnsigned(const std::string &buffer, unsigned int offset) {
+        uint32_t value = 0;
+        for (unsigned int i = 0; i < 4; i++) {
+            value |= (uint32_t) (unsigned char) buffer[offset + i] << (8 * i);
+        }
+        return value;
+    }
+
+    double readDouble(const std::string &buffer, unsigned int offset) {
+        uint64_t bits = 0;
+        for (unsigned int i = 0; i < 8; i++) {
+            bits |= (uint64_t) (unsigned char) buffer[offset + i] << (8 * i);
+        }
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void appendRequest(std::string &requests, unsigned char command, const std::string &payload) {
+        requests += (char) command;
+        appendUnsigned(requests, payload.size());
+        requests += payload;
+    }
+
+    // Splits the bytes of the replies in (status, payload) pairs
+    std::vector<std::pair<int, std::string> > splitReplies(const std::string &replies) {
+        std::vector<std::pair<int, std::string> > result;
+        unsigned int offset = 0;
+        while (offset + 5 <= replies.size()) {
+            uint32_t size = readUnsigned(replies, offset + 1);
+            result.push_back(std::make_pair((int) (unsigned char) replies[offset], replies.substr(offset + 5, size)));
+            offset += 5 + size;
+        }
+        return result;
+    }
+
+    // Sends all requests over a socket pair, serves them and returns the replies
+    std::vector<std::pair<int, std::string> > serveRequests(SimulationServer &server, const std::string &requests) {
+        int sockets[2];
+        EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+        EXPECT_EQ((ssize_t) requests.size(), write(sockets[0], requests.data(), requests.size()));
+        shutdown(sockets[0], SHUT_WR);
+        server.serve(sockets[1]);
+        close(sockets[1]);
+
+        std::string replies;
+        char buffer[4096];
+        ssize_t received;
+        while ((received = read(sockets[0], buffer, sizeof(buffer))) > 0) {
+            replies.append(buffer, received);
+        }
+        close(sockets[0]);
+        return splitReplies(replies);
+    }
+
+    void writeInput() {
+        std::ofstream input;
+        input.open("testOutput/serverSimulation.xml");
+        input << "<?xml version=\"1.0\" ?>" << std::endl
+              << "<SIMULATIE>" << std::endl
+              << "    <BAAN><naam>Serverbaan</naam><lengte>1000</lengte></BAAN>" << std::endl
+              << "    <VERKEERSLICHT><baan>Serverbaan</baan><positie>800</positie><cyclus>20</cyclus></VERKEERSLICHT>" << std::endl
+              << "    <VOERTUIG><baan>Serverbaan</baan><positie>100</positie><type>auto</type></VOERTUIG>" << std::endl
+              << "    <BAAN><naam>Serverzijbaan</naam><lengte>500</lengte></BAAN>" << std::endl
+              << "    <VOERTUIG><baan>Serverzijbaan</baan><positie>20</positie><type>bus</type></VOERTUIG>" << std::endl
+              << "</SIMULATIE>" << std::endl;
+        input.close();
+    }
+}
+
+TEST(SimulationServerTest, Commands) {
+    writeInput();
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    ASSERT_EQ(Success, sim.parseInputFile("testOutput/serverSimulation.xml"));
+    SimulationServer server(sim);
+    EXPECT_TRUE(server.properlyInitialized());
+    EXPECT_FALSE(server.isListening());
+
+    std::string requests;
+    std::string payload;
+    appendUnsigned(payload, 10);
+    appendRequest(requests, CommandStep, payload);
+    appendRequest(requests, CommandTime, "");
+    appendRequest(requests, CommandStreets, "");
+    payload.clear();
+    appendUnsigned(payload, 0);
+    appendRequest(requests, CommandVehicles, payload);
+    appendRequest(requests, CommandSnapshot, "");
+    payload.clear();
+    appendUnsigned(payload, 0);
+    appendDouble(payload, 300);
+    appendUnsigned(payload, BusVehicle);
+    appendUnsigned(payload, 0);
+    appendRequest(requests, CommandInject, payload);
+    payload.clear();
+    appendUnsigned(payload, 0);
+    appendUnsigned(payload, 0);
+    appendUnsigned(payload, 45);
+    appendRequest(requests, CommandSetCycle, payload);
+    appendRequest(requests, CommandRestore, "");
+    appendRequest(requests, 99, "");
+    payload.clear();
+    appendUnsigned(payload, 5);
+    appendRequest(requests, CommandVehicles, payload);
+    appendRequest(requests, CommandClose, "");
+    // Requests after CommandClose are never read
+    appendRequest(requests, CommandTime, "");
+
+    std::vector<std::pair<int, std::string> > replies = serveRequests(server, requests);
+    ASSERT_EQ(11u, replies.size());
+    for (unsigned int i = 0; i < 8; i++) {
+        EXPECT_EQ(StatusOk, replies[i].first);
+    }
+    double time = readDouble(replies[0].second, 0);
+    EXPECT_DOUBLE_EQ(sim.getTime(), time);
+    EXPECT_DOUBLE_EQ(time, readDouble(replies[1].second, 0));
+    EXPECT_EQ(10u, readUnsigned(replies[1].second, 8));
+
+    const std::string &streets = replies[2].second;
+    EXPECT_EQ(2u, readUnsigned(streets, 0));
+    EXPECT_EQ(10u, readUnsigned(streets, 4));
+    EXPECT_EQ("Serverbaan", streets.substr(8, 10));
+    EXPECT_EQ(1000u, readUnsigned(streets, 18));
+    EXPECT_EQ(1u, readUnsigned(streets, 22));
+    EXPECT_EQ(1u, readUnsigned(streets, 26));
+    EXPECT_EQ(1u, readUnsigned(streets, 30));
+    EXPECT_EQ(0u, readUnsigned(streets, 34));
+
+    const std::string &vehicles = replies[3].second;
+    ASSERT_EQ(4u + 24u, vehicles.size());
+    EXPECT_EQ(1u, readUnsigned(vehicles, 0));
+    Vehicle* vehicle = sim.getStreets()[0]->getVehicles()[0];
+    EXPECT_DOUBLE_EQ(vehicle->getPosition(), readDouble(vehicles, 4));
+    EXPECT_DOUBLE_EQ(vehicle->getSpeed(), readDouble(vehicles, 12));
+    EXPECT_EQ((uint32_t) CarVehicle, readUnsigned(vehicles, 20));
+    EXPECT_EQ(0u, readUnsigned(vehicles, 24));
+
+    // The bus was put in front of the car and the light got a new cycle, the restore undid both
+    EXPECT_EQ(2u, readUnsigned(replies[5].second, 0));
+    EXPECT_DOUBLE_EQ(time, readDouble(replies[7].second, 0));
+    EXPECT_EQ(1u, sim.getStreets()[0]->getVehicles().size());
+    EXPECT_EQ(20, sim.getStreets()[0]->getTrafficLights()[0]->getCycle());
+
+    EXPECT_EQ(StatusUnknownCommand, replies[8].first);
+    EXPECT_EQ(StatusBadRequest, replies[9].first);
+    EXPECT_EQ(StatusOk, replies[10].first);
+    EXPECT_FALSE(server.isStopped());
+}
+
+TEST(SimulationServerTest, RestoreKeepsListeners) {
+    std::ofstream input;
+    input.open("testOutput/serverRestore.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Testbaan</naam><lengte>500</lengte></BAAN>" << std::endl
+          << "    <BAAN><naam>Kruisbaan</naam><lengte>500</lengte></BAAN>" << std::endl
+          << "    <BAAN><naam>Uitrit</naam><lengte>50</lengte></BAAN>" << std::endl
+          << "    <KRUISPUNT><baan positie=\"250\">Testbaan</baan><baan positie=\"250\">Kruisbaan</baan></KRUISPUNT>" << std::endl
+          << "    <VERKEERSLICHT><baan>Testbaan</baan><positie>300</positie><cyclus>60</cyclus></VERKEERSLICHT>" << std::endl;
+    for (unsigned int i = 0; i < 6; i++) {
+        input << "    <VOERTUIG><baan>Testbaan</baan><positie>" << 290 - 9 * i << "</positie><type>auto</type></VOERTUIG>"
+              << std::endl;
+    }
+    input << "    <VOERTUIG><baan>Uitrit</baan><positie>45</positie><type>auto</type></VOERTUIG>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    ASSERT_EQ(Success, sim.parseInputFile("testOutput/serverRestore.xml"));
+    TravelStatistics statistics(10, 10);
+    std::ostringstream alerts;
+    QueueAlertWriter writer(alerts);
+    sim.setTravelStatistics(&statistics);
+    sim.setQueueListener(&writer);
+    SimulationServer server(sim);
+
+    // The spillback and the car leaving the exit are only seen after the restore
+    std::string requests;
+    appendRequest(requests, CommandSnapshot, "");
+    appendRequest(requests, CommandRestore, "");
+    std::string payload;
+    appendUnsigned(payload, 300);
+    appendRequest(requests, CommandStep, payload);
+    appendRequest(requests, CommandClose, "");
+
+    std::vector<std::pair<int, std::string> > replies = serveRequests(server, requests);
+    ASSERT_EQ(4u, replies.size());
+    for (unsigned int i = 0; i < replies.size(); i++) {
+        EXPECT_EQ(StatusOk, replies[i].first);
+    }
+    EXPECT_EQ(1u, statistics.getStatistic(TravelTimeStatistic).getCount());
+    EXPECT_LT(0u, writer.getAlerts());
+}
+
+TEST(SimulationServerTest, Changes) {
+    writeInput();
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    ASSERT_EQ(Success, sim.parseInputFile("testOutput/serverSimulation.xml"));
+    SimulationServer server(sim);
+
+    std::string requests;
+    std::string payload;
+    appendUnsigned(payload, 0);
+    appendDouble(payload, 500);
+    appendUnsigned(payload, CarVehicle);
+    appendUnsigned(payload, 0);
+    appendRequest(requests, CommandInject, payload);
+    payload.clear();
+    appendUnsigned(payload, 0);
+    appendUnsigned(payload, 0);
+    appendUnsigned(payload, 30);
+    appendRequest(requests, CommandSetCycle, payload);
+    // Off the street, a lane that doesn't exist, a cycle of 0 and a traffic light that doesn't exist
+    payload.clear();
+    appendUnsigned(payload, 0);
+    appendDouble(payload, 1500);
+    appendUnsigned(payload, CarVehicle);
+    appendUnsigned(payload, 0);
+    appendRequest(requests, CommandInject, payload);
+    payload.clear();
+    appendUnsigned(payload, 0);
+    appendDouble(payload, 500);
+    appendUnsigned(payload, CarVehicle);
+    appendUnsigned(payload, 1);
+    appendRequest(requests, CommandInject, payload);
+    payload.clear();
+    appendUnsigned(payload, 0);
+    appendUnsigned(payload, 0);
+    appendUnsigned(payload, 0);
+    appendRequest(requests, CommandSetCycle, payload);
+    payload.clear();
+    appendUnsigned(payload, 0);
+    appendUnsigned(payload, 1);
+    appendUnsigned(payload, 30);
+    appendRequest(requests, CommandSetCycle, payload);
+    appendRequest(requests, CommandRestore, "");
+    appendRequest(requests, CommandStep, "");
+    payload.clear();
+    appendDouble(payload, 5);
+    appendRequest(requests, CommandRunUntil, payload);
+    appendRequest(requests, CommandShutdown, "");
+
+    std::vector<std::pair<int, std::string> > replies = serveRequests(server, requests);
+    ASSERT_EQ(10u, replies.size());
+    EXPECT_EQ(StatusOk, replies[0].first);
+    EXPECT_EQ(2u, readUnsigned(replies[0].second, 0));
+    EXPECT_EQ(StatusOk, replies[1].first);
+    for (unsigned int i = 2; i < 8; i++) {
+        EXPECT_EQ(StatusBadRequest, replies[i].first);
+    }
+    EXPECT_EQ(StatusOk, replies[8].first);
+    EXPECT_LE(5, readDouble(replies[8].second, 0));
+    EXPECT_EQ(StatusOk, replies[9].first);
+    EXPECT_TRUE(server.isStopped());
+
+    const std::vector<Vehicle*> &vehicles = sim.getStreets()[0]->getVehicles();
+    ASSERT_EQ(2u, vehicles.size());
+    EXPECT_LT(vehicles[1]->getPosition(), vehicles[0]->getPosition());
+    EXPECT_EQ(30, sim.getStreets()[0]->getTrafficLights()[0]->getCycle());
+}
+
+TEST(SimulationServerTest, RunUntilLimits) {
+    writeInput();
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    ASSERT_EQ(Success, sim.parseInputFile("testOutput/serverSimulation.xml"));
+    SimulationServer server(sim);
+
+    // Times that would never or only after years be reached, and one in the past
+    double times[] = {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN(), 1e30,
+                      -std::numeric_limits<double>::infinity(), 1};
+    std::string requests;
+    for (unsigned int i = 0; i < 5; i++) {
+        std::string payload;
+        appendDouble(payload, times[i]);
+        appendRequest(requests, CommandRunUntil, payload);
+    }
+
+    std::vector<std::pair<int, std::string> > replies = serveRequests(server, requests);
+    ASSERT_EQ(5u, replies.size());
+    EXPECT_EQ(StatusBadRequest, replies[0].first);
+    EXPECT_EQ(StatusBadRequest, replies[1].first);
+    EXPECT_EQ(StatusBadRequest, replies[2].first);
+    EXPECT_EQ(StatusOk, replies[3].first);
+    EXPECT_EQ(0, readDouble(replies[3].second, 0));
+    EXPECT_EQ(StatusOk, replies[4].first);
+    EXPECT_LE(1, readDouble(replies[4].second, 0));
+    EXPECT_GT(1 + gSimulationTime, sim.getTime());
+}
+
+TEST(SimulationServerTest, QueryVehicles) {
+    writeInput();
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    ASSERT_EQ(Success, sim.parseInputFile("testOutput/serverSimulation.xml"));
+    SimulationServer server(sim);
+
+    std::string requests;
+    std::string payload;
+    appendUnsigned(payload, 0);
+    appendRequest(requests, CommandQueryVehicles, payload);
+    payload.clear();
+    appendUnsigned(payload, 1);
+    appendUnsigned(payload, 1);
+    appendRequest(requests, CommandQueryVehicles, payload);
+    // A street that doesn't exist and a count that doesn't match the payload
+    payload.clear();
+    appendUnsigned(payload, 1);
+    appendUnsigned(payload, 2);
+    appendRequest(requests, CommandQueryVehicles, payload);
+    payload.clear();
+    appendUnsigned(payload, 2);
+    appendUnsigned(payload, 0);
+    appendRequest(requests, CommandQueryVehicles, payload);
+
+    std::vector<std::pair<int, std::string> > replies = serveRequests(server, requests);
+    ASSERT_EQ(4u, replies.size());
+    EXPECT_EQ(StatusOk, replies[0].first);
+    const std::string &all = replies[0].second;
+    ASSERT_EQ(4u + 2 * (8 + 8 + 4 + 4 + 4), all.size());
+    EXPECT_EQ(2u, readUnsigned(all, 0));
+    EXPECT_DOUBLE_EQ(100, readDouble(all, 4));
+    EXPECT_DOUBLE_EQ(20, readDouble(all, 12));
+    EXPECT_EQ(0u, readUnsigned(all, 36));
+    EXPECT_EQ(1u, readUnsigned(all, 40));
+    EXPECT_EQ((uint32_t) CarVehicle, readUnsigned(all, 44));
+    EXPECT_EQ((uint32_t) BusVehicle, readUnsigned(all, 48));
+
+    EXPECT_EQ(StatusOk, replies[1].first);
+    ASSERT_EQ(4u + 28u, replies[1].second.size());
+    EXPECT_EQ(1u, readUnsigned(replies[1].second, 0));
+    EXPECT_DOUBLE_EQ(20, readDouble(replies[1].second, 4));
+    EXPECT_EQ(StatusBadRequest, replies[2].first);
+    EXPECT_EQ(StatusBadRequest, replies[3].first);
+}
+
+TEST(SimulationServerTest, Listen) {
+    writeInput();
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    ASSERT_EQ(Success, sim.parseInputFile("testOutput/serverSimulation.xml"));
+    {
+        SimulationServer server(sim);
+        EXPECT_TRUE(server.listenUnix("testOutput/server.sock"));
+        EXPECT_TRUE(server.isListening());
+        EXPECT_EQ(0, access("testOutput/server.sock", F_OK));
+    }
+    // The socket file is removed with the server
+    EXPECT_NE(0, access("testOutput/server.sock", F_OK));
+}
+
+TEST(SimulationServerTest, ContractViolations) {
+    TrafficSimulation sim;
+    SimulationServer server(sim);
+    EXPECT_DEATH(server.run(), "Assertion.*failed");
+
+    Street street("Serverbaan", 100);
+    Vehicle* vehicle = new Vehicle("Serverbaan", 150, CarVehicle);
+    EXPECT_DEATH(street.injectVehicle(vehicle, 0), "Assertion.*failed");
+    delete vehicle;
+
+    TrafficLight light("Serverbaan", 50, 20);
+    EXPECT_DEATH(light.setCycle(0), "Assertion.*failed");
+    light.setCycle(35);
+    EXPECT_EQ(35, light.getCycle());
+
+    SimulationServer illegalCopy = server;
+    EXPECT_DEATH(illegalCopy.isListening(), "Assertion.*failed");
+}
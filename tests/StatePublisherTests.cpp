@@ -0,0 +1,181 @@
+// ===========================================================
+// Name         : StatePublisherTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `StatePublisher` and `StateReader` classes of the TrafficSimulation.
+// ===========================================================
+
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <unistd.h>
+#include <pthread.h>
+#include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
+#include "../ipc/StatePublisher.h"
+#include "../objects/Street.h"
+#include "../objects/Vehicle.h"
+#include "../objects/TrafficLight.h"
+#include "../objects/VehicleType.h"
+#include "../Variables.h"
+
+namespace {
+    // Unique per test process, so parallel test runs don't share a segment
+    std::string segmentName(const std::string &test) {
+        std::ostringstream name;
+        name << "/trafficsim-test-" << test << "-" << getpid();
+        return name.str();
+    }
+
+    void writeInput() {
+        std::ofstream input;
+        input.open("testOutput/sharedState.xml");
+        input << "<?xml version=\"1.0\" ?>" << std::endl
+              << "<SIMULATIE>" << std::endl
+              << "    <BAAN><naam>Gedeelde baan</naam><lengte>2000</lengte></BAAN>" << std::endl
+              << "    <BAAN><naam>Zijstraat</naam><lengte>300</lengte></BAAN>" << std::endl
+              << "    <VERKEERSLICHT><baan>Gedeelde baan</baan><positie>1500</positie><cyclus>5</cyclus></VERKEERSLICHT>" << std::endl
+              << "    <VOERTUIG><baan>Gedeelde baan</baan><positie>100</positie><type>auto</type></VOERTUIG>" << std::endl
+              << "    <VOERTUIG><baan>Gedeelde baan</baan><positie>40</positie><type>bus</type></VOERTUIG>" << std::endl
+              << "    <VOERTUIG><baan>Zijstraat</baan><positie>10</positie><type>auto</type></VOERTUIG>" << std::endl
+              << "    <VOERTUIGGENERATOR><baan>Zijstraat</baan><frequentie>2</frequentie><type>auto</type></VOERTUIGGENERATOR>" << std::endl
+              << "</SIMULATIE>" << std::endl;
+        input.close();
+    }
+
+    struct PublishJob {
+        TrafficSimulation* simulation;
+        StatePublisher* publisher;
+        unsigned int ticks;
+    };
+
+    void* publishTicks(void* argument) {
+        PublishJob* job = (PublishJob*) argument;
+        for (unsigned int i = 0; i < job->ticks; i++) {
+            job->simulation->simulate();
+            job->publisher->publish(*job->simulation);
+        }
+        return NULL;
+    }
+}
+
+TEST(StatePublisherTest, PublishAndRead) {
+    writeInput();
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    ASSERT_EQ(Success, sim.parseInputFile("testOutput/sharedState.xml"));
+
+    std::string name = segmentName("publish");
+    StatePublisher publisher(name, 2);
+    EXPECT_TRUE(publisher.properlyInitialized());
+    EXPECT_FALSE(publisher.isOpen());
+    ASSERT_TRUE(publisher.open(sim));
+    EXPECT_EQ(0u, publisher.getPublished());
+
+    StateReader reader;
+    EXPECT_FALSE(reader.attach("/trafficsim-test-does-not-exist"));
+    ASSERT_TRUE(reader.attach(name));
+    std::vector<std::string> names = reader.getStreetNames();
+    ASSERT_EQ(2u, names.size());
+    EXPECT_EQ("Gedeelde baan", names[0]);
+    EXPECT_EQ("Zijstraat", names[1]);
+    SharedStateFrame frame;
+    EXPECT_FALSE(reader.read(frame));
+
+    sim.simulate();
+    publisher.publish(sim);
+    EXPECT_EQ(1u, publisher.getPublished());
+    ASSERT_TRUE(reader.read(frame));
+    EXPECT_EQ(sim.getTime(), frame.time);
+    EXPECT_EQ(1u, frame.tick);
+    // The generated vehicle waits in the entry queue, only the two front vehicles fit in the frame
+    EXPECT_EQ(3u, frame.vehicles);
+    ASSERT_EQ(2u, frame.positions.size());
+    const std::vector<Vehicle*> &vehicles = sim.getStreets()[0]->getVehicles();
+    EXPECT_EQ(vehicles[0]->getPosition(), frame.positions[0]);
+    EXPECT_EQ(vehicles[1]->getSpeed(), frame.speeds[1]);
+    EXPECT_EQ((unsigned int) CarVehicle, frame.types[0]);
+    EXPECT_EQ((unsigned int) BusVehicle, frame.types[1]);
+    EXPECT_EQ(0u, frame.streets[1]);
+    EXPECT_EQ(0u, frame.lanes[0]);
+    ASSERT_EQ(1u, frame.green.size());
+    EXPECT_EQ(sim.getStreets()[0]->getTrafficLights()[0]->isGreen(), (bool) frame.green[0]);
+
+    // The reader always gets the latest frame
+    for (unsigned int i = 0; i < 3; i++) {
+        sim.simulate();
+        publisher.publish(sim);
+    }
+    ASSERT_TRUE(reader.read(frame));
+    EXPECT_EQ(4u, frame.tick);
+    EXPECT_EQ(sim.getTime(), frame.time);
+}
+
+TEST(StatePublisherTest, ConcurrentReader) {
+    writeInput();
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    ASSERT_EQ(Success, sim.parseInputFile("testOutput/sharedState.xml"));
+    std::string name = segmentName("concurrent");
+    StatePublisher publisher(name, gSharedStateCapacity);
+    ASSERT_TRUE(publisher.open(sim));
+    StateReader reader;
+    ASSERT_TRUE(reader.attach(name));
+
+    PublishJob job = {&sim, &publisher, 2000};
+    pthread_t writer;
+    ASSERT_EQ(0, pthread_create(&writer, NULL, publishTicks, &job));
+    SharedStateFrame frame;
+    unsigned int lastTick = 0;
+    unsigned int reads = 0;
+    while (lastTick < job.ticks) {
+        if (!reader.read(frame)) {
+            continue;
+        }
+        // A torn frame would mix the time of one tick with the vehicles of another
+        EXPECT_LE(lastTick, frame.tick);
+        EXPECT_NEAR(frame.tick * gSimulationTime, frame.time, 1e-6);
+        EXPECT_EQ(frame.vehicles, frame.positions.size());
+        for (unsigned int i = 1; i < frame.positions.size(); i++) {
+            if (frame.streets[i] == frame.streets[i - 1]) {
+                EXPECT_GE(frame.positions[i - 1], frame.positions[i]);
+            }
+        }
+        lastTick = frame.tick;
+        reads++;
+    }
+    pthread_join(writer, NULL);
+    EXPECT_LT(0u, reads);
+}
+
+TEST(StatePublisherTest, Lifetime) {
+    writeInput();
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    ASSERT_EQ(Success, sim.parseInputFile("testOutput/sharedState.xml"));
+    std::string name = segmentName("lifetime");
+    {
+        StatePublisher publisher(name.substr(1), 16);
+        EXPECT_EQ(name, publisher.getName());
+        ASSERT_TRUE(publisher.open(sim));
+    }
+    // The segment is removed with its publisher
+    StateReader reader;
+    EXPECT_FALSE(reader.attach(name));
+}
+
+TEST(StatePublisherTest, ContractViolations) {
+    TrafficSimulation sim;
+    EXPECT_DEATH(StatePublisher("/trafficsim-test-contract", 0), "Assertion.*failed");
+    StatePublisher publisher(segmentName("contract"), 16);
+    EXPECT_DEATH(publisher.publish(sim), "Assertion.*failed");
+    StateReader reader;
+    SharedStateFrame frame;
+    EXPECT_DEATH(reader.read(frame), "Assertion.*failed");
+    EXPECT_DEATH(reader.getStreetNames(), "Assertion.*failed");
+
+    StatePublisher illegalCopy = publisher;
+    EXPECT_DEATH(illegalCopy.isOpen(), "Assertion.*failed");
+    StateReader illegalReader = reader;
+    EXPECT_DEATH(illegalReader.isAttached(), "Assertion.*failed");
+}
@@ -5,12 +5,17 @@
 // Description  : This code tests the `Street` class of the TrafficSimulation.
 // ===========================================================
 
+#include <fstream>
+#include <sstream>
 #include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
 #include "../objects/Street.h"
 #include "../objects/vehicles/Car.h"
+#include "../objects/vehicles/Bus.h"
 #include "../objects/TrafficLight.h"
 #include "../objects/BusStop.h"
 #include "../objects/VehicleGenerator.h"
+#include "../Variables.h"
 
 class StreetDomainTest : public ::testing::Test {
 protected:
@@ -32,7 +37,13 @@ TEST_F(StreetDomainTest, Constructor) {
     EXPECT_TRUE(street->getBusStops().empty());
     EXPECT_TRUE(street->getVehicles().empty());
     EXPECT_TRUE(street->getCrossroads().empty());
+    EXPECT_EQ(0u, street->getIndex());
     EXPECT_TRUE(street->properlyInitialized());
+
+    street->setIndex(3);
+    Street* copy = street->clone();
+    EXPECT_EQ(3u, copy->getIndex());
+    delete copy;
 }
 
 TEST_F(StreetDomainTest, AddTrafficLight) {
@@ -53,6 +64,20 @@ TEST_F(StreetDomainTest, AddVehicle) {
     EXPECT_EQ(car, street->getVehicles()[0]);
 }
 
+TEST_F(StreetDomainTest, RemoveVehicle) {
+    street->addVehicle(new Car("Testbaan", 150));
+    street->addVehicle(new Car("Testbaan", 100));
+    street->addVehicle(new Car("Testbaan", 50));
+
+    // The back vehicle leaves no vehicle behind it to drive on
+    street->removeVehicleAddress(street->getVehicles()[2], 2);
+    ASSERT_EQ(2u, street->getVehicles().size());
+    EXPECT_EQ(1u, street->getExitedVehicles());
+    street->removeVehicleAddress(street->getVehicles()[0], 0);
+    ASSERT_EQ(1u, street->getVehicles().size());
+    EXPECT_EQ(100, street->getVehicles()[0]->getPosition());
+}
+
 TEST_F(StreetDomainTest, AddBusStop) {
     BusStop* busStop = new BusStop("Testbaan", 50, 10);
 
@@ -69,6 +94,231 @@ TEST_F(StreetDomainTest, AddVehicleGenerator) {
     EXPECT_TRUE(street->hasVehicleGenerator());
 }
 
+TEST_F(StreetDomainTest, Mesoscopic) {
+    EXPECT_EQ(MicroscopicLevel, street->getLevel());
+    EXPECT_EQ(0, street->getObservedStart());
+
+    street->setLevel(MesoscopicLevel);
+    EXPECT_EQ(MesoscopicLevel, street->getLevel());
+    EXPECT_EQ(100, street->getObservedStart());
+    street->addTrafficLight(new TrafficLight("Testbaan", 150, 10));
+    EXPECT_EQ(50, street->getObservedStart());
+
+    // The first vehicle enters the observed part right away, the second has to wait for the capacity
+    Car* first = new Car("Testbaan", 49.9);
+    Car* second = new Car("Testbaan", 30);
+    Car* last = new Car("Testbaan", 0);
+    street->addVehicle(first);
+    street->addVehicle(second);
+    street->addVehicle(last);
+    street->driveVehicles();
+    EXPECT_GT(first->getPosition(), 50);
+    EXPECT_NEAR(30 + carMaxSpeed * gSimulationTime, second->getPosition(), 1e-9);
+    EXPECT_NEAR(carMaxSpeed, second->getSpeed(), 1e-9);
+    for (unsigned int i = 0; i < 99; i++) {
+        street->driveVehicles();
+    }
+    EXPECT_EQ(50, second->getPosition());
+    EXPECT_EQ(0, second->getSpeed());
+    EXPECT_LE(last->getPosition(), 50 - second->getLength() - second->getParameters().minFollowDistance);
+    EXPECT_NEAR(100 * gSimulationTime, last->getTravelTime(), 1e-9);
+    for (unsigned int i = 0; i < 100; i++) {
+        street->driveVehicles();
+    }
+    EXPECT_GT(second->getPosition(), 50);
+
+    Street* copy = street->clone();
+    EXPECT_EQ(MesoscopicLevel, copy->getLevel());
+    delete copy;
+}
+
+TEST_F(StreetDomainTest, Lanes) {
+    EXPECT_EQ(1u, street->getLanes());
+    Street highway("Snelweg", 2000);
+    highway.setLanes(2);
+    EXPECT_EQ(2u, highway.getLanes());
+
+    // Two cars next to each other don't hinder each other
+    Car* left = new Car("Snelweg", 50);
+    left->setLane(1);
+    highway.addVehicle(left);
+    highway.addVehicle(new Car("Snelweg", 50));
+    ASSERT_EQ(1u, highway.getLaneVehicles(0).size());
+    ASSERT_EQ(1u, highway.getLaneVehicles(1).size());
+    for (unsigned int i = 0; i < 100; i++) {
+        highway.driveVehicles();
+    }
+    EXPECT_EQ(highway.getVehicles()[0]->getPosition(), highway.getVehicles()[1]->getPosition());
+    EXPECT_NE(highway.getVehicles()[0]->getLane(), highway.getVehicles()[1]->getLane());
+
+    Street* copy = highway.clone();
+    EXPECT_EQ(2u, copy->getLanes());
+    delete copy;
+}
+
+TEST_F(StreetDomainTest, LaneChange) {
+    Street highway("Snelweg", 2000);
+    highway.setLanes(2);
+    Bus* bus = new Bus("Snelweg", 100);
+    Car* car = new Car("Snelweg", 70);
+    highway.addVehicle(bus);
+    highway.addVehicle(car);
+
+    // The car overtakes the slower bus on the left lane
+    bool changedLane = false;
+    for (unsigned int i = 0; i < 3000 && car->getPosition() <= bus->getPosition(); i++) {
+        highway.driveVehicles();
+        changedLane = changedLane || car->getLane() == 1;
+        ASSERT_EQ(2u, highway.getVehicles().size());
+        EXPECT_GE(highway.getVehicles()[0]->getPosition(), highway.getVehicles()[1]->getPosition());
+    }
+    EXPECT_TRUE(changedLane);
+    EXPECT_EQ(0u, bus->getLane());
+    EXPECT_GT(car->getPosition(), bus->getPosition());
+    EXPECT_EQ(car, highway.getVehicles()[0]);
+
+    // Both leave the street at the end
+    for (unsigned int i = 0; i < 20000 && !highway.getVehicles().empty(); i++) {
+        highway.driveVehicles();
+    }
+    EXPECT_TRUE(highway.getVehicles().empty());
+    EXPECT_EQ(2u, highway.getFinishedVehicles());
+}
+
+TEST_F(StreetDomainTest, LanesParser) {
+    std::ofstream input;
+    input.open("testOutput/laneSimulation.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Snelweg</naam><lengte>500</lengte><rijstroken>3</rijstroken></BAAN>" << std::endl
+          << "    <BAAN><naam>Zijweg</naam><lengte>500</lengte><rijstroken>geen</rijstroken></BAAN>" << std::endl
+          << "    <VOERTUIG><baan>Snelweg</baan><positie>10</positie><type>auto</type><rijstrook>3</rijstrook></VOERTUIG>" << std::endl
+          << "    <VOERTUIG><baan>Snelweg</baan><positie>20</positie><type>auto</type></VOERTUIG>" << std::endl
+          << "    <VOERTUIG><baan>Snelweg</baan><positie>30</positie><type>auto</type><rijstrook>0</rijstrook></VOERTUIG>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+
+    TrafficSimulation sim;
+    std::ostringstream errors;
+    EXPECT_EQ(PartialImport, sim.parseInputFile("testOutput/laneSimulation.xml", errors));
+    EXPECT_NE(std::string::npos, errors.str().find("Expected <rijstroken> to be a positive integer"));
+    EXPECT_NE(std::string::npos, errors.str().find("Expected <rijstrook> to be a positive integer"));
+    ASSERT_EQ(1u, sim.getStreets().size());
+    Street* highway = sim.getStreets()[0];
+    EXPECT_EQ(3u, highway->getLanes());
+    ASSERT_EQ(2u, highway->getVehicles().size());
+    EXPECT_EQ(0u, highway->getVehicles()[0]->getLane());
+    EXPECT_EQ(2u, highway->getVehicles()[1]->getLane());
+    sim.clearSimulation();
+
+    input.open("testOutput/laneSimulation.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Snelweg</naam><lengte>500</lengte><rijstroken>2</rijstroken></BAAN>" << std::endl
+          << "    <VOERTUIG><baan>Snelweg</baan><positie>10</positie><type>auto</type><rijstrook>3</rijstrook></VOERTUIG>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+    EXPECT_EQ(ImportAborted, sim.parseInputFile("testOutput/laneSimulation.xml", errors));
+    sim.clearSimulation();
+}
+
+TEST_F(StreetDomainTest, EntryQueue) {
+    // Three cars arrive at once, only the first one fits at the start of the street
+    for (unsigned int i = 0; i < 3; i++) {
+        street->spawnVehicle(new Car("Testbaan", 0), 0);
+    }
+    EXPECT_EQ(3u, street->getGeneratedVehicles());
+    EXPECT_EQ(1u, street->getVehicles().size());
+    EXPECT_EQ(2u, street->getEntryQueue().size());
+    EXPECT_EQ(2u, street->getMaxEntryQueue());
+
+    Street* copy = street->clone();
+    EXPECT_EQ(2u, copy->getEntryQueue().size());
+    delete copy;
+
+    // The others enter one by one when there is room and never overlap
+    for (unsigned int i = 0; i < 3000 && !street->getEntryQueue().empty(); i++) {
+        street->driveVehicles();
+        const std::vector<Vehicle*> &vehicles = street->getVehicles();
+        for (unsigned int j = 1; j < vehicles.size(); j++) {
+            EXPECT_GE(vehicles[j-1]->getPosition() - vehicles[j-1]->getLength(), vehicles[j]->getPosition());
+        }
+    }
+    EXPECT_TRUE(street->getEntryQueue().empty());
+    EXPECT_EQ(3u, street->getVehicles().size());
+    EXPECT_EQ(2u, street->getMaxEntryQueue());
+    // The second car waited less than the third
+    EXPECT_GT(street->getEntryQueueTime(), 0);
+    EXPECT_LT(street->getVehicles()[2]->getPosition(), street->getVehicles()[1]->getPosition());
+
+    std::ofstream input;
+    input.open("testOutput/entrySimulation.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Instroombaan</naam><lengte>500</lengte></BAAN>" << std::endl
+          << "    <BAAN><naam>Zijbaan</naam><lengte>500</lengte></BAAN>" << std::endl
+          << "    <VOERTUIGGENERATOR><baan>Instroombaan</baan><frequentie>1</frequentie><type>auto</type></VOERTUIGGENERATOR>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    EXPECT_EQ(Success, sim.parseInputFile("testOutput/entrySimulation.xml"));
+    while (sim.getTime() < 30) {
+        sim.simulate();
+    }
+    // A car that starts from standstill hasn't made room for the next one after a second
+    Street* entry = sim.getStreets()[0];
+    EXPECT_LT(0u, entry->getEntryQueue().size());
+    EXPECT_EQ(entry->getGeneratedVehicles(), entry->getVehicles().size() + entry->getEntryQueue().size());
+    std::ostringstream output;
+    sim.writeEntryQueues(output);
+    std::string table = output.str();
+    EXPECT_EQ(0u, table.find("street,generated,waiting,max_queue_length,mean_queue_length,mean_wait\nInstroombaan,"));
+    EXPECT_EQ(std::string::npos, table.find("Zijbaan"));
+}
+
+TEST_F(StreetDomainTest, CopyVehicles) {
+    street->setLanes(2);
+    Car* front = new Car("Testbaan", 150);
+    Bus* back = new Bus("Testbaan", 40);
+    back->setLane(1);
+    street->addVehicle(back);
+    street->addVehicle(front);
+    street->sortVehicles();
+
+    double positions[3] = {-1, -1, -1};
+    unsigned int streets[3] = {9, 9, 9};
+    unsigned int lanes[3] = {9, 9, 9};
+    VehicleBuffers buffers = {positions, NULL, streets, NULL, lanes, 3};
+    EXPECT_EQ(2u, street->copyVehicles(buffers, 1, 4));
+    EXPECT_EQ(-1, positions[0]);
+    EXPECT_EQ(150, positions[1]);
+    EXPECT_EQ(40, positions[2]);
+    EXPECT_EQ(4u, streets[1]);
+    EXPECT_EQ(1u, lanes[2]);
+
+    // Only the vehicles that fit are written
+    EXPECT_EQ(2u, street->copyVehicles(buffers, 2, 5));
+    EXPECT_EQ(150, positions[2]);
+    EXPECT_EQ(2u, street->copyVehicles(buffers, 3, 5));
+    EXPECT_EQ(9u, streets[0]);
+    EXPECT_DEATH(front->copyState(buffers, 3), "Assertion.*failed");
+}
+
+TEST_F(StreetDomainTest, Idle) {
+    EXPECT_TRUE(street->isIdle());
+    // A bus stop doesn't do anything without vehicles
+    street->addBusStop(new BusStop("Testbaan", 100, 5));
+    EXPECT_TRUE(street->isIdle());
+    Car* car = new Car("Testbaan", 20);
+    street->addVehicle(car);
+    EXPECT_FALSE(street->isIdle());
+
+    Street lighted("Verlichte baan", 200);
+    lighted.addTrafficLight(new TrafficLight("Verlichte baan", 100, 10));
+    EXPECT_FALSE(lighted.isIdle());
+}
+
 TEST_F(StreetDomainTest, ContractViolations) {
     // Test properlyInitialized condition
     Street illegalCopy = *street;
@@ -79,7 +329,23 @@ TEST_F(StreetDomainTest, ContractViolations) {
     EXPECT_DEATH(illegalCopy.getBusStops(), "Assertion.*failed");
     EXPECT_DEATH(illegalCopy.getVehicles(), "Assertion.*failed");
     EXPECT_DEATH(illegalCopy.getCrossroads(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.getIndex(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.setIndex(1), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.isIdle(), "Assertion.*failed");
     EXPECT_DEATH(illegalCopy.driveVehicles(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.setLevel(MesoscopicLevel), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.getLevel(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.getObservedStart(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.setLanes(2), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.getLanes(), "Assertion.*failed");
+
+    // Test lane conditions
+    EXPECT_DEATH(street->setLanes(0), "Assertion.*failed");
+    EXPECT_DEATH(street->getLaneVehicles(1), "Assertion.*failed");
+    Car* leftCar = new Car("Testbaan", 10);
+    leftCar->setLane(1);
+    EXPECT_DEATH(street->addVehicle(leftCar), "Assertion.*failed");
+    delete leftCar;
 
     // Test addTrafficLight() conditions
     TrafficLight* trafficLight1 = new TrafficLight("Testbaan", 300, 10);
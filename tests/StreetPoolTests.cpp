@@ -0,0 +1,118 @@
+// ===========================================================
+// Name         : StreetPoolTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `StreetPool` class and the simulation of streets on several threads.
+// ===========================================================
+
+#include <fstream>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
+#include "../StreetPool.h"
+#include "../objects/Street.h"
+#include "../objects/Vehicle.h"
+
+namespace {
+    // A busy arterial with side streets that are mostly empty, two of them crossing
+    void writeInput() {
+        std::ofstream input;
+        input.open("testOutput/streetPool.xml");
+        input << "<?xml version=\"1.0\" ?>" << std::endl
+              << "<SIMULATIE>" << std::endl
+              << "    <BAAN><naam>Hoofdweg</naam><lengte>3000</lengte></BAAN>" << std::endl
+              << "    <VERKEERSLICHT><baan>Hoofdweg</baan><positie>1800</positie><cyclus>25</cyclus></VERKEERSLICHT>" << std::endl
+              << "    <VOERTUIGGENERATOR><baan>Hoofdweg</baan><frequentie>2</frequentie><type>auto</type></VOERTUIGGENERATOR>" << std::endl
+              << "    <BAAN><naam>Kruisweg</naam><lengte>600</lengte></BAAN>" << std::endl
+              << "    <BAAN><naam>Dwarsweg</naam><lengte>600</lengte></BAAN>" << std::endl
+              << "    <KRUISPUNT><baan positie=\"200\">Kruisweg</baan><baan positie=\"300\">Dwarsweg</baan></KRUISPUNT>" << std::endl
+              << "    <VOERTUIGGENERATOR><baan>Kruisweg</baan><frequentie>6</frequentie><type>auto</type></VOERTUIGGENERATOR>" << std::endl;
+        for (unsigned int i = 0; i < 20; i++) {
+            input << "    <BAAN><naam>Zijstraat " << i << "</naam><lengte>" << 200 + 10 * i << "</lengte></BAAN>" << std::endl;
+            if (i % 5 == 0) {
+                input << "    <VOERTUIG><baan>Zijstraat " << i << "</baan><positie>20</positie><type>bus</type></VOERTUIG>" << std::endl;
+            }
+        }
+        input << "    <BUSHALTE><baan>Zijstraat 5</baan><positie>150</positie><wachttijd>10</wachttijd></BUSHALTE>" << std::endl
+              << "</SIMULATIE>" << std::endl;
+        input.close();
+    }
+
+    void load(TrafficSimulation &sim) {
+        sim.setLogStream(NULL);
+        ASSERT_EQ(Success, sim.parseInputFile("testOutput/streetPool.xml"));
+        sim.setSeed(5);
+    }
+}
+
+TEST(StreetPoolTest, SameAsInTurn) {
+    writeInput();
+    TrafficSimulation inTurn;
+    load(inTurn);
+    TrafficSimulation pooled;
+    load(pooled);
+    pooled.setThreads(4);
+    EXPECT_LT(1u, pooled.getThreads());
+    EXPECT_GE(4u, pooled.getThreads());
+
+    for (unsigned int i = 0; i < 3000; i++) {
+        inTurn.simulate();
+        pooled.simulate();
+    }
+    EXPECT_LT(10u, inTurn.getStreets()[0]->getVehicles().size());
+    EXPECT_FALSE(inTurn.getStreets()[2]->getVehicles().empty());
+    std::ostringstream expected;
+    std::ostringstream output;
+    inTurn.writeOn(expected);
+    pooled.writeOn(output);
+    EXPECT_EQ(expected.str(), output.str());
+
+    // Back to a single thread
+    pooled.setThreads(1);
+    EXPECT_EQ(1u, pooled.getThreads());
+    pooled.simulate();
+    inTurn.simulate();
+    EXPECT_EQ(inTurn.getStreets()[0]->getVehicles()[0]->getPosition(), pooled.getStreets()[0]->getVehicles()[0]->getPosition());
+}
+
+TEST(StreetPoolTest, Run) {
+    writeInput();
+    TrafficSimulation sim;
+    load(sim);
+    TrafficSimulation reference;
+    load(reference);
+
+    // The side streets don't cross, every street is simulated exactly once per run
+    std::vector<Street*> streets(sim.getStreets().begin() + 3, sim.getStreets().end());
+    StreetPool pool(3);
+    ASSERT_TRUE(pool.properlyInitialized());
+    EXPECT_GE(3u, pool.getThreads());
+    for (unsigned int tick = 0; tick < 500; tick++) {
+        double time = tick * 0.0166;
+        pool.run(streets, time);
+        for (unsigned int i = 3; i < reference.getStreets().size(); i++) {
+            reference.getStreets()[i]->driveVehicles();
+            reference.getStreets()[i]->simTrafficLights(time);
+            reference.getStreets()[i]->simBusStops(time);
+        }
+    }
+    for (unsigned int i = 3; i < sim.getStreets().size(); i++) {
+        const std::vector<Vehicle*> &vehicles = sim.getStreets()[i]->getVehicles();
+        ASSERT_EQ(reference.getStreets()[i]->getVehicles().size(), vehicles.size());
+        for (unsigned int j = 0; j < vehicles.size(); j++) {
+            EXPECT_EQ(reference.getStreets()[i]->getVehicles()[j]->getPosition(), vehicles[j]->getPosition());
+        }
+    }
+
+    // Nothing to do returns straight away
+    pool.run(std::vector<Street*>(), 0);
+    StreetPool single(1);
+    EXPECT_EQ(1u, single.getThreads());
+    single.run(streets, 500 * 0.0166);
+}
+
+TEST(StreetPoolTest, ContractViolations) {
+    EXPECT_DEATH(StreetPool(0), "Assertion.*failed");
+    TrafficSimulation sim;
+    EXPECT_DEATH(sim.setThreads(0), "Assertion.*failed");
+}
@@ -0,0 +1,53 @@
+// ===========================================================
+// Name         : StringInternerTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `StringInterner` class of the TrafficSimulation.
+// ===========================================================
+
+#include "gtest/gtest.h"
+#include "../StringInterner.h"
+#include "../objects/Street.h"
+#include "../objects/vehicles/Car.h"
+
+class StringInternerTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {}
+
+    virtual void TearDown() {}
+
+    StringInterner interner;
+};
+
+TEST_F(StringInternerTest, Constructor) {
+    EXPECT_TRUE(interner.properlyInitialized());
+    EXPECT_EQ(0u, interner.size());
+}
+
+TEST_F(StringInternerTest, HappyDay) {
+    unsigned int id1 = interner.intern("Middelheimlaan");
+    unsigned int id2 = interner.intern("Turnhoutsebaan");
+
+    EXPECT_NE(id1, id2);
+    EXPECT_EQ(id1, interner.intern("Middelheimlaan"));
+    EXPECT_EQ("Middelheimlaan", interner.getString(id1));
+    EXPECT_EQ("Turnhoutsebaan", interner.getString(id2));
+    EXPECT_EQ(2u, interner.size());
+}
+
+TEST_F(StringInternerTest, StreetIds) {
+    Street street("Testbaan", 200);
+    Car car("Testbaan", 10);
+    Car turnedCar(street.getId(), 20);
+
+    EXPECT_EQ(street.getId(), car.getStreetId());
+    EXPECT_EQ("Testbaan", turnedCar.getStreet());
+}
+
+TEST_F(StringInternerTest, ContractViolations) {
+    StringInterner illegalCopy = interner;
+
+    EXPECT_DEATH(illegalCopy.intern("Testbaan"), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.size(), "Assertion.*failed");
+    EXPECT_DEATH(interner.getString(interner.size()), "Assertion.*failed");
+}
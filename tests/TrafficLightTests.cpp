@@ -5,8 +5,13 @@
 // Description  : This code tests the `TrafficLight` class of the TrafficSimulation.
 // ===========================================================
 
+#include <sstream>
 #include "gtest/gtest.h"
+#include "../Variables.h"
 #include "../objects/TrafficLight.h"
+#include "../objects/Street.h"
+#include "../objects/vehicles/Car.h"
+#include "../statistics/QueueListener.h"
 
 class TrafficLightDomainTest : public ::testing::Test {
 protected:
@@ -40,6 +45,99 @@ TEST_F(TrafficLightDomainTest, ChangeLastUpdatedTime) {
     EXPECT_EQ(15.00, light->getLastUpdateTime());
 }
 
+TEST_F(TrafficLightDomainTest, Queue) {
+    EXPECT_EQ(0u, light->getQueueLength());
+    EXPECT_TRUE(light->getQueueSamples().empty());
+
+    light->updateQueue(3, 20, 1);
+    light->updateQueue(5, 32, 2);
+    light->updateQueue(2, 12, gQueueSampleInterval * 2 + 1);
+    EXPECT_EQ(2u, light->getQueueLength());
+    EXPECT_EQ(12, light->getQueueDistance());
+    EXPECT_EQ(5u, light->getMaxQueueLength());
+    EXPECT_EQ(32, light->getMaxQueueDistance());
+    ASSERT_EQ(3u, light->getQueueSamples().size());
+    EXPECT_EQ(5u, light->getQueueSamples()[0]);
+    EXPECT_EQ(0u, light->getQueueSamples()[1]);
+    EXPECT_EQ(2u, light->getQueueSamples()[2]);
+
+    TrafficLight* copy = light->clone();
+    EXPECT_EQ(light->getQueueSamples(), copy->getQueueSamples());
+    delete copy;
+}
+
+TEST_F(TrafficLightDomainTest, Spillback) {
+    Street street("Testbaan", 500);
+    Street crossingStreet("Kruisbaan", 500);
+    street.addCrossroad(&crossingStreet, 250);
+    street.addTrafficLight(light->clone());
+    std::ostringstream output;
+    QueueAlertWriter alerts(output);
+    street.setQueueListener(&alerts);
+
+    // A row of standing cars, the last one is too far behind to belong to the queue
+    double positions[] = {199, 190, 181, 172, 120};
+    for (unsigned int i = 0; i < 5; i++) {
+        street.addVehicle(new Car("Testbaan", positions[i]));
+    }
+    double time = 1;
+    street.simTrafficLights(time);
+    const TrafficLight* trafficLight = street.getTrafficLights()[0];
+    EXPECT_EQ(4u, trafficLight->getQueueLength());
+    EXPECT_NEAR(200 - 172 + street.getVehicles()[3]->getLength(), trafficLight->getQueueDistance(), 1e-9);
+    EXPECT_FALSE(trafficLight->hasSpillback());
+    EXPECT_EQ(0u, alerts.getAlerts());
+
+    // A queue before a light at 300 grows past the crossroad
+    Street spillingStreet("Testbaan", 500);
+    spillingStreet.addCrossroad(&crossingStreet, 250);
+    TrafficLight* secondLight = new TrafficLight("Testbaan", 300, 10);
+    spillingStreet.addTrafficLight(secondLight);
+    spillingStreet.setQueueListener(&alerts);
+    for (unsigned int i = 0; i < 7; i++) {
+        spillingStreet.addVehicle(new Car("Testbaan", 299 - 9 * i));
+    }
+    spillingStreet.simTrafficLights(time);
+    EXPECT_EQ(7u, secondLight->getQueueLength());
+    EXPECT_TRUE(secondLight->hasSpillback());
+    EXPECT_EQ(1u, alerts.getAlerts());
+    EXPECT_NE(std::string::npos, output.str().find("het kruispunt op 250 m"));
+
+    // It is reported only once while the queue stays past the crossroad
+    time += gSimulationTime;
+    spillingStreet.simTrafficLights(time);
+    EXPECT_EQ(1u, alerts.getAlerts());
+}
+
+TEST_F(TrafficLightDomainTest, LaneQueues) {
+    Street street("Testbaan", 500);
+    Street crossingStreet("Kruisbaan", 500);
+    street.setLanes(2);
+    street.addCrossroad(&crossingStreet, 160);
+    street.addTrafficLight(light->clone());
+    std::ostringstream output;
+    QueueAlertWriter alerts(output);
+    street.setQueueListener(&alerts);
+
+    // The right lane has one queued car, the car far behind it doesn't belong to the queue although it is close to
+    // the end of the queue on the left lane
+    double positions[] = {199, 190, 181, 172, 163, 154, 150};
+    unsigned int lanes[] = {0, 1, 1, 1, 1, 1, 0};
+    for (unsigned int i = 0; i < 7; i++) {
+        Car* car = new Car("Testbaan", positions[i]);
+        car->setLane(lanes[i]);
+        street.addVehicle(car);
+    }
+    double time = 1;
+    street.simTrafficLights(time);
+    const TrafficLight* trafficLight = street.getTrafficLights()[0];
+    EXPECT_EQ(6u, trafficLight->getQueueLength());
+    EXPECT_NEAR(200 - 154 + street.getVehicles()[5]->getLength(), trafficLight->getQueueDistance(), 1e-9);
+    // The queue on the left lane reaches the crossroad
+    EXPECT_TRUE(trafficLight->hasSpillback());
+    EXPECT_EQ(1u, alerts.getAlerts());
+}
+
 TEST_F(TrafficLightDomainTest, ContractViolations) {
     // Test properlyInitialized condition
     TrafficLight illegalCopy = *light;
@@ -50,6 +148,12 @@ TEST_F(TrafficLightDomainTest, ContractViolations) {
     EXPECT_DEATH(illegalCopy.isGreen(), "Assertion.*failed");
     EXPECT_DEATH(illegalCopy.getLastUpdateTime(), "Assertion.*failed");
     EXPECT_DEATH(illegalCopy.changeLight(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.updateQueue(1, 10, 0), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.getQueueSamples(), "Assertion.*failed");
+
+    // Test updateQueue() conditions
+    EXPECT_DEATH(light->updateQueue(1, -1, 0), "Assertion.*failed");
+    EXPECT_DEATH(light->updateQueue(1, 10, -1), "Assertion.*failed");
 
     // Test setLastUpdateTime() conditions
     EXPECT_DEATH(light->setLastUpdateTime(-1), "Assertion.*failed");
@@ -0,0 +1,142 @@
+// ===========================================================
+// Name         : TrafficSimAPITests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the C API of libtrafficsim.
+// ===========================================================
+
+#include <fstream>
+#include <string>
+#include "gtest/gtest.h"
+#include "../api/trafficsim.h"
+#include "../objects/VehicleType.h"
+
+namespace {
+    void writeInput() {
+        std::ofstream input;
+        input.open("testOutput/apiSimulation.xml");
+        input << "<?xml version=\"1.0\" ?>" << std::endl
+              << "<SIMULATIE>" << std::endl
+              << "    <BAAN><naam>Bibliotheekbaan</naam><lengte>1000</lengte></BAAN>" << std::endl
+              << "    <BAAN><naam>Zijbaan</naam><lengte>400</lengte></BAAN>" << std::endl
+              << "    <VOERTUIG><baan>Bibliotheekbaan</baan><positie>50</positie><type>auto</type></VOERTUIG>" << std::endl
+              << "    <VOERTUIG><baan>Bibliotheekbaan</baan><positie>200</positie><type>bus</type></VOERTUIG>" << std::endl
+              << "    <VOERTUIG><baan>Zijbaan</baan><positie>10</positie><type>auto</type></VOERTUIG>" << std::endl
+              << "</SIMULATIE>" << std::endl;
+        input.close();
+    }
+}
+
+TEST(TrafficSimAPITest, Simulation) {
+    writeInput();
+    EXPECT_EQ((unsigned int) TS_API_VERSION, ts_api_version());
+    ts_simulation* simulation = ts_create();
+    ASSERT_TRUE(simulation != NULL);
+    EXPECT_EQ(0u, ts_street_count(simulation));
+
+    EXPECT_EQ(TS_OK, ts_load(simulation, "testOutput/apiSimulation.xml"));
+    EXPECT_EQ(std::string(""), ts_last_error(simulation));
+    EXPECT_EQ(TS_OK, ts_set_seed(simulation, 7));
+    ASSERT_EQ(2u, ts_street_count(simulation));
+    EXPECT_EQ(1000, ts_street_length(simulation, 0));
+
+    char name[8];
+    EXPECT_EQ(15u, ts_street_name(simulation, 0, name, sizeof(name)));
+    EXPECT_EQ(std::string("Bibliot"), name);
+    char fullName[32];
+    EXPECT_EQ(7u, ts_street_name(simulation, 1, fullName, sizeof(fullName)));
+    EXPECT_EQ(std::string("Zijbaan"), fullName);
+
+    EXPECT_EQ(TS_OK, ts_step(simulation, 60));
+    EXPECT_EQ(60u, ts_tick(simulation));
+    EXPECT_LT(0, ts_time(simulation));
+    ASSERT_EQ(2u, ts_vehicle_count(simulation, 0));
+
+    double positions[2];
+    double speeds[2];
+    unsigned int types[2];
+    EXPECT_EQ(2u, ts_street_vehicles(simulation, 0, positions, speeds, types, 2));
+    EXPECT_GT(positions[0], positions[1]);
+    EXPECT_LT(200, positions[0]);
+    EXPECT_LT(0, speeds[1]);
+    EXPECT_EQ((unsigned int) BusVehicle, types[0]);
+    EXPECT_EQ((unsigned int) CarVehicle, types[1]);
+
+    // Arrays that are too small only get the front vehicles, NULL arrays are skipped
+    double front = 0;
+    EXPECT_EQ(2u, ts_street_vehicles(simulation, 0, &front, NULL, NULL, 1));
+    EXPECT_EQ(positions[0], front);
+
+    // Loading again starts over
+    EXPECT_EQ(TS_OK, ts_load(simulation, "testOutput/apiSimulation.xml"));
+    EXPECT_EQ(0u, ts_tick(simulation));
+    EXPECT_EQ(2u, ts_street_count(simulation));
+    ts_destroy(simulation);
+}
+
+TEST(TrafficSimAPITest, BulkQuery) {
+    writeInput();
+    ts_simulation* simulation = ts_create();
+    ASSERT_TRUE(simulation != NULL);
+    ASSERT_EQ(TS_OK, ts_load(simulation, "testOutput/apiSimulation.xml"));
+    ts_step(simulation, 10);
+
+    // A capacity of 0 only counts the vehicles
+    EXPECT_EQ(3u, ts_vehicles(simulation, NULL, 0, NULL, NULL, NULL, NULL, NULL, 0));
+    double positions[3];
+    double speeds[3];
+    unsigned int streets[3];
+    unsigned int types[3];
+    unsigned int lanes[3];
+    EXPECT_EQ(3u, ts_vehicles(simulation, NULL, 0, positions, speeds, streets, types, lanes, 3));
+    unsigned int expectedStreets[] = {0, 0, 1};
+    unsigned int expectedTypes[] = {BusVehicle, CarVehicle, CarVehicle};
+    for (unsigned int i = 0; i < 3; i++) {
+        EXPECT_EQ(expectedStreets[i], streets[i]);
+        EXPECT_EQ(expectedTypes[i], types[i]);
+        EXPECT_EQ(0u, lanes[i]);
+        EXPECT_LT(0, speeds[i]);
+    }
+    EXPECT_GT(positions[0], positions[1]);
+    EXPECT_GT(positions[1], positions[2]);
+
+    // The streets come in the order of the query
+    unsigned int query[] = {1, 0};
+    double subset[2];
+    unsigned int subsetStreets[2];
+    EXPECT_EQ(3u, ts_vehicles(simulation, query, 2, subset, NULL, subsetStreets, NULL, NULL, 2));
+    EXPECT_EQ(positions[2], subset[0]);
+    EXPECT_EQ(positions[0], subset[1]);
+    EXPECT_EQ(1u, subsetStreets[0]);
+    EXPECT_EQ(0u, subsetStreets[1]);
+    EXPECT_EQ(1u, ts_vehicles(simulation, query, 1, NULL, NULL, NULL, NULL, NULL, 0));
+
+    unsigned int missing[] = {0, 2};
+    EXPECT_EQ(0u, ts_vehicles(simulation, missing, 2, NULL, NULL, NULL, NULL, NULL, 0));
+    ts_destroy(simulation);
+}
+
+TEST(TrafficSimAPITest, InvalidArguments) {
+    ts_simulation* simulation = ts_create();
+    ASSERT_TRUE(simulation != NULL);
+    EXPECT_EQ(TS_IMPORT_ABORTED, ts_load(simulation, "testOutput/doesNotExist.xml"));
+    EXPECT_NE(std::string(""), ts_last_error(simulation));
+    EXPECT_EQ(0u, ts_street_count(simulation));
+
+    EXPECT_EQ(TS_INVALID_ARGUMENT, ts_load(simulation, NULL));
+    EXPECT_EQ(0u, ts_street_name(simulation, 3, NULL, 0));
+    EXPECT_EQ(-1, ts_street_length(simulation, 3));
+    EXPECT_EQ(0u, ts_vehicle_count(simulation, 3));
+    EXPECT_EQ(0u, ts_street_vehicles(simulation, 3, NULL, NULL, NULL, 0));
+    ts_destroy(simulation);
+
+    EXPECT_EQ(TS_INVALID_ARGUMENT, ts_load(NULL, "testOutput/apiSimulation.xml"));
+    EXPECT_EQ(TS_INVALID_ARGUMENT, ts_step(NULL, 1));
+    EXPECT_EQ(TS_INVALID_ARGUMENT, ts_set_seed(NULL, 1));
+    EXPECT_EQ(-1, ts_time(NULL));
+    EXPECT_EQ(0u, ts_tick(NULL));
+    EXPECT_EQ(0u, ts_street_count(NULL));
+    EXPECT_EQ(0u, ts_vehicles(NULL, NULL, 0, NULL, NULL, NULL, NULL, NULL, 0));
+    EXPECT_EQ(std::string(""), ts_last_error(NULL));
+    ts_destroy(NULL);
+}
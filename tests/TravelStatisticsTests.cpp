@@ -0,0 +1,113 @@
+// ===========================================================
+// Name         : TravelStatisticsTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `TravelStatistics` class of the TrafficSimulation.
+// ===========================================================
+
+#include <sstream>
+#include "gtest/gtest.h"
+#include "../Variables.h"
+#include "../objects/Street.h"
+#include "../objects/vehicles/Car.h"
+#include "../statistics/TravelStatistics.h"
+
+TEST(TravelStatisticsTest, RunningStatistic) {
+    RunningStatistic statistic;
+    EXPECT_EQ(0u, statistic.getCount());
+    EXPECT_EQ(0, statistic.getMean());
+    EXPECT_EQ(0, statistic.getVariance());
+
+    double values[] = {2, 4, 4, 4, 5, 5, 7, 9};
+    for (unsigned int i = 0; i < 8; i++) {
+        statistic.add(values[i]);
+    }
+    EXPECT_EQ(8u, statistic.getCount());
+    EXPECT_NEAR(5, statistic.getMean(), 1e-9);
+    EXPECT_NEAR(32.0 / 7, statistic.getVariance(), 1e-9);
+    EXPECT_EQ(2, statistic.getMinimum());
+    EXPECT_EQ(9, statistic.getMaximum());
+}
+
+TEST(TravelStatisticsTest, Histogram) {
+    Histogram histogram(10, 3);
+    histogram.add(0);
+    histogram.add(9.9);
+    histogram.add(10);
+    histogram.add(25);
+    histogram.add(1000);
+    ASSERT_EQ(3u, histogram.getBins().size());
+    EXPECT_EQ(2u, histogram.getBins()[0]);
+    EXPECT_EQ(1u, histogram.getBins()[1]);
+    EXPECT_EQ(2u, histogram.getBins()[2]);
+}
+
+TEST(TravelStatisticsTest, HappyDay) {
+    TravelStatistics statistics(10, 60);
+    EXPECT_TRUE(statistics.properlyInitialized());
+
+    Street street("Testbaan", 100);
+    street.setTravelStatistics(&statistics);
+    street.addVehicle(new Car("Testbaan", 50));
+    street.addVehicle(new Car("Testbaan", 20));
+    street.getVehicles()[1]->setSpawnTime(3);
+    for (unsigned int i = 0; i < 2000 && !street.getVehicles().empty(); i++) {
+        street.driveVehicles();
+    }
+    ASSERT_TRUE(street.getVehicles().empty());
+
+    const RunningStatistic &travelTimes = statistics.getStatistic(TravelTimeStatistic);
+    const RunningStatistic &distances = statistics.getStatistic(DistanceStatistic);
+    const RunningStatistic &delays = statistics.getStatistic(DelayStatistic);
+    EXPECT_EQ(2u, travelTimes.getCount());
+    EXPECT_GT(travelTimes.getMaximum(), travelTimes.getMinimum());
+    EXPECT_GT(distances.getMinimum(), 50);
+    EXPECT_LT(distances.getMaximum(), 100);
+    // Both cars start standing still, so they are always delayed
+    EXPECT_GT(delays.getMinimum(), 0);
+    EXPECT_LT(delays.getMaximum(), travelTimes.getMaximum());
+    EXPECT_GT(statistics.getStatistic(StoppedTimeStatistic).getMinimum(), 0);
+    EXPECT_EQ(0, statistics.getStatistic(BrakingTimeStatistic).getMaximum());
+
+    unsigned int counted = 0;
+    for (unsigned int i = 0; i < statistics.getTravelTimes().getBins().size(); i++) {
+        counted += statistics.getTravelTimes().getBins()[i];
+    }
+    EXPECT_EQ(2u, counted);
+
+    std::ostringstream output;
+    statistics.writeOn(output);
+    EXPECT_EQ(0u, output.str().find("Voertuigen die het netwerk verlieten: 2"));
+    EXPECT_NE(std::string::npos, output.str().find("Eerste vertrek: 0"));
+}
+
+TEST(TravelStatisticsTest, Journey) {
+    Car first("Testbaan", 10);
+    first.setId(1, 4);
+    first.setSpawnTime(2);
+    for (unsigned int i = 0; i < 100; i++) {
+        first.drive(NULL);
+    }
+    Car second("Anderebaan", 0);
+    second.continueJourney(first);
+    EXPECT_EQ(1u, second.getOrigin());
+    EXPECT_EQ(4u, second.getSerial());
+    EXPECT_EQ(2, second.getSpawnTime());
+    EXPECT_EQ(first.getTravelTime(), second.getTravelTime());
+    EXPECT_EQ(first.getDistance(), second.getDistance());
+    EXPECT_NEAR(first.getPosition() - 10, first.getDistance(), 1e-9);
+}
+
+TEST(TravelStatisticsTest, ContractViolations) {
+    EXPECT_DEATH(TravelStatistics(0, 10), "Assertion.*failed");
+    EXPECT_DEATH(TravelStatistics(10, 0), "Assertion.*failed");
+
+    Car car("Testbaan", 10);
+    EXPECT_DEATH(car.setSpawnTime(-1), "Assertion.*failed");
+
+    TravelStatistics statistics(10, 60);
+    TravelStatistics illegalCopy = statistics;
+    EXPECT_DEATH(illegalCopy.record(car), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.getStatistic(TravelTimeStatistic), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.writeOn(std::cout), "Assertion.*failed");
+}
@@ -5,7 +5,12 @@
 // Description  : This code tests the `VehicleGenerator` class of the TrafficSimulation.
 // ===========================================================
 
+#include <fstream>
+#include <sstream>
+#include <cmath>
 #include "gtest/gtest.h"
+#include "../TrafficSimulation.h"
+#include "../objects/Street.h"
 #include "../objects/VehicleGenerator.h"
 
 class VehicleGeneratorDomainTest : public ::testing::Test {
@@ -34,6 +39,111 @@ TEST_F(VehicleGeneratorDomainTest, GeneratorTime) {
     EXPECT_EQ(10, generator->getTimeSinceLastSpawn());
 }
 
+TEST_F(VehicleGeneratorDomainTest, ArrivalProcesses) {
+    EXPECT_EQ(DeterministicArrivals, generator->getArrivalProcess());
+    EXPECT_EQ(200, generator->drawHeadway(0.1));
+    EXPECT_EQ(200, generator->drawHeadway(0.9));
+
+    generator->setArrivalProcess(PoissonArrivals);
+    EXPECT_EQ(0, generator->drawHeadway(0));
+    EXPECT_NEAR(200 * log(2.0), generator->drawHeadway(0.5), 1e-9);
+    EXPECT_NEAR(200 * log(4.0), generator->drawHeadway(0.75), 1e-9);
+
+    // A quarter of the headways between 2 and 4 s, the rest between 4 and 10 s
+    generator->setArrivalProcess(EmpiricalArrivals);
+    generator->addHeadwayBin(2, 4, 1);
+    generator->addHeadwayBin(4, 10, 3);
+    EXPECT_EQ(2u, generator->getHeadwayBins().size());
+    EXPECT_NEAR(2, generator->drawHeadway(0), 1e-9);
+    EXPECT_NEAR(3, generator->drawHeadway(0.125), 1e-9);
+    EXPECT_NEAR(4, generator->drawHeadway(0.25), 1e-9);
+    EXPECT_NEAR(7, generator->drawHeadway(0.625), 1e-9);
+    EXPECT_GT(10, generator->drawHeadway(0.999));
+}
+
+TEST_F(VehicleGeneratorDomainTest, PoissonSimulation) {
+    std::ofstream input;
+    input.open("testOutput/arrivalSimulation.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Aankomstbaan</naam><lengte>10000</lengte></BAAN>" << std::endl
+          << "    <VOERTUIGGENERATOR><baan>Aankomstbaan</baan><frequentie>4</frequentie><type>auto</type>" << std::endl
+          << "        <aankomsten>poisson</aankomsten></VOERTUIGGENERATOR>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+
+    TrafficSimulation sim;
+    sim.setLogStream(NULL);
+    EXPECT_EQ(Success, sim.parseInputFile("testOutput/arrivalSimulation.xml"));
+    sim.setSeed(7);
+    TrafficSimulation same;
+    same.setLogStream(NULL);
+    same.copySimulation(sim);
+    TrafficSimulation other;
+    other.setLogStream(NULL);
+    other.copySimulation(sim);
+    other.setSeed(8);
+    while (sim.getTime() < 400) {
+        sim.simulate();
+        same.simulate();
+        other.simulate();
+    }
+
+    // About one vehicle every 4 s, the same with the same seed and not with another one
+    unsigned int generated = sim.getStreets()[0]->getGeneratedVehicles();
+    EXPECT_NEAR(100, generated, 30);
+    EXPECT_EQ(generated, same.getStreets()[0]->getGeneratedVehicles());
+    EXPECT_EQ(sim.getStreets()[0]->getVehicleGenerator()->getTimeSinceLastSpawn(),
+              same.getStreets()[0]->getVehicleGenerator()->getTimeSinceLastSpawn());
+    EXPECT_NE(sim.getStreets()[0]->getVehicleGenerator()->getTimeSinceLastSpawn(),
+              other.getStreets()[0]->getVehicleGenerator()->getTimeSinceLastSpawn());
+
+    input.open("testOutput/arrivalSimulation.xml");
+    input << "<?xml version=\"1.0\" ?>" << std::endl
+          << "<SIMULATIE>" << std::endl
+          << "    <BAAN><naam>Aankomstbaan</naam><lengte>500</lengte></BAAN>" << std::endl
+          << "    <VOERTUIGGENERATOR><baan>Aankomstbaan</baan><frequentie>4</frequentie><type>auto</type>" << std::endl
+          << "        <aankomsten>empirisch</aankomsten></VOERTUIGGENERATOR>" << std::endl
+          << "    <VOERTUIGGENERATOR><baan>Aankomstbaan</baan><frequentie>4</frequentie><type>auto</type>" << std::endl
+          << "        <aankomsten>willekeurig</aankomsten></VOERTUIGGENERATOR>" << std::endl
+          << "    <VOERTUIGGENERATOR><baan>Aankomstbaan</baan><frequentie>4</frequentie><type>auto</type>" << std::endl
+          << "        <aankomsten>empirisch</aankomsten><volgtijd van=\"3\" tot=\"1\">5</volgtijd></VOERTUIGGENERATOR>" << std::endl
+          << "</SIMULATIE>" << std::endl;
+    input.close();
+    TrafficSimulation wrong;
+    std::ostringstream errors;
+    EXPECT_EQ(PartialImport, wrong.parseInputFile("testOutput/arrivalSimulation.xml", errors));
+    EXPECT_FALSE(wrong.getStreets()[0]->hasVehicleGenerator());
+}
+
+TEST_F(VehicleGeneratorDomainTest, PoissonKeyedOnStreetIndex) {
+    // The same street under two names, which are interned with different ids
+    const char* names[] = {"Eerste Poissonbaan", "Tweede Poissonbaan"};
+    TrafficSimulation sims[2];
+    for (unsigned int i = 0; i < 2; i++) {
+        std::ofstream input;
+        input.open("testOutput/arrivalSimulation.xml");
+        input << "<?xml version=\"1.0\" ?>" << std::endl
+              << "<SIMULATIE>" << std::endl
+              << "    <BAAN><naam>" << names[i] << "</naam><lengte>10000</lengte></BAAN>" << std::endl
+              << "    <VOERTUIGGENERATOR><baan>" << names[i] << "</baan><frequentie>4</frequentie><type>auto</type>" << std::endl
+              << "        <aankomsten>poisson</aankomsten></VOERTUIGGENERATOR>" << std::endl
+              << "</SIMULATIE>" << std::endl;
+        input.close();
+        sims[i].setLogStream(NULL);
+        ASSERT_EQ(Success, sims[i].parseInputFile("testOutput/arrivalSimulation.xml"));
+        sims[i].setSeed(7);
+    }
+    ASSERT_NE(sims[0].getStreets()[0]->getId(), sims[1].getStreets()[0]->getId());
+    while (sims[0].getTime() < 400) {
+        sims[0].simulate();
+        sims[1].simulate();
+    }
+    EXPECT_EQ(sims[0].getStreets()[0]->getGeneratedVehicles(), sims[1].getStreets()[0]->getGeneratedVehicles());
+    EXPECT_EQ(sims[0].getStreets()[0]->getVehicleGenerator()->getTimeSinceLastSpawn(),
+              sims[1].getStreets()[0]->getVehicleGenerator()->getTimeSinceLastSpawn());
+}
+
 TEST_F(VehicleGeneratorDomainTest, ContractViolations) {
     // Test properlyInitialized condition
     VehicleGenerator illegalCopy = *generator;
@@ -46,4 +156,10 @@ TEST_F(VehicleGeneratorDomainTest, ContractViolations) {
 
     // Test setTimeSinceLastSpawn() conditions
     EXPECT_DEATH(generator->setTimeSinceLastSpawn(-1), "Assertion.*failed");
+
+    EXPECT_DEATH(generator->drawHeadway(1), "Assertion.*failed");
+    EXPECT_DEATH(generator->addHeadwayBin(5, 2, 1), "Assertion.*failed");
+    EXPECT_DEATH(generator->addHeadwayBin(2, 5, 0), "Assertion.*failed");
+    generator->setArrivalProcess(EmpiricalArrivals);
+    EXPECT_DEATH(generator->drawHeadway(0.5), "Assertion.*failed");
 }
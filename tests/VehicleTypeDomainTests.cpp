@@ -0,0 +1,225 @@
+// ===========================================================
+// Name         : VehicleTypeDomainTests.cpp
+// Author       : Laurens De Wachter & Nabil El Ouaamari
+// Version      : 1.0
+// Description  : This code tests the `VehicleTypeRegistry` class of the TrafficSimulation.
+// ===========================================================
+
+#include <fstream>
+#include "gtest/gtest.h"
+#include "../objects/VehicleType.h"
+#include "../objects/Vehicle.h"
+#include "../objects/vehicles/Bus.h"
+#include "../TrafficSimulation.h"
+#include "../objects/Street.h"
+#include "../Utils.h"
+
+class VehicleTypeDomainTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        truck.xmlName = "vrachtwagen";
+        truck.name = "Truck";
+        truck.visualizerName = "truck";
+        truck.acronym = 'V';
+        truck.length = 16.0;
+        truck.maxSpeed = 10.0;
+        truck.maxAcceleration = 1.0;
+        truck.maxBrakeFactor = 4.0;
+        truck.minFollowDistance = 16.0;
+        truck.priority = false;
+        truck.stopsAtBusStops = false;
+        truck.color[0] = 128;
+        truck.color[1] = 128;
+        truck.color[2] = 128;
+    }
+
+    virtual void TearDown() {}
+
+    VehicleTypeRegistry registry;
+    VehicleType truck;
+};
+
+TEST_F(VehicleTypeDomainTest, BuiltInTypes) {
+    EXPECT_TRUE(registry.properlyInitialized());
+    EXPECT_EQ(gVehicleTypeCount, registry.size());
+
+    unsigned int type;
+    EXPECT_TRUE(registry.find("bus", type));
+    EXPECT_EQ((unsigned int) BusVehicle, type);
+    EXPECT_EQ(busLength, registry.get(type).length);
+    EXPECT_TRUE(registry.get(type).stopsAtBusStops);
+    EXPECT_TRUE(registry.get(AmbulanceVehicle).priority);
+    EXPECT_FALSE(registry.find("vrachtwagen", type));
+}
+
+TEST_F(VehicleTypeDomainTest, AddType) {
+    unsigned int type;
+    EXPECT_TRUE(registry.add(truck, type));
+    EXPECT_EQ(gVehicleTypeCount, type);
+    EXPECT_EQ(gVehicleTypeCount + 1, registry.size());
+
+    unsigned int sameType;
+    EXPECT_TRUE(registry.add(truck, sameType));
+    EXPECT_EQ(type, sameType);
+
+    truck.maxSpeed = 12.0;
+    EXPECT_FALSE(registry.add(truck, sameType));
+    EXPECT_EQ(10.0, registry.get(type).maxSpeed);
+}
+
+TEST_F(VehicleTypeDomainTest, Clone) {
+    unsigned int type;
+    ASSERT_TRUE(registry.add(truck, type));
+
+    VehicleTypeRegistry* copy = registry.clone();
+    EXPECT_TRUE(copy->properlyInitialized());
+    EXPECT_EQ(registry.size(), copy->size());
+    unsigned int copiedType;
+    EXPECT_TRUE(copy->find("vrachtwagen", copiedType));
+    EXPECT_EQ(type, copiedType);
+    EXPECT_NE(&registry.get(type), &copy->get(type));
+
+    // The copy has its own types
+    truck.xmlName = "bestelwagen";
+    ASSERT_TRUE(copy->add(truck, copiedType));
+    EXPECT_EQ(registry.size() + 1, copy->size());
+    EXPECT_FALSE(registry.find("bestelwagen", type));
+    delete copy;
+
+    EXPECT_EQ(gVehicleTypeCount, VehicleTypeRegistry::builtInTypes().size());
+}
+
+TEST_F(VehicleTypeDomainTest, VehicleParameters) {
+    unsigned int type;
+    ASSERT_TRUE(registry.add(truck, type));
+
+    Vehicle vehicle("Testbaan", 10, type, registry);
+    EXPECT_EQ(&registry.get(type), &vehicle.getParameters());
+    EXPECT_EQ(type, vehicle.getVehicleType());
+    EXPECT_EQ("Truck", vehicle.getType());
+    EXPECT_EQ('V', vehicle.getAcronym());
+    EXPECT_EQ(16.0, vehicle.getLength());
+    EXPECT_EQ(10.0, vehicle.getMaxSpeed());
+    EXPECT_FALSE(vehicle.hasPriority());
+
+    vehicle.drive(NULL);
+    vehicle.drive(NULL);
+    EXPECT_GT(vehicle.getSpeed(), 0);
+
+    Bus bus("Testbaan", 20);
+    EXPECT_TRUE(bus.stopsAtBusStops());
+    bus.addWaitTime(2);
+    EXPECT_EQ(2, bus.getWaitTime());
+    bus.clearWaitTime();
+    EXPECT_EQ(0, bus.getWaitTime());
+}
+
+TEST_F(VehicleTypeDomainTest, ParseVehicleType) {
+    ASSERT_TRUE(DirectoryExists("testInput"));
+    ASSERT_TRUE(DirectoryExists("testOutput"));
+
+    std::ofstream myFile;
+    myFile.open("testInput/vehicleTypeIn.xml");
+    myFile << "<?xml version=\"1.0\" ?>" << std::endl
+           << "<SIMULATIE>" << std::endl
+           << "<BAAN>" << std::endl
+           << "<naam>Middelheimlaan</naam>" << std::endl
+           << "<lengte>500</lengte>" << std::endl
+           << "</BAAN>" << std::endl
+           << "<VOERTUIG>" << std::endl
+           << "<baan>Middelheimlaan</baan>" << std::endl
+           << "<positie>20</positie>" << std::endl
+           << "<type>tram</type>" << std::endl
+           << "</VOERTUIG>" << std::endl
+           << "<VOERTUIGTYPE>" << std::endl
+           << "<naam>tram</naam>" << std::endl
+           << "<lengte>30</lengte>" << std::endl
+           << "<maxsnelheid>12.5</maxsnelheid>" << std::endl
+           << "<maxversnelling>1.1</maxversnelling>" << std::endl
+           << "<maxremfactor>3.5</maxremfactor>" << std::endl
+           << "<minvolgafstand>10</minvolgafstand>" << std::endl
+           << "<voorrang>ja</voorrang>" << std::endl
+           << "<bushalte>ja</bushalte>" << std::endl
+           << "</VOERTUIGTYPE>" << std::endl
+           << "<VOERTUIGTYPE>" << std::endl
+           << "<naam>fiets</naam>" << std::endl
+           << "<lengte>-2</lengte>" << std::endl
+           << "</VOERTUIGTYPE>" << std::endl
+           << "</SIMULATIE>" << std::endl;
+    myFile.close();
+
+    std::ofstream errStream;
+    errStream.open("testOutput/vehicleTypeErrors.txt");
+    TrafficSimulation sim;
+    EParserSuccess parserSuccess = sim.parseInputFile("testInput/vehicleTypeIn.xml", errStream);
+    errStream.close();
+
+    EXPECT_EQ(PartialImport, parserSuccess);
+    EXPECT_FALSE(FileIsEmpty("testOutput/vehicleTypeErrors.txt"));
+
+    unsigned int type;
+    EXPECT_FALSE(VehicleTypeRegistry::builtInTypes().find("tram", type));
+    EXPECT_TRUE(sim.getVehicleTypes().find("tram", type));
+    EXPECT_FALSE(sim.getVehicleTypes().find("fiets", type));
+
+    ASSERT_EQ(1u, sim.getStreets().size());
+    const std::vector<Vehicle*> &vehicles = sim.getStreets()[0]->getVehicles();
+    ASSERT_EQ(1u, vehicles.size());
+    EXPECT_EQ(type, vehicles[0]->getVehicleType());
+    EXPECT_EQ('T', vehicles[0]->getAcronym());
+    EXPECT_TRUE(vehicles[0]->hasPriority());
+    EXPECT_TRUE(vehicles[0]->stopsAtBusStops());
+
+    // A copy has its own registry, so it outlives the types of the original
+    TrafficSimulation copy;
+    copy.copySimulation(sim);
+    sim.clearSimulation();
+    EXPECT_FALSE(sim.getVehicleTypes().find("tram", type));
+    const std::vector<Vehicle*> &copiedVehicles = copy.getStreets()[0]->getVehicles();
+    ASSERT_EQ(1u, copiedVehicles.size());
+    EXPECT_EQ(&copy.getVehicleTypes().get(type), &copiedVehicles[0]->getParameters());
+    EXPECT_EQ('T', copiedVehicles[0]->getAcronym());
+}
+
+TEST_F(VehicleTypeDomainTest, TypesPerSimulation) {
+    const double lengths[2] = {30, 20};
+    TrafficSimulation sims[2];
+    for (unsigned int i = 0; i < 2; i++) {
+        std::ofstream myFile;
+        myFile.open("testInput/vehicleTypePerSimulation.xml");
+        myFile << "<?xml version=\"1.0\" ?>" << std::endl
+               << "<SIMULATIE>" << std::endl
+               << "<BAAN><naam>Middelheimlaan</naam><lengte>500</lengte></BAAN>" << std::endl
+               << "<VOERTUIG><baan>Middelheimlaan</baan><positie>50</positie><type>tram</type></VOERTUIG>" << std::endl
+               << "<VOERTUIGTYPE><naam>tram</naam><lengte>" << lengths[i] << "</lengte><maxsnelheid>12.5</maxsnelheid>"
+               << "<maxversnelling>1.1</maxversnelling><maxremfactor>3.5</maxremfactor>"
+               << "<minvolgafstand>10</minvolgafstand></VOERTUIGTYPE>" << std::endl
+               << "</SIMULATIE>" << std::endl;
+        myFile.close();
+        sims[i].setLogStream(NULL);
+        ASSERT_EQ(Success, sims[i].parseInputFile("testInput/vehicleTypePerSimulation.xml"));
+    }
+
+    // The same name with other parameters in another file is no conflict
+    for (unsigned int i = 0; i < 2; i++) {
+        unsigned int type;
+        ASSERT_TRUE(sims[i].getVehicleTypes().find("tram", type));
+        EXPECT_EQ(gVehicleTypeCount, type);
+        EXPECT_EQ(lengths[i], sims[i].getStreets()[0]->getVehicles()[0]->getLength());
+    }
+}
+
+TEST_F(VehicleTypeDomainTest, ContractViolations) {
+    VehicleTypeRegistry illegalCopy = registry;
+    unsigned int type;
+
+    EXPECT_DEATH(illegalCopy.find("auto", type), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.size(), "Assertion.*failed");
+    EXPECT_DEATH(illegalCopy.clone(), "Assertion.*failed");
+    EXPECT_DEATH(registry.get(registry.size()), "Assertion.*failed");
+
+    truck.length = 0;
+    EXPECT_DEATH(registry.add(truck, type), "Assertion.*failed");
+    EXPECT_DEATH(Vehicle("Testbaan", 10, VehicleTypeRegistry::builtInTypes().size()), "Assertion.*failed");
+    EXPECT_DEATH(Vehicle("Testbaan", 10, gVehicleTypeCount, registry), "Assertion.*failed");
+}